@@ -0,0 +1,276 @@
+#include "CaptureStream.h"
+#include "xCaptureMain.h"
+#include "../xLights/FSEQFile.h"
+
+#include <wx/file.h>
+#include <wx/time.h>
+
+#include <algorithm>
+#include <cstring>
+
+#include <log4cpp/Category.hh>
+
+// frames held in memory waiting for late universes before they are written
+#define CAPTURE_STREAM_RING_FRAMES 64
+// the file is sized for captures up to this long
+#define CAPTURE_STREAM_MAX_MS (8 * 60 * 60 * 1000)
+// packets of a universe that does not sequence its packets are treated as a new frame if this far apart
+#define CAPTURE_STREAM_MIN_FRAME_MS 10
+#define CAPTURE_STREAM_DEFAULT_FRAME_MS 50
+
+inline long StreamRoundTo4(long i)
+{
+    long remainder = i % 4;
+    if (remainder == 0) {
+        return i;
+    }
+    return i + 4 - remainder;
+}
+
+CaptureStream::CaptureStream(const std::string& filename, int frameMS, bool fillInMissing) :
+    _filename(filename), _fillInMissing(fillInMissing), _frameMS(frameMS)
+{
+    _ring.resize(CAPTURE_STREAM_RING_FRAMES);
+    _present.resize(CAPTURE_STREAM_RING_FRAMES);
+}
+
+CaptureStream::~CaptureStream()
+{
+    if (_fseq != nullptr) {
+        std::string log;
+        Close(log);
+    }
+}
+
+CaptureStream::StreamUniverse* CaptureStream::GetUniverse(long protocol, int universe)
+{
+    for (auto& it : _universes) {
+        if (it._universe == universe && it._protocol == protocol) {
+            return &it;
+        }
+    }
+    return nullptr;
+}
+
+bool CaptureStream::HasUniverse(long protocol, int universe) const
+{
+    for (const auto& it : _universes) {
+        if (it._universe == universe && it._protocol == protocol) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void CaptureStream::AddPacket(long protocol, int universe, int seq, const uint8_t* data, int length)
+{
+    int64_t now = wxGetUTCTimeMillis().GetValue();
+    _packets++;
+    if (_firstMS < 0) _firstMS = now;
+    _lastMS = now;
+
+    if (length <= 0) return;
+    if (length > 512) length = 512;
+
+    int64_t frame = _newestFrame;
+    StreamUniverse* u = GetUniverse(protocol, universe);
+    if (u == nullptr) {
+        if (_layoutFixed) {
+            _ignoredPackets++;
+            return;
+        }
+        StreamUniverse nu;
+        nu._protocol = protocol;
+        nu._universe = universe;
+        nu._slot = _universes.size();
+        _universes.push_back(nu);
+        u = &_universes.back();
+        for (size_t i = 0; i < _ring.size(); i++) {
+            _ring[i].resize(_universes.size() * 512);
+            _present[i].resize(_universes.size(), 0);
+        }
+    }
+    else {
+        int delta = (seq - u->_lastSeq + 256) % 256;
+        if (delta == 0) {
+            // senders that dont sequence their packets repeat the same number so fall back to the packet time
+            int minGap = _frameMS > 0 ? _frameMS / 2 : CAPTURE_STREAM_MIN_FRAME_MS;
+            if (now - u->_lastMS < minGap) {
+                _duplicatePackets++;
+                return;
+            }
+            delta = 1;
+        }
+        else if (delta > 128) {
+            // arrived after a later packet of the same universe
+            _latePackets++;
+            return;
+        }
+        _missingPackets += delta - 1;
+        frame = u->_lastFrame + delta;
+    }
+
+    u->_lastSeq = seq;
+    u->_lastMS = now;
+    if (frame < _baseFrame) {
+        // this universe has fallen behind the frames already written so line it back up with the others
+        _latePackets++;
+        u->_lastFrame = _newestFrame;
+        return;
+    }
+    u->_lastFrame = frame;
+
+    if (_layoutFixed) {
+        length = std::min(length, u->_length);
+    }
+    else {
+        u->_length = std::max(u->_length, length);
+    }
+
+    while (frame >= _baseFrame + (int64_t)_ring.size()) {
+        WriteFrame();
+    }
+    if (frame > _newestFrame) _newestFrame = frame;
+
+    size_t index = frame % _ring.size();
+    memcpy(&_ring[index][u->_slot * 512], data, length);
+    _present[index][u->_slot] = 1;
+}
+
+void CaptureStream::FixLayout()
+{
+    static log4cpp::Category &logger_base = log4cpp::Category::getInstance(std::string("log_base"));
+
+    _layoutFixed = true;
+
+    std::vector<StreamUniverse*> sorted;
+    for (auto& it : _universes) {
+        sorted.push_back(&it);
+    }
+    std::sort(sorted.begin(), sorted.end(), [](const StreamUniverse* a, const StreamUniverse* b) {
+        if (a->_universe == b->_universe) {
+            return a->_protocol == xCaptureFrame::ID_E131SOCKET && b->_protocol != xCaptureFrame::ID_E131SOCKET;
+        }
+        return a->_universe < b->_universe;
+    });
+    long size = 0;
+    for (auto& it : sorted) {
+        it->_startChannel = size;
+        size += it->_length;
+    }
+    _channels = std::max(StreamRoundTo4(size), 4L);
+    _frame.resize(_channels, 0);
+
+    if (_frameMS <= 0) {
+        if (_newestFrame > 0 && _lastMS > _firstMS) {
+            _frameMS = (int)((_lastMS - _firstMS) / _newestFrame / 5) * 5;
+        }
+        if (_frameMS <= 0) _frameMS = CAPTURE_STREAM_DEFAULT_FRAME_MS;
+        logger_base.debug("Capture stream detected frame time %dms.", _frameMS);
+    }
+    _maxFrames = CAPTURE_STREAM_MAX_MS / _frameMS;
+
+    _fseq = FSEQFile::createFSEQFile(_filename, 2, FSEQFile::CompressionType::zstd);
+    if (_fseq == nullptr) {
+        logger_base.error("Capture stream unable to create %s.", (const char*)_filename.c_str());
+        return;
+    }
+    // the frame count is not known until capture stops so the file is laid out for the longest capture
+    // allowed and the real count is written into the header when it is closed
+    _fseq->enableMinorVersionFeatures(1);
+    _fseq->setChannelCount(_channels);
+    _fseq->setStepTime(_frameMS);
+    _fseq->setNumFrames(_maxFrames);
+    _fseq->writeHeader();
+
+    logger_base.debug("Capture stream to %s: %d universes, %ld channels, %dms frames.",
+        (const char*)_filename.c_str(), (int)_universes.size(), _channels, _frameMS);
+}
+
+void CaptureStream::WriteFrame()
+{
+    if (!_layoutFixed) FixLayout();
+
+    size_t index = _baseFrame % _ring.size();
+    for (const auto& it : _universes) {
+        if (_present[index][it._slot]) {
+            memcpy(&_frame[it._startChannel], &_ring[index][it._slot * 512], it._length);
+            _present[index][it._slot] = 0;
+        }
+        else {
+            _filledUniverses++;
+            if (!_fillInMissing) {
+                memset(&_frame[it._startChannel], 0x00, it._length);
+            }
+        }
+    }
+    _baseFrame++;
+
+    if (_fseq == nullptr) return;
+    if ((int)_framesWritten < _maxFrames) {
+        _fseq->addFrame(_framesWritten++, _frame.data());
+    }
+    else {
+        _droppedFrames++;
+    }
+}
+
+bool CaptureStream::Close(std::string& log)
+{
+    static log4cpp::Category &logger_base = log4cpp::Category::getInstance(std::string("log_base"));
+
+    if (!_universes.empty()) {
+        while (_baseFrame <= _newestFrame) {
+            WriteFrame();
+        }
+    }
+
+    bool ok = false;
+    if (_fseq != nullptr) {
+        _fseq->finalize();
+        delete _fseq;
+        _fseq = nullptr;
+
+        // number of frames - 4 bytes at offset 14
+        wxFile f;
+        if (f.Open(_filename, wxFile::read_write)) {
+            uint8_t buf[4];
+            buf[0] = (uint8_t)(_framesWritten & 0xFF);
+            buf[1] = (uint8_t)((_framesWritten >> 8) & 0xFF);
+            buf[2] = (uint8_t)((_framesWritten >> 16) & 0xFF);
+            buf[3] = (uint8_t)((_framesWritten >> 24) & 0xFF);
+            ok = f.Seek(14) == 14 && f.Write(buf, sizeof(buf)) == sizeof(buf);
+            f.Close();
+        }
+        if (!ok) {
+            logger_base.error("Capture stream unable to update the frame count in %s.", (const char*)_filename.c_str());
+        }
+    }
+
+    log = "Streamed to FSEQ file " + _filename + "\n";
+    log += wxString::Format("Frame Time: %dms\n", _frameMS).ToStdString();
+    log += wxString::Format("Universes: %d\n", (int)_universes.size()).ToStdString();
+    log += wxString::Format("Channels Per Frame: %ld\n", _channels).ToStdString();
+    log += wxString::Format("Frames: %u\n", _framesWritten).ToStdString();
+    log += wxString::Format("Packets: %ld, Missing: %ld, Duplicate: %ld, Late: %ld, Unexpected universe: %ld\n",
+        _packets, _missingPackets, _duplicatePackets, _latePackets, _ignoredPackets).ToStdString();
+    log += wxString::Format("Universe frames %s: %ld\n", _fillInMissing ? "filled from prior frame" : "left blank", _filledUniverses).ToStdString();
+    if (_droppedFrames > 0) {
+        log += wxString::Format("Frames beyond maximum capture length dropped: %ld\n", _droppedFrames).ToStdString();
+    }
+    log += "Channel Structure Start:\n";
+    for (const auto& it : _universes) {
+        log += wxString::Format("Channel %ld, Protocol %s, Universe %d, Size %d\n",
+            it._startChannel + 1, it._protocol == xCaptureFrame::ID_E131SOCKET ? "E131" : "ArtNET",
+            it._universe, it._length).ToStdString();
+    }
+    log += "Channel Structure End!\n";
+    logger_base.debug(log);
+
+    return ok;
+}
+
+std::string CaptureStream::GetStatus() const
+{
+    return wxString::Format("Frames written: %u Missing: %ld Late: %ld", _framesWritten, _missingPackets, GetLatePackets()).ToStdString();
+}
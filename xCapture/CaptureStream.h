@@ -0,0 +1,77 @@
+#ifndef CAPTURESTREAM_H
+#define CAPTURESTREAM_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class FSEQFile;
+
+// Assembles captured universes into frames as they arrive and writes them to a compressed V2 FSEQ
+// file so a capture of any length only needs memory for a small ring of frames.
+//
+// Each packet is placed in a frame using the sequence number delta from the last packet of its
+// universe. Frames leave the ring in order once it is full. The channel layout is fixed when the
+// first frame is written using the universes seen so far, sorted by universe number; universes that
+// start sending later are counted but not captured.
+class CaptureStream
+{
+    struct StreamUniverse
+    {
+        long _protocol;
+        int _universe;
+        int _length = 0;
+        int _lastSeq = -1;
+        int64_t _lastMS = 0;
+        int64_t _lastFrame = 0;
+        size_t _slot = 0;
+        long _startChannel = -1; // 0 based, -1 if not in the layout
+    };
+
+    std::string _filename;
+    FSEQFile* _fseq = nullptr;
+    bool _layoutFixed = false;
+    bool _fillInMissing;
+    int _frameMS;
+    int _maxFrames = 0;
+
+    std::vector<StreamUniverse> _universes;
+    std::vector<std::vector<uint8_t>> _ring;
+    std::vector<std::vector<uint8_t>> _present;
+    int64_t _baseFrame = 0;
+    int64_t _newestFrame = 0;
+    int64_t _firstMS = -1;
+    int64_t _lastMS = 0;
+    std::vector<uint8_t> _frame;
+    long _channels = 0;
+    uint32_t _framesWritten = 0;
+
+    long _packets = 0;
+    long _missingPackets = 0;
+    long _duplicatePackets = 0;
+    long _latePackets = 0;
+    long _ignoredPackets = 0;
+    long _filledUniverses = 0;
+    long _droppedFrames = 0;
+
+    StreamUniverse* GetUniverse(long protocol, int universe);
+    void FixLayout();
+    void WriteFrame();
+
+public:
+    // frameMS of 0 means it is detected from the packet timing when the first frame is written
+    CaptureStream(const std::string& filename, int frameMS, bool fillInMissing);
+    virtual ~CaptureStream();
+
+    bool HasUniverse(long protocol, int universe) const;
+    void AddPacket(long protocol, int universe, int seq, const uint8_t* data, int length);
+    bool Close(std::string& log);
+
+    long GetPackets() const { return _packets; }
+    uint32_t GetFramesWritten() const { return _framesWritten; }
+    long GetMissingPackets() const { return _missingPackets; }
+    long GetLatePackets() const { return _latePackets + _duplicatePackets; }
+    std::string GetStatus() const;
+};
+
+#endif
@@ -24,6 +24,7 @@
 #include <wx/filedlg.h>
 #include <wx/numdlg.h>
 #include "ResultDialog.h"
+#include "CaptureStream.h"
 #include "../xLights/IPEntryDialog.h"
 
 #ifndef __WXMSW__
@@ -74,6 +75,7 @@ const long xCaptureFrame::ID_STATICTEXT9 = wxNewId();
 const long xCaptureFrame::ID_CHOICE1 = wxNewId();
 const long xCaptureFrame::ID_SPINCTRL1 = wxNewId();
 const long xCaptureFrame::ID_CHECKBOX1 = wxNewId();
+const long xCaptureFrame::ID_CHECKBOX2 = wxNewId();
 const long xCaptureFrame::ID_BUTTON1 = wxNewId();
 const long xCaptureFrame::ID_BUTTON8 = wxNewId();
 const long xCaptureFrame::ID_BUTTON2 = wxNewId();
@@ -140,6 +142,21 @@ void xCaptureFrame::StashPacket(long type, wxByte* packet, int len)
 
     if (!_capturing) return;
 
+    if (_stream != nullptr)
+    {
+        // frames are assembled and written to disk as they arrive rather than keeping the packets
+        if (!_stream->HasUniverse(type, universe) && !IsUniverseToBeCaptured(universe)) return;
+
+        int seq = 0;
+        int length = 0;
+        const wxByte* data = PacketData::Parse(type, packet, len, seq, length);
+        if (data == nullptr) return;
+
+        _capturedPackets++;
+        _stream->AddPacket(type, universe, seq, data, length);
+        return;
+    }
+
     for (const auto& it : _capturedData)
     {
         if (it->_protocol == type && it->_universe == universe)
@@ -217,6 +234,7 @@ xCaptureFrame::xCaptureFrame(wxWindow* parent, const std::string& showdir, const
 
     _e131Socket = nullptr;
     _artNETSocket = nullptr;
+    _stream = nullptr;
     _capturing = false;
     _capturedPackets = 0;
     _capturedDesc = "";
@@ -322,6 +340,9 @@ xCaptureFrame::xCaptureFrame(wxWindow* parent, const std::string& showdir, const
     CheckBox_FillInMissingFrames = new wxCheckBox(this, ID_CHECKBOX1, _("Fill in missing frames with prior frame data"), wxDefaultPosition, wxDefaultSize, 0, wxDefaultValidator, _T("ID_CHECKBOX1"));
     CheckBox_FillInMissingFrames->SetValue(false);
     FlexGridSizer8->Add(CheckBox_FillInMissingFrames, 1, wxALL|wxEXPAND, 5);
+    CheckBox_StreamToFile = new wxCheckBox(this, ID_CHECKBOX2, _("Stream to FSEQ file while capturing"), wxDefaultPosition, wxDefaultSize, 0, wxDefaultValidator, _T("ID_CHECKBOX2"));
+    CheckBox_StreamToFile->SetValue(false);
+    FlexGridSizer8->Add(CheckBox_StreamToFile, 1, wxALL|wxEXPAND, 5);
     FlexGridSizer1->Add(FlexGridSizer8, 1, wxALL|wxEXPAND, 5);
     FlexGridSizer2 = new wxFlexGridSizer(0, 4, 0, 0);
     Button_StartStop = new wxButton(this, ID_BUTTON1, _("Start Capture"), wxDefaultPosition, wxDefaultSize, 0, wxDefaultValidator, _T("ID_BUTTON1"));
@@ -499,6 +520,12 @@ xCaptureFrame::~xCaptureFrame()
 
     CloseSockets(true);
 
+    if (_stream != nullptr)
+    {
+        delete _stream;
+        _stream = nullptr;
+    }
+
     PurgeCollectedData();
 
     //(*Destroy(xCaptureFrame)
@@ -597,63 +624,79 @@ void xCaptureFrame::OnAbout(wxCommandEvent& event)
 
 PacketData::PacketData(long type, wxByte* packet, int len)
 {
-    static log4cpp::Category &logger_base = log4cpp::Category::getInstance(std::string("log_base"));
     _timeStamp = wxDateTime::UNow();
     _frameTimeMS = -1;
     _seq = 0;
     _length = 0;
     _pdata = nullptr;
 
+    const wxByte* data = Parse(type, packet, len, _seq, _length);
+    if (data != nullptr)
+    {
+        _pdata = (wxByte*)malloc(_length);
+        memcpy(_pdata, data, _length);
+    }
+    else
+    {
+        _seq = 0;
+        _length = 0;
+    }
+}
+
+// validates the packet and returns a pointer to its channel data within the packet
+const wxByte* PacketData::Parse(long type, const wxByte* packet, int len, int& seq, int& length)
+{
+    static log4cpp::Category &logger_base = log4cpp::Category::getInstance(std::string("log_base"));
+
     if (type == xCaptureFrame::ID_E131SOCKET)
     {
         // validate the packet
-        if (len < 126) return;
-        if (packet[4] != 0x41) return;
-        if (packet[5] != 0x53) return;
-        if (packet[6] != 0x43) return;
-        if (packet[7] != 0x2d) return;
-        if (packet[8] != 0x45) return;
-        if (packet[9] != 0x31) return;
-        if (packet[10] != 0x2e) return;
-        if (packet[11] != 0x31) return;
-        if (packet[12] != 0x37) return;
-        if (packet[125] != 0x00) return; // not lighting data
-
-        _seq = (int)packet[111];
-        _length = (((int)packet[115] - 0x70) << 8) + (int)packet[116] - 11;
-        if (_length > len - 126)
+        if (len < 126) return nullptr;
+        if (packet[4] != 0x41) return nullptr;
+        if (packet[5] != 0x53) return nullptr;
+        if (packet[6] != 0x43) return nullptr;
+        if (packet[7] != 0x2d) return nullptr;
+        if (packet[8] != 0x45) return nullptr;
+        if (packet[9] != 0x31) return nullptr;
+        if (packet[10] != 0x2e) return nullptr;
+        if (packet[11] != 0x31) return nullptr;
+        if (packet[12] != 0x37) return nullptr;
+        if (packet[125] != 0x00) return nullptr; // not lighting data
+
+        seq = (int)packet[111];
+        length = (((int)packet[115] - 0x70) << 8) + (int)packet[116] - 11;
+        if (length > len - 126)
         {
-            logger_base.warn("E131 packet of claimed length %d truncated to actual packet length %d.", _length, len - 126);
+            logger_base.warn("E131 packet of claimed length %d truncated to actual packet length %d.", length, len - 126);
             logger_base.warn("    Packet looks unlikely to be valid.");
-            _length = len - 126;
+            length = len - 126;
         }
-        _pdata = (wxByte*)malloc(_length);
-        memcpy(_pdata, &packet[126], _length);
+        return &packet[126];
     }
     else if (type == xCaptureFrame::ID_ARTNETSOCKET)
     {
         // validate the packet
-        if (len < 18) return;
-        if (packet[0] != 'A') return;
-        if (packet[1] != 'r') return;
-        if (packet[2] != 't') return;
-        if (packet[3] != '-') return;
-        if (packet[4] != 'N') return;
-        if (packet[5] != 'e') return;
-        if (packet[6] != 't') return;
-        if (packet[9] != 0x50) return;
-
-        _seq = (int)packet[12];
-        _length = ((int)packet[16] << 8) + (int)packet[17];
-        if (_length > len - 18)
+        if (len < 18) return nullptr;
+        if (packet[0] != 'A') return nullptr;
+        if (packet[1] != 'r') return nullptr;
+        if (packet[2] != 't') return nullptr;
+        if (packet[3] != '-') return nullptr;
+        if (packet[4] != 'N') return nullptr;
+        if (packet[5] != 'e') return nullptr;
+        if (packet[6] != 't') return nullptr;
+        if (packet[9] != 0x50) return nullptr;
+
+        seq = (int)packet[12];
+        length = ((int)packet[16] << 8) + (int)packet[17];
+        if (length > len - 18)
         {
-            logger_base.warn("ArtNet packet of claimed length %d truncated to actual packet length %d.", _length, len - 18);
+            logger_base.warn("ArtNet packet of claimed length %d truncated to actual packet length %d.", length, len - 18);
             logger_base.warn("    Packet looks unlikely to be valid.");
-            _length = len - 18;
+            length = len - 18;
         }
-        _pdata = (wxByte*)malloc(_length);
-        memcpy(_pdata, &packet[18], _length);
+        return &packet[18];
     }
+    return nullptr;
 }
 
 // Duplicate a packet but update its sequence number and time
@@ -828,6 +871,7 @@ void xCaptureFrame::ValidateWindow()
         SpinCtrl_TriggerStart->Enable(true);
         SpinCtrl_TriggerStop->Enable(true);
         Button_StartStop->Enable(false);
+        CheckBox_StreamToFile->Enable(false);
     }
     else
     {
@@ -836,6 +880,7 @@ void xCaptureFrame::ValidateWindow()
         SpinCtrl_TriggerStart->Enable(false);
         SpinCtrl_TriggerStop->Enable(false);
         Button_StartStop->Enable(true);
+        CheckBox_StreamToFile->Enable(!_capturing);
     }
 
     if (_artNETSocket == nullptr && _e131Socket == nullptr)
@@ -1080,12 +1125,52 @@ void xCaptureFrame::OnButton_StartStopClick(wxCommandEvent& event)
     _capturing = !_capturing;
     if (_capturing)
     {
+        if (CheckBox_StreamToFile->GetValue())
+        {
+            wxFileDialog dlg(this, _("Stream to sequence"), "", "",
+                "FSEQ (*.fseq)|*.fseq", wxFD_SAVE | wxFD_OVERWRITE_PROMPT);
+            if (dlg.ShowModal() != wxID_OK)
+            {
+                _capturing = false;
+                ValidateWindow();
+                return;
+            }
+
+            int frameMS = 0;
+            if (Choice_Timing->GetStringSelection() == "Manual")
+            {
+                frameMS = SpinCtrl_ManualTime->GetValue();
+            }
+            else if (Choice_Timing->GetStringSelection() != "xCapture Detected (rounded to nearest 5ms)")
+            {
+                frameMS = wxAtoi(Choice_Timing->GetStringSelection());
+            }
+            wxFileName fn(dlg.GetDirectory() + "/" + dlg.GetFilename());
+            _stream = new CaptureStream(fn.GetFullPath().ToStdString(), frameMS, CheckBox_FillInMissingFrames->GetValue());
+            logger_base.debug("Streaming capture to %s.", (const char*)fn.GetFullPath().c_str());
+        }
+
         _capturedDesc = "";
         _capturedPackets = 0;
         PurgeCollectedData();
         Button_StartStop->SetLabel("Stop");
         _capturedDesc = "";
     }
+    else if (_stream != nullptr)
+    {
+        Button_StartStop->SetLabel("Start");
+        UpdateCaptureDesc();
+
+        logger_base.debug("Streaming capture stopped.");
+
+        std::string log;
+        _stream->Close(log);
+        delete _stream;
+        _stream = nullptr;
+
+        ResultDialog dlgLog(this, log);
+        dlgLog.ShowModal();
+    }
     else
     {
         Button_StartStop->SetLabel("Start");
@@ -1374,6 +1459,11 @@ void xCaptureFrame::OnButton_DeleteClick(wxCommandEvent& event)
 
 void xCaptureFrame::OnUITimerTrigger(wxTimerEvent& event)
 {
+    if (_stream != nullptr)
+    {
+        StatusBar1->SetStatusText(wxString::Format("Total Packets: %ld %s", _capturedPackets, _stream->GetStatus()));
+        return;
+    }
     StatusBar1->SetStatusText(wxString::Format("Universes: %d Total Packets: %ld %s", (int)_capturedData.size(), _capturedPackets, _capturedDesc));
 }
 
@@ -43,6 +43,7 @@
 #include <wx/socket.h>
 
 class wxDebugReportCompress;
+class CaptureStream;
 class wxDatagramSocket;
 
 class PacketData
@@ -56,6 +57,7 @@ public:
     virtual ~PacketData() { if (_pdata != nullptr) free(_pdata); }
     PacketData(long type, wxByte* packet, int len);
     PacketData(PacketData& pd, int seq, int time);
+    static const wxByte* Parse(long type, const wxByte* packet, int len, int& seq, int& length);
 };
 
 class Collector
@@ -81,6 +83,7 @@ class xCaptureFrame : public xlFrame
     void ValidateWindow();
 
     std::list<Collector*> _capturedData;
+    CaptureStream* _stream;
     wxDatagramSocket* _e131Socket;
     wxDatagramSocket* _artNETSocket;
     bool _capturing;
@@ -171,6 +174,7 @@ private:
         static const long ID_CHOICE1;
         static const long ID_SPINCTRL1;
         static const long ID_CHECKBOX1;
+        static const long ID_CHECKBOX2;
         static const long ID_BUTTON1;
         static const long ID_BUTTON8;
         static const long ID_BUTTON2;
@@ -192,6 +196,7 @@ private:
         wxCheckBox* CheckBox_ArtNET;
         wxCheckBox* CheckBox_E131;
         wxCheckBox* CheckBox_FillInMissingFrames;
+        wxCheckBox* CheckBox_StreamToFile;
         wxCheckBox* CheckBox_TriggerOnChannel;
         wxChoice* Choice_Timing;
         wxListView* ListView_Universes;
@@ -4,6 +4,8 @@
 #include <wx/thread.h>
 #include <wx/socket.h>
 
+#include <memory>
+
 #include "xFadeMain.h"
 #include "Settings.h"
 #include "PacketData.h"
@@ -93,19 +95,17 @@ public:
 
         artNETSocketReceive->Notify(false);
         artNETSocketReceive->SetTimeout(1);
+        PacketBatch::PrepareSocket(artNETSocketReceive);
 
-        uint8_t buffer[ARTNET_PACKET_HEADERLEN + 512];
+        // allocated once up front rather than per read
+        std::unique_ptr<PacketBatch> batch(new PacketBatch());
 
         while (!_stop)
         {
-            memset(buffer, 0x00, sizeof(buffer));
-
-            artNETSocketReceive->Read(buffer, sizeof(buffer));
-            if (!_stop)
+            int count = batch->Receive(artNETSocketReceive);
+            for (int i = 0; i < count && !_stop; i++)
             {
-                //logger_base.debug(" Read done. %ldms", sw.Time());
-                int read = artNETSocketReceive->GetLastIOReadSize();
-                _receiver->StashPacket(buffer, read);
+                _receiver->StashPacket(batch->GetPacket(i), batch->GetSize(i));
             }
         }
 
@@ -4,6 +4,8 @@
 #include <wx/thread.h>
 #include <wx/socket.h>
 
+#include <memory>
+
 #include "xFadeMain.h"
 #include "Settings.h"
 #include "PacketData.h"
@@ -113,19 +115,17 @@ public:
 
         e131SocketReceive->Notify(false);
         e131SocketReceive->SetTimeout(1);
+        PacketBatch::PrepareSocket(e131SocketReceive);
 
-        uint8_t buffer[E131_PACKET_HEADERLEN + 512];
+        // allocated once up front rather than per read
+        std::unique_ptr<PacketBatch> batch(new PacketBatch());
 
         while (!_stop)
         {
-            memset(buffer, 0x00, sizeof(buffer));
-
-            e131SocketReceive->Read(buffer, sizeof(buffer));
-            if (!_stop)
+            int count = batch->Receive(e131SocketReceive);
+            for (int i = 0; i < count && !_stop; i++)
             {
-                //logger_base.debug(" Read done. %ldms", sw.Time());
-                int read = e131SocketReceive->GetLastIOReadSize();
-                if (read > 0) _receiver->StashPacket(buffer, read);
+                _receiver->StashPacket(batch->GetPacket(i), batch->GetSize(i));
             }
         }
 
@@ -148,8 +148,17 @@ std::string E131Receiver::ExtractE131Tag(uint8_t* packet)
     return res;
 }
 
+// compares the source name in place so packets from known sources dont allocate a string
+static bool TagMatches(uint8_t* packet, const std::string& tag)
+{
+    return tag != "" && strncmp((const char*)&packet[44], tag.c_str(), 64) == 0;
+}
+
 bool E131Receiver::IsLeft(uint8_t* packet)
 {
+    if (TagMatches(packet, UniverseData::__leftTag)) return true;
+    if (TagMatches(packet, UniverseData::__rightTag)) return false;
+
     std::string tag = ExtractE131Tag(packet);
     if (tag == UniverseData::__leftTag) return true;
     if (tag == UniverseData::__rightTag) return false;
@@ -168,6 +177,9 @@ bool E131Receiver::IsLeft(uint8_t* packet)
 
 bool E131Receiver::IsRight(uint8_t* packet)
 {
+    if (TagMatches(packet, UniverseData::__rightTag)) return true;
+    if (TagMatches(packet, UniverseData::__leftTag)) return false;
+
     std::string tag = ExtractE131Tag(packet);
     if (tag == UniverseData::__rightTag) return true;
     if (tag == UniverseData::__leftTag) return false;
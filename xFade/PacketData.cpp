@@ -2,6 +2,19 @@
 
 #include <wx/socket.h>
 
+#ifdef __linux__
+#include <sys/socket.h>
+#include <sys/uio.h>
+#elif defined(__WXMSW__)
+#include <winsock2.h>
+#else
+#include <sys/socket.h>
+#endif
+
+#include <log4cpp/Category.hh>
+
+#define RECEIVE_BUFFER_SIZE (4 * 1024 * 1024)
+
 PacketData::PacketData()
 {
     memset(_data, 0x00, sizeof(_data));
@@ -78,7 +91,7 @@ bool PacketData::Update(long type, uint8_t packet[], int len)
         if (packet[11] != 0x31) return false;
         if (packet[12] != 0x37) return false;
 
-        _universe = ((int)_data[113] << 8) + (int)_data[114];
+        _universe = ((int)packet[113] << 8) + (int)packet[114];
         _type = type;
         _length = len;
         wxASSERT(_length >= E131_PACKET_HEADERLEN && _length <= E131_PACKET_HEADERLEN + 512);
@@ -97,7 +110,7 @@ bool PacketData::Update(long type, uint8_t packet[], int len)
         if (packet[6] != 't') return false;
         if (packet[9] != 0x50) return true; // pretend success as otherwise I will log excessively
 
-        _universe = ((int)_data[15] << 8) + (int)_data[14];
+        _universe = ((int)packet[15] << 8) + (int)packet[14];
         _type = type;
         _length = len;
         wxASSERT(_length >= ARTNET_PACKET_HEADERLEN && _length <= ARTNET_PACKET_HEADERLEN + 512);
@@ -289,20 +302,22 @@ void PacketData::InitialiseLength(long type, int length, int universe)
     }
 }
 
-void PacketData::ApplyBrightness(int brightness, const std::list<int>& excludeChannels)
+void PacketData::ApplyBrightness(int brightness, const uint8_t* excludeMask)
 {
     if (brightness == 100) return;
 
-    if (excludeChannels.size() == 0)
+    uint8_t* p = GetDataPtr();
+    int channels = GetDataLength();
+
+    if (excludeMask == nullptr)
     {
         if (brightness == 0)
         {
-            memset(GetDataPtr(), 0x00, GetDataLength());
+            memset(p, 0x00, channels);
         }
         else
         {
-            uint8_t* p = GetDataPtr();
-            for (int i = 0; i < GetDataLength(); i++)
+            for (int i = 0; i < channels; i++)
             {
                 *(p + i) = (uint8_t)((int)*(p + i) * brightness / 100);
             }
@@ -310,13 +325,11 @@ void PacketData::ApplyBrightness(int brightness, const std::list<int>& excludeCh
     }
     else
     {
-        uint8_t* p = GetDataPtr();
-        for (int i = 0; i < GetDataLength(); i++)
+        // excluded channels are flagged in the mask so there is no search per channel
+        for (int i = 0; i < channels; i++)
         {
-            if (std::find(excludeChannels.begin(), excludeChannels.end(), i + 1) == excludeChannels.end())
-            {
-                *(p + i) = (uint8_t)((int)*(p + i) * brightness / 100);
-            }
+            uint8_t dimmed = (uint8_t)((int)*(p + i) * brightness / 100);
+            *(p + i) = excludeMask[i] ? *(p + i) : dimmed;
         }
     }
 }
@@ -355,7 +368,7 @@ void PacketData::CopyFrom(PacketData* source, long targetType)
             // converting from ARTNET
             _length = E131_PACKET_HEADERLEN + source->GetDataLength();
             InitialiseE131Header();
-            memcpy(source->GetDataPtr(), GetDataPtr(), GetDataLength());
+            memcpy(GetDataPtr(), source->GetDataPtr(), GetDataLength());
             memset(&_data[44], 0x00, 64);
             strncpy((char*)&_data[44], _tag.c_str(), 64);
             _data[111] = GetNextSequenceNum(_universe);
@@ -365,8 +378,50 @@ void PacketData::CopyFrom(PacketData* source, long targetType)
             // converting from E131
             _length = ARTNET_PACKET_HEADERLEN + source->GetDataLength();
             InitialiseArtNETHeader();
-            memcpy(source->GetDataPtr(), GetDataPtr(), GetDataLength());
+            memcpy(GetDataPtr(), source->GetDataPtr(), GetDataLength());
             _data[12] = GetNextSequenceNum(_universe);
         }
     }
-}
\ No newline at end of file
+}
+
+void PacketBatch::PrepareSocket(wxDatagramSocket* socket)
+{
+    static log4cpp::Category& logger_base = log4cpp::Category::getInstance(std::string("log_base"));
+
+    int size = RECEIVE_BUFFER_SIZE;
+    if (!socket->SetOption(SOL_SOCKET, SO_RCVBUF, (const char*)&size, sizeof(size)))
+    {
+        logger_base.warn("Unable to set socket receive buffer size to %d.", size);
+    }
+}
+
+int PacketBatch::Receive(wxDatagramSocket* socket)
+{
+#ifdef __linux__
+    if (!socket->WaitForRead()) return 0;
+
+    struct mmsghdr msgs[PACKET_BATCH_SIZE];
+    struct iovec iovs[PACKET_BATCH_SIZE];
+    memset(msgs, 0x00, sizeof(msgs));
+    for (int i = 0; i < PACKET_BATCH_SIZE; i++)
+    {
+        iovs[i].iov_base = _buffers[i];
+        iovs[i].iov_len = sizeof(_buffers[i]);
+        msgs[i].msg_hdr.msg_iov = &iovs[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    int count = recvmmsg(socket->GetSocket(), msgs, PACKET_BATCH_SIZE, MSG_DONTWAIT, nullptr);
+    if (count <= 0) return 0;
+
+    for (int i = 0; i < count; i++)
+    {
+        _sizes[i] = msgs[i].msg_len;
+    }
+    return count;
+#else
+    socket->Read(_buffers[0], sizeof(_buffers[0]));
+    _sizes[0] = socket->GetLastIOReadSize();
+    return _sizes[0] > 0 ? 1 : 0;
+#endif
+}
@@ -13,6 +13,8 @@
 #define E131_PACKET_HEADERLEN 126
 #define E131_PACKET_LEN (E131_PACKET_HEADERLEN + 512)
 
+#define PACKET_BATCH_SIZE 32
+
 class wxDatagramSocket;
 
 class PacketData
@@ -41,7 +43,25 @@ public:
     void InitialiseE131Header();
     int GetSequenceNum() const;
     void InitialiseLength(long type, int length, int universe);
-    void ApplyBrightness(int brightness, const std::list<int>& excludeChannels);
+    void ApplyBrightness(int brightness, const uint8_t* excludeMask);
+};
+
+// Receives all the packets waiting on a socket in one call where the platform supports it (recvmmsg on linux)
+// rather than a read per packet. Other platforms read one packet at a time.
+class PacketBatch
+{
+    uint8_t _buffers[PACKET_BATCH_SIZE][E131_PACKET_LEN];
+    int _sizes[PACKET_BATCH_SIZE];
+
+public:
+
+    // enlarge the socket receive buffer so bursts of universes are not dropped between reads
+    static void PrepareSocket(wxDatagramSocket* socket);
+
+    // waits up to the socket timeout and returns the number of packets read
+    int Receive(wxDatagramSocket* socket);
+    uint8_t* GetPacket(int i) { return _buffers[i]; }
+    int GetSize(int i) const { return _sizes[i]; }
 };
 
 #endif 
@@ -3,11 +3,43 @@
 std::string UniverseData::__leftTag = "";
 std::string UniverseData::__rightTag = "";
 
-UniverseData::UniverseData(int universe, const std::string& targetIP, const std::string& targetProtocol, std::list<int> excludedChannels) :
+bool PacketExchange::Update(int type, uint8_t* buffer, int size)
+{
+    PacketData& pd = _buffers[_writing];
+
+    // packets which are accepted but not copied (eg artNET polls) leave the length at zero and are not passed on
+    pd._length = 0;
+    if (!pd.Update(type, buffer, size)) return false;
+    if (pd._length == 0) return true;
+
+    _sequenceNum = pd.GetSequenceNum();
+    _writing = _shared.exchange(_writing | NEW_DATA) & ~NEW_DATA;
+    return true;
+}
+
+PacketData& PacketExchange::GetLatest()
+{
+    if (_shared.load() & NEW_DATA)
+    {
+        _reading = _shared.exchange(_reading) & ~NEW_DATA;
+    }
+    return _buffers[_reading];
+}
+
+UniverseData::UniverseData(int universe, const std::string& targetIP, const std::string& targetProtocol, const std::list<int>& excludedChannels) :
     _universe(universe),
-    _targetIP(targetIP),
-    _excludedChannels(excludedChannels)
+    _targetIP(targetIP)
 {
+    memset(_excludedMask, 0x00, sizeof(_excludedMask));
+    for (const auto& it : excludedChannels)
+    {
+        if (it >= 1 && it <= (int)sizeof(_excludedMask))
+        {
+            _excludedMask[it - 1] = 1;
+            _hasExcludedChannels = true;
+        }
+    }
+
     if (targetProtocol == "As per input")
     {
         _targetProtocol = 0;
@@ -26,88 +58,59 @@ UniverseData::UniverseData(int universe, const std::string& targetIP, const std:
     }
 }
 
-int UniverseData::GetLeftSequenceNum()
-{
-    std::unique_lock<std::mutex> lock(_lock);
-    return _left.GetSequenceNum();
-}
-
-int UniverseData::GetRightSequenceNum()
-{
-    std::unique_lock<std::mutex> lock(_lock);
-    return _right.GetSequenceNum();
-}
-
-bool UniverseData::UpdateLeft(int type, uint8_t* buffer, int size)
-{
-    std::unique_lock<std::mutex> lock(_lock);
-    return _left.Update(type, buffer, size);
-}
-
-bool UniverseData::UpdateRight(int type, uint8_t* buffer, int size)
-{
-    std::unique_lock<std::mutex> lock(_lock);
-    return _right.Update(type, buffer, size);
-}
-
 PacketData* UniverseData::GetOutput(PacketData* output, int leftBrightness, int rightBrightness, float pos)
 {
-    std::unique_lock<std::mutex> lock(_lock);
+    PacketData& left = _left.GetLatest();
+    PacketData& right = _right.GetLatest();
 
-    if (_left._length == 0 && _right._length > 0)
+    if (left._length == 0 && right._length > 0)
     {
-        _left.InitialiseLength(_right._type, _right._length, _universe);
+        left.InitialiseLength(right._type, right._length, _universe);
     }
-    else if (_right._length == 0 && _left._length > 0)
+    else if (right._length == 0 && left._length > 0)
     {
-        _right.InitialiseLength(_left._type, _left._length, _universe);
+        right.InitialiseLength(left._type, left._length, _universe);
     }
 
     if (pos == 0.0)
     {
-        PrepareData(output, &_left, _targetProtocol);
-        output->ApplyBrightness(leftBrightness, _excludedChannels);
+        PrepareData(output, &left, _targetProtocol);
+        output->ApplyBrightness(leftBrightness, GetExcludedMask());
     }
     else if (pos == 1.0)
     {
-        PrepareData(output, &_right, _targetProtocol);
-        output->ApplyBrightness(rightBrightness, _excludedChannels);
+        PrepareData(output, &right, _targetProtocol);
+        output->ApplyBrightness(rightBrightness, GetExcludedMask());
     }
     else
     {
-        int sz = std::min(_left.GetDataLength(), _right.GetDataLength());
+        int sz = std::min(left.GetDataLength(), right.GetDataLength());
 
-        PacketData l = _left;
-        PacketData r = _right;
-        l.ApplyBrightness(leftBrightness, _excludedChannels);
-        r.ApplyBrightness(rightBrightness, _excludedChannels);
-
-        Blend(l.GetDataPtr(), r.GetDataPtr(), sz, pos, _excludedChannels);
-        PrepareData(output, &l, _targetProtocol);
+        // blend straight into the output rather than into copies of both sides
+        PrepareData(output, &left, _targetProtocol);
+        output->ApplyBrightness(leftBrightness, GetExcludedMask());
+        if (sz > 0)
+        {
+            Blend(output->GetDataPtr(), right.GetDataPtr(), sz, rightBrightness, pos);
+        }
     }
     return output;
 }
 
-void UniverseData::Blend(uint8_t* buffer, uint8_t* blendBuffer, size_t channels, float pos, std::list<int> excludeChannels)
+void UniverseData::Blend(uint8_t* buffer, const uint8_t* blendBuffer, size_t channels, int blendBrightness, float pos) const
 {
-    float inv = 1.0 - pos;
+    // 16 bit fixed point weights and the excluded channel mask keep this loop free of branches so the compiler
+    // can vectorise it
+    uint32_t w = (uint32_t)(pos * 65536.0f);
+    uint32_t inv = 65536 - w;
+    bool takeBlend = pos >= 0.5;
     for (size_t i = 0; i < channels; ++i)
     {
-        if (std::find(excludeChannels.begin(), excludeChannels.end(), i + 1) != excludeChannels.end())
-        {
-            if (pos < 0.5)
-            {
-                // dont change anything
-            }
-            else
-            {
-                *(buffer + i) = *(blendBuffer + i);
-            }
-        }
-        else
-        {
-            *(buffer + i) = (uint8_t)((float) * (buffer + i) * inv + (float) * (blendBuffer + i) * pos);
-        }
+        uint32_t b = (uint32_t)blendBuffer[i];
+        uint32_t dimmed = _excludedMask[i] ? b : b * blendBrightness / 100;
+        uint8_t mixed = (uint8_t)(((uint32_t)buffer[i] * inv + dimmed * w) >> 16);
+        uint8_t excluded = takeBlend ? blendBuffer[i] : buffer[i];
+        buffer[i] = _excludedMask[i] ? excluded : mixed;
     }
 }
 
@@ -123,4 +126,4 @@ void UniverseData::PrepareData(PacketData* target, PacketData* source, int proto
         // conversion required
         target->CopyFrom(source, protocol);
     }
-}
\ No newline at end of file
+}
@@ -1,21 +1,48 @@
 #pragma once
 
-#include <mutex>
+#include <atomic>
+#include <list>
 
 #include "PacketData.h"
 
+// Latest packet received for one side of a universe, passed from the receiving thread to the emitter thread
+// without locking. Of the three buffers the receiver owns one, the emitter owns one and the third is swapped
+// with either of them so neither thread ever sees a buffer while the other is writing it.
+class PacketExchange
+{
+    static const int NEW_DATA = 4;
+
+    PacketData _buffers[3];
+    int _writing = 0;
+    int _reading = 1;
+    std::atomic<int> _shared;
+    std::atomic<int> _sequenceNum;
+
+public:
+
+    PacketExchange() : _shared(2), _sequenceNum(-1) {}
+
+    // receiving thread only
+    bool Update(int type, uint8_t* buffer, int size);
+    int GetSequenceNum() const { return _sequenceNum; }
+
+    // emitter thread only
+    PacketData& GetLatest();
+};
+
 class UniverseData
 {
     int _universe = 0;
     int _targetProtocol = 0;
-    std::mutex _lock;
-    PacketData _left;
-    PacketData _right;
+    PacketExchange _left;
+    PacketExchange _right;
     std::string _targetIP;
-    std::list<int> _excludedChannels;
+    bool _hasExcludedChannels = false;
+    uint8_t _excludedMask[512];
 
     void PrepareData(PacketData* target, PacketData* source, int protocol);
-    void Blend(uint8_t* buffer, uint8_t* blendBuffer, size_t channels, float pos, std::list<int> excludeChannels);
+    void Blend(uint8_t* buffer, const uint8_t* blendBuffer, size_t channels, int blendBrightness, float pos) const;
+    const uint8_t* GetExcludedMask() const { return _hasExcludedChannels ? _excludedMask : nullptr; }
 
 public:
 
@@ -26,14 +53,13 @@ public:
     static void SetLeftTag(const std::string& left) { __leftTag = left; }
     static void SetRightTag(const std::string& right) { __rightTag = right; }
     int GetUniverse() const { return _universe; }
-    std::mutex& GetLock() { return _lock; }
     std::string GetTargetIP() const { return _targetIP; }
-    bool UpdateLeft(int type, uint8_t* buffer, int size);
-    bool UpdateRight(int type, uint8_t* buffer, int size);
-    int GetLeftSequenceNum();
-    int GetRightSequenceNum();
+    bool UpdateLeft(int type, uint8_t* buffer, int size) { return _left.Update(type, buffer, size); }
+    bool UpdateRight(int type, uint8_t* buffer, int size) { return _right.Update(type, buffer, size); }
+    int GetLeftSequenceNum() const { return _left.GetSequenceNum(); }
+    int GetRightSequenceNum() const { return _right.GetSequenceNum(); }
     int GetOutputFormat() const { return _targetProtocol; }
-    UniverseData(int universe, const std::string& targetIP, const std::string& targetProtocol, std::list<int> excludedChannels);
+    UniverseData(int universe, const std::string& targetIP, const std::string& targetProtocol, const std::list<int>& excludedChannels);
     virtual ~UniverseData() {}
     PacketData* GetOutput(PacketData* output, int leftBrightness, int rightBrightness, float pos);
 };
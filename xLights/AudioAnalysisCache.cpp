@@ -0,0 +1,498 @@
+/***************************************************************
+ * This source files comes from the xLights project
+ * https://www.xlights.org
+ * https://github.com/smeighan/xLights
+ * See the github commit history for a record of contributing
+ * developers.
+ * Copyright claimed based on commit dates recorded in Github
+ * License: https://github.com/smeighan/xLights/blob/master/License.txt
+ **************************************************************/
+
+#include "AudioAnalysisCache.h"
+
+#include <wx/wx.h>
+#include <wx/dir.h>
+#include <wx/file.h>
+#include <wx/filename.h>
+
+#include <algorithm>
+#include <cstring>
+
+#include "../xSchedule/md5.h"
+#include "ExternalHooks.h"
+
+#include <log4cpp/Category.hh>
+
+#ifndef __WXMSW__
+#include <sys/mman.h>
+#define USE_MMAP_AUDIOCACHE
+#endif
+
+#define AUDIOCACHE_VERSION 1
+#define AUDIOCACHE_HEADER_SIZE 4096
+#define AUDIOCACHE_TEXT_SIZE 256
+// Notes (frame data index 4) are only populated by polyphonic transcription on demand so they are not cached
+#define FRAMEDATA_CACHED_VALUES 4
+
+std::mutex AudioAnalysisCache::__lock;
+std::string AudioAnalysisCache::__cacheFolder;
+
+namespace
+{
+    // Fixed layout header at the start of a cached audio file. The sample data starts at AUDIOCACHE_HEADER_SIZE
+    // so it is page aligned when mapped.
+    struct AudioCacheHeader
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t channels;
+        uint32_t bits;
+        uint32_t extra;
+        int64_t rate;
+        int64_t trackSize;
+        int64_t lengthMS;
+        int64_t pcmdatasize;
+        uint64_t data0Offset;
+        uint64_t data1Offset;
+        uint64_t pcmOffset;
+        uint64_t fileSize;
+        char hash[64];
+        char title[AUDIOCACHE_TEXT_SIZE];
+        char artist[AUDIOCACHE_TEXT_SIZE];
+        char album[AUDIOCACHE_TEXT_SIZE];
+    };
+    static_assert(sizeof(AudioCacheHeader) <= AUDIOCACHE_HEADER_SIZE, "Audio cache header too big");
+
+    struct FrameCacheHeader
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t intervalMS;
+        uint32_t frames;
+        uint32_t values;
+        float bigmax;
+        float bigmin;
+        float bigspread;
+        float bigspectrogrammax;
+    };
+
+    const char AUDIO_MAGIC[8] = "XLAUDIO";
+    const char FRAME_MAGIC[8] = "XLAFRAM";
+    const char BLOB_MAGIC[8] = "XLABLOB";
+
+    void CopyText(char* dest, const std::string& src)
+    {
+        strncpy(dest, src.c_str(), AUDIOCACHE_TEXT_SIZE - 1);
+        dest[AUDIOCACHE_TEXT_SIZE - 1] = 0x00;
+    }
+}
+
+AudioAnalysisCache::AudioBlock::~AudioBlock()
+{
+    if (_block == nullptr) return;
+
+#ifdef USE_MMAP_AUDIOCACHE
+    if (_mapped) {
+        munmap(_block, _blockSize);
+        _block = nullptr;
+        return;
+    }
+#endif
+    free(_block);
+    _block = nullptr;
+}
+
+void AudioAnalysisCache::SetCacheFolder(const std::string& folder)
+{
+    static log4cpp::Category& logger_base = log4cpp::Category::getInstance(std::string("log_base"));
+
+    std::unique_lock<std::mutex> lock(__lock);
+    if (folder != "" && !wxDir::Exists(folder)) {
+        if (!wxFileName::Mkdir(folder, wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL)) {
+            logger_base.warn("Unable to create audio analysis cache folder %s. Audio analysis cache disabled.", (const char*)folder.c_str());
+            __cacheFolder = "";
+            return;
+        }
+    }
+    __cacheFolder = folder;
+    logger_base.debug("Audio analysis cache folder set to '%s'.", (const char*)__cacheFolder.c_str());
+}
+
+std::string AudioAnalysisCache::GetCacheFolder()
+{
+    std::unique_lock<std::mutex> lock(__lock);
+    return __cacheFolder;
+}
+
+bool AudioAnalysisCache::IsEnabled()
+{
+    return GetCacheFolder() != "";
+}
+
+std::string AudioAnalysisCache::GetMediaKey(const std::string& mediaFile, long rate)
+{
+    wxFileName fn(mediaFile);
+    if (!FileExists(fn, false)) return "";
+
+    std::string id = wxString::Format("%s|%llu|%lld|%ld|%d",
+        fn.GetFullPath(),
+        (unsigned long long)fn.GetSize().GetValue(),
+        (long long)fn.GetModificationTime().GetTicks(),
+        rate,
+        AUDIOCACHE_VERSION).ToStdString();
+
+    MD5 md5;
+    md5.update(id.c_str(), id.size());
+    md5.finalize();
+    return md5.hexdigest();
+}
+
+std::string AudioAnalysisCache::GetFileName(const std::string& key, const std::string& extension)
+{
+    std::string folder = GetCacheFolder();
+    if (folder == "" || key == "") return "";
+    return folder + wxFileName::GetPathSeparator() + key + "." + extension;
+}
+
+// Write to a temporary file and then rename it into place so a partially written file is never seen by a reader
+bool AudioAnalysisCache::WriteCacheFile(const std::string& filename, const std::vector<std::pair<const void*, size_t>>& parts)
+{
+    static log4cpp::Category& logger_base = log4cpp::Category::getInstance(std::string("log_base"));
+
+    std::string tmp = filename + ".tmp";
+    wxFile file;
+    if (!file.Create(tmp, true)) {
+        logger_base.warn("AudioAnalysisCache: Unable to create %s.", (const char*)tmp.c_str());
+        return false;
+    }
+
+    for (const auto& it : parts) {
+        if (it.second == 0) continue;
+        if (file.Write(it.first, it.second) != it.second) {
+            logger_base.warn("AudioAnalysisCache: Error writing %s.", (const char*)tmp.c_str());
+            file.Close();
+            wxRemoveFile(tmp);
+            return false;
+        }
+    }
+    file.Close();
+
+    if (!wxRenameFile(tmp, filename, true)) {
+        logger_base.warn("AudioAnalysisCache: Unable to rename %s.", (const char*)tmp.c_str());
+        wxRemoveFile(tmp);
+        return false;
+    }
+    return true;
+}
+
+std::unique_ptr<AudioAnalysisCache::AudioBlock> AudioAnalysisCache::LoadAudio(const std::string& mediaKey, int minExtra, long pcmFudge)
+{
+    static log4cpp::Category& logger_base = log4cpp::Category::getInstance(std::string("log_base"));
+
+    std::string filename = GetFileName(mediaKey, "audio");
+    if (filename == "" || !FileExists(filename, false)) return nullptr;
+
+    wxFile file;
+    if (!file.Open(filename)) return nullptr;
+
+    AudioCacheHeader header;
+    memset(&header, 0x00, sizeof(header));
+    if (file.Read(&header, sizeof(header)) != sizeof(header) ||
+        memcmp(header.magic, AUDIO_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != AUDIOCACHE_VERSION ||
+        header.fileSize != (uint64_t)file.Length() ||
+        header.pcmOffset + header.pcmdatasize + pcmFudge > header.fileSize) {
+        logger_base.debug("AudioAnalysisCache: %s is not a valid cache file ... ignoring it.", (const char*)filename.c_str());
+        file.Close();
+        wxRemoveFile(filename);
+        return nullptr;
+    }
+
+    // the cached copy does not have enough padding past the end of the track for the current analysis
+    if ((int)header.extra < minExtra) {
+        logger_base.debug("AudioAnalysisCache: %s has too little padding %d < %d.", (const char*)filename.c_str(), (int)header.extra, minExtra);
+        return nullptr;
+    }
+
+    size_t size = header.fileSize;
+    uint8_t* block = nullptr;
+    bool mapped = false;
+#ifdef USE_MMAP_AUDIOCACHE
+    // MAP_PRIVATE so in place filtering of the audio never makes it back to the cache file
+    void* m = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, file.fd(), 0);
+    if (m != MAP_FAILED) {
+        block = (uint8_t*)m;
+        mapped = true;
+    }
+#endif
+    if (block == nullptr) {
+        block = (uint8_t*)malloc(size);
+        if (block == nullptr) {
+            file.Close();
+            return nullptr;
+        }
+        file.Seek(0);
+        if (file.Read(block, size) != (ssize_t)size) {
+            free(block);
+            file.Close();
+            return nullptr;
+        }
+    }
+    file.Close();
+
+    auto res = std::make_unique<AudioBlock>(block, size, mapped);
+    res->rate = header.rate;
+    res->channels = header.channels;
+    res->bits = header.bits;
+    res->trackSize = header.trackSize;
+    res->extra = header.extra;
+    res->lengthMS = header.lengthMS;
+    res->pcmdatasize = header.pcmdatasize;
+    res->hash = std::string(header.hash, strnlen(header.hash, sizeof(header.hash)));
+    res->title = std::string(header.title, strnlen(header.title, sizeof(header.title)));
+    res->artist = std::string(header.artist, strnlen(header.artist, sizeof(header.artist)));
+    res->album = std::string(header.album, strnlen(header.album, sizeof(header.album)));
+    res->data0 = (float*)(block + header.data0Offset);
+    res->data1 = header.channels == 2 ? (float*)(block + header.data1Offset) : res->data0;
+    res->pcmdata = block + header.pcmOffset;
+
+    // touch it so trimming removes the least recently used files first
+    wxFileName(filename).Touch();
+
+    logger_base.debug("AudioAnalysisCache: Loaded decoded audio from %s.", (const char*)filename.c_str());
+    return res;
+}
+
+bool AudioAnalysisCache::SaveAudio(const std::string& mediaKey, const std::string& hash, long rate, int channels, int bits, long trackSize, int extra, long lengthMS,
+                                   const float* data0, const float* data1, const uint8_t* pcmdata, long pcmdatasize, long pcmFudge,
+                                   const std::string& title, const std::string& artist, const std::string& album)
+{
+    static log4cpp::Category& logger_base = log4cpp::Category::getInstance(std::string("log_base"));
+
+    std::string filename = GetFileName(mediaKey, "audio");
+    if (filename == "" || data0 == nullptr || pcmdata == nullptr) return false;
+
+    size_t dataSize = sizeof(float) * (trackSize + extra);
+
+    AudioCacheHeader header;
+    memset(&header, 0x00, sizeof(header));
+    memcpy(header.magic, AUDIO_MAGIC, sizeof(header.magic));
+    header.version = AUDIOCACHE_VERSION;
+    header.channels = channels;
+    header.bits = bits;
+    header.extra = extra;
+    header.rate = rate;
+    header.trackSize = trackSize;
+    header.lengthMS = lengthMS;
+    header.pcmdatasize = pcmdatasize;
+    header.data0Offset = AUDIOCACHE_HEADER_SIZE;
+    header.data1Offset = header.data0Offset + (channels == 2 ? dataSize : 0);
+    header.pcmOffset = header.data0Offset + dataSize * (channels == 2 ? 2 : 1);
+    header.fileSize = header.pcmOffset + pcmdatasize + pcmFudge;
+    strncpy(header.hash, hash.c_str(), sizeof(header.hash) - 1);
+    CopyText(header.title, title);
+    CopyText(header.artist, artist);
+    CopyText(header.album, album);
+
+    std::vector<uint8_t> headerBlock(AUDIOCACHE_HEADER_SIZE, 0x00);
+    memcpy(headerBlock.data(), &header, sizeof(header));
+
+    std::vector<std::pair<const void*, size_t>> parts;
+    parts.push_back({ headerBlock.data(), headerBlock.size() });
+    parts.push_back({ data0, dataSize });
+    if (channels == 2) parts.push_back({ data1, dataSize });
+    // decoders can overrun the estimated track size into the fudge space so it is saved too
+    parts.push_back({ pcmdata, (size_t)(pcmdatasize + pcmFudge) });
+
+    if (!WriteCacheFile(filename, parts)) return false;
+    logger_base.debug("AudioAnalysisCache: Saved decoded audio to %s.", (const char*)filename.c_str());
+    return true;
+}
+
+bool AudioAnalysisCache::LoadFrameData(const std::string& hash, int intervalMS, int frames, std::vector<std::vector<std::list<float>>>& frameData, FrameDataSummary& summary)
+{
+    static log4cpp::Category& logger_base = log4cpp::Category::getInstance(std::string("log_base"));
+
+    std::string filename = GetFileName(wxString::Format("%s_%d", hash, intervalMS).ToStdString(), "frames");
+    if (filename == "" || hash == "" || !FileExists(filename, false)) return false;
+
+    wxFile file;
+    if (!file.Open(filename)) return false;
+
+    std::vector<uint8_t> buffer(file.Length());
+    bool ok = file.Read(buffer.data(), buffer.size()) == (ssize_t)buffer.size();
+    file.Close();
+    if (!ok) return false;
+
+    FrameCacheHeader header;
+    memset(&header, 0x00, sizeof(header));
+    if (buffer.size() >= sizeof(header)) {
+        memcpy(&header, buffer.data(), sizeof(header));
+    }
+
+    // nothing in the file is trusted until it is checked ... every frame needs at least a count per value
+    if (buffer.size() < sizeof(header) ||
+        memcmp(header.magic, FRAME_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != AUDIOCACHE_VERSION ||
+        header.values != FRAMEDATA_CACHED_VALUES ||
+        (uint64_t)header.frames * header.values * sizeof(uint32_t) > buffer.size() - sizeof(header)) {
+        logger_base.debug("AudioAnalysisCache: %s is not a valid cache file ... ignoring it.", (const char*)filename.c_str());
+        wxRemoveFile(filename);
+        return false;
+    }
+
+    // a different interval or track length is a cache miss not a corrupt file
+    if ((int)header.intervalMS != intervalMS || (int)header.frames != frames) {
+        return false;
+    }
+
+    // Each frame is stored as the number of values in each list followed by the values
+    std::vector<std::vector<std::list<float>>> fd;
+    fd.reserve(frames);
+    const uint8_t* p = buffer.data() + sizeof(header);
+    const uint8_t* end = buffer.data() + buffer.size();
+    for (uint32_t i = 0; i < header.frames && ok; ++i) {
+        std::vector<std::list<float>> aFrameData;
+        aFrameData.resize(5);
+        for (uint32_t v = 0; v < header.values; ++v) {
+            if ((size_t)(end - p) < sizeof(uint32_t)) {
+                ok = false;
+                break;
+            }
+            uint32_t count;
+            memcpy(&count, p, sizeof(count));
+            p += sizeof(count);
+            if ((size_t)(end - p) / sizeof(float) < count) {
+                ok = false;
+                break;
+            }
+            const float* f = (const float*)p;
+            aFrameData[v].assign(f, f + count);
+            p += count * sizeof(float);
+        }
+        fd.push_back(std::move(aFrameData));
+    }
+
+    if (!ok || p != end) {
+        logger_base.debug("AudioAnalysisCache: %s is truncated or corrupt ... ignoring it.", (const char*)filename.c_str());
+        wxRemoveFile(filename);
+        return false;
+    }
+
+    frameData = std::move(fd);
+    summary.bigmax = header.bigmax;
+    summary.bigmin = header.bigmin;
+    summary.bigspread = header.bigspread;
+    summary.bigspectrogrammax = header.bigspectrogrammax;
+    wxFileName(filename).Touch();
+    return true;
+}
+
+bool AudioAnalysisCache::SaveFrameData(const std::string& hash, int intervalMS, const std::vector<std::vector<std::list<float>>>& frameData, const FrameDataSummary& summary)
+{
+    std::string filename = GetFileName(wxString::Format("%s_%d", hash, intervalMS).ToStdString(), "frames");
+    if (filename == "" || hash == "") return false;
+
+    const uint32_t values = FRAMEDATA_CACHED_VALUES;
+
+    FrameCacheHeader header;
+    memset(&header, 0x00, sizeof(header));
+    memcpy(header.magic, FRAME_MAGIC, sizeof(header.magic));
+    header.version = AUDIOCACHE_VERSION;
+    header.intervalMS = intervalMS;
+    header.frames = frameData.size();
+    header.values = values;
+    header.bigmax = summary.bigmax;
+    header.bigmin = summary.bigmin;
+    header.bigspread = summary.bigspread;
+    header.bigspectrogrammax = summary.bigspectrogrammax;
+
+    std::vector<uint8_t> buffer(sizeof(header));
+    memcpy(buffer.data(), &header, sizeof(header));
+    for (const auto& frame : frameData) {
+        for (uint32_t v = 0; v < values; ++v) {
+            uint32_t count = v < frame.size() ? frame[v].size() : 0;
+            size_t pos = buffer.size();
+            buffer.resize(pos + sizeof(count) + count * sizeof(float));
+            memcpy(&buffer[pos], &count, sizeof(count));
+            float* f = (float*)&buffer[pos + sizeof(count)];
+            if (count > 0) {
+                for (const auto& it : frame[v]) {
+                    *f++ = it;
+                }
+            }
+        }
+    }
+
+    return WriteCacheFile(filename, { { buffer.data(), buffer.size() } });
+}
+
+bool AudioAnalysisCache::LoadBlob(const std::string& hash, const std::string& type, std::vector<uint8_t>& data)
+{
+    std::string filename = GetFileName(hash, type);
+    if (filename == "" || hash == "" || !FileExists(filename, false)) return false;
+
+    wxFile file;
+    if (!file.Open(filename)) return false;
+
+    char magic[8];
+    uint32_t version = 0;
+    bool ok = file.Read(magic, sizeof(magic)) == sizeof(magic) &&
+              file.Read(&version, sizeof(version)) == sizeof(version) &&
+              memcmp(magic, BLOB_MAGIC, sizeof(magic)) == 0 &&
+              version == AUDIOCACHE_VERSION;
+    if (ok) {
+        data.resize(file.Length() - sizeof(magic) - sizeof(version));
+        ok = file.Read(data.data(), data.size()) == (ssize_t)data.size();
+    }
+    file.Close();
+    if (ok) wxFileName(filename).Touch();
+    return ok;
+}
+
+bool AudioAnalysisCache::SaveBlob(const std::string& hash, const std::string& type, const std::vector<uint8_t>& data)
+{
+    std::string filename = GetFileName(hash, type);
+    if (filename == "" || hash == "") return false;
+
+    uint32_t version = AUDIOCACHE_VERSION;
+    return WriteCacheFile(filename, { { BLOB_MAGIC, sizeof(BLOB_MAGIC) }, { &version, sizeof(version) }, { data.data(), data.size() } });
+}
+
+void AudioAnalysisCache::Trim(uint64_t maxBytes)
+{
+    static log4cpp::Category& logger_base = log4cpp::Category::getInstance(std::string("log_base"));
+
+    std::string folder = GetCacheFolder();
+    if (folder == "") return;
+
+    wxArrayString files;
+    GetAllFilesInDir(folder, files, "*.*");
+
+    struct CacheFile {
+        wxString name;
+        time_t modified;
+        uint64_t size;
+    };
+    std::vector<CacheFile> cacheFiles;
+    uint64_t total = 0;
+    for (const auto& it : files) {
+        wxFileName fn(it);
+        CacheFile cf{ it, fn.GetModificationTime().GetTicks(), (uint64_t)fn.GetSize().GetValue() };
+        total += cf.size;
+        cacheFiles.push_back(cf);
+    }
+
+    if (total <= maxBytes) return;
+
+    std::sort(cacheFiles.begin(), cacheFiles.end(), [](const CacheFile& a, const CacheFile& b) { return a.modified < b.modified; });
+    int removed = 0;
+    for (const auto& it : cacheFiles) {
+        if (total <= maxBytes) break;
+        if (wxRemoveFile(it.name)) {
+            total -= it.size;
+            ++removed;
+        }
+    }
+    logger_base.debug("AudioAnalysisCache: Trimmed %d files from the cache.", removed);
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+/***************************************************************
+ * This source files comes from the xLights project
+ * https://www.xlights.org
+ * https://github.com/smeighan/xLights
+ * See the github commit history for a record of contributing
+ * developers.
+ * Copyright claimed based on commit dates recorded in Github
+ * License: https://github.com/smeighan/xLights/blob/master/License.txt
+ **************************************************************/
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// On disk cache of the results of decoding and analysing an audio file.
+//
+// Decoded audio is keyed by the media file identity (path, size, modification time) so it can be found
+// without decoding anything. The cached audio records the AudioManager::Hash() of the decoded samples and
+// all derived analysis (frame data, waveform summaries) is keyed by that hash so it survives the media
+// file being moved or copied between show folders.
+class AudioAnalysisCache
+{
+public:
+
+    // Decoded audio as stored in the cache. The sample buffers point into a single block which is either
+    // memory mapped copy on write from the cache file or read into memory where mmap is not available.
+    class AudioBlock
+    {
+        uint8_t* _block = nullptr;
+        size_t _blockSize = 0;
+        bool _mapped = false;
+
+    public:
+        AudioBlock(uint8_t* block, size_t blockSize, bool mapped) :
+            _block(block), _blockSize(blockSize), _mapped(mapped) {}
+        ~AudioBlock();
+        AudioBlock(const AudioBlock&) = delete;
+        AudioBlock& operator=(const AudioBlock&) = delete;
+
+        long rate = 0;
+        int channels = 0;
+        int bits = 0;
+        long trackSize = 0;
+        int extra = 0;
+        long lengthMS = 0;
+        long pcmdatasize = 0;
+        std::string hash;
+        std::string title;
+        std::string artist;
+        std::string album;
+        float* data0 = nullptr;
+        float* data1 = nullptr;
+        uint8_t* pcmdata = nullptr;
+    };
+
+    struct FrameDataSummary
+    {
+        float bigmax = 0;
+        float bigmin = 0;
+        float bigspread = 0;
+        float bigspectrogrammax = 0;
+    };
+
+    static void SetCacheFolder(const std::string& folder);
+    static std::string GetCacheFolder();
+    static bool IsEnabled();
+
+    // Key identifying a media file decoded at a given rate without having to decode it
+    static std::string GetMediaKey(const std::string& mediaFile, long rate);
+
+    static std::unique_ptr<AudioBlock> LoadAudio(const std::string& mediaKey, int minExtra, long pcmFudge);
+    static bool SaveAudio(const std::string& mediaKey, const std::string& hash, long rate, int channels, int bits, long trackSize, int extra, long lengthMS,
+                          const float* data0, const float* data1, const uint8_t* pcmdata, long pcmdatasize, long pcmFudge,
+                          const std::string& title, const std::string& artist, const std::string& album);
+
+    static bool LoadFrameData(const std::string& hash, int intervalMS, int frames, std::vector<std::vector<std::list<float>>>& frameData, FrameDataSummary& summary);
+    static bool SaveFrameData(const std::string& hash, int intervalMS, const std::vector<std::vector<std::list<float>>>& frameData, const FrameDataSummary& summary);
+
+    // Generic analysis blobs keyed by audio hash ... used for data derived from the decoded audio
+    static bool LoadBlob(const std::string& hash, const std::string& type, std::vector<uint8_t>& data);
+    static bool SaveBlob(const std::string& hash, const std::string& type, const std::vector<uint8_t>& data);
+
+    // Remove the least recently used cache files until the cache is no bigger than maxBytes
+    static void Trim(uint64_t maxBytes);
+
+private:
+    static std::string GetFileName(const std::string& key, const std::string& extension);
+    static bool WriteCacheFile(const std::string& filename, const std::vector<std::pair<const void*, size_t>>& parts);
+
+    static std::mutex __lock;
+    static std::string __cacheFolder;
+};
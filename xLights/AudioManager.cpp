@@ -66,6 +66,9 @@ SDLManager __sdlManager;
 
 #define PCMFUDGE 32768
 
+// Decoded audio is big so the analysis cache is trimmed back to this size as new files are added
+#define AUDIO_ANALYSIS_CACHE_MAX_SIZE (2ULL * 1024 * 1024 * 1024)
+
 void fill_audio(void* udata, Uint8* stream, int len)
 {
     // SDL 2.0
@@ -1572,6 +1575,18 @@ void AudioManager::DoPrepareFrameData()
 	}
 	int totalsamples = frames * samplesperframe;
 
+    // Frame data only depends on the decoded audio and the interval so we may have it already
+    AudioAnalysisCache::FrameDataSummary summary;
+    if (AudioAnalysisCache::IsEnabled() && AudioAnalysisCache::LoadFrameData(Hash(), _intervalMS, frames, _frameData, summary)) {
+        _bigmax = summary.bigmax;
+        _bigmin = summary.bigmin;
+        _bigspread = summary.bigspread;
+        _bigspectogrammax = summary.bigspectrogrammax;
+        _frameDataPrepared = true;
+        logger_base.info("DoPrepareFrameData: Audio frame data loaded from the analysis cache in %ld. Frames: %d", sw.Time(), frames);
+        return;
+    }
+
     logger_base.info("    Length %ldms", _lengthMS);
     logger_base.info("    Interval %dms", _intervalMS);
     logger_base.info("    Samples per frame %d", samplesperframe);
@@ -1738,6 +1753,14 @@ void AudioManager::DoPrepareFrameData()
 	// flag the fact that the data is all ready
 	_frameDataPrepared = true;
 
+    if (AudioAnalysisCache::IsEnabled()) {
+        summary.bigmax = _bigmax;
+        summary.bigmin = _bigmin;
+        summary.bigspread = _bigspread;
+        summary.bigspectrogrammax = _bigspectogrammax;
+        AudioAnalysisCache::SaveFrameData(Hash(), _intervalMS, _frameData, summary);
+    }
+
 	logger_base.info("DoPrepareFrameData: Audio frame data processing complete in %ld. Frames: %d", sw.Time(), frames);
 }
 
@@ -2104,7 +2127,9 @@ AudioManager::~AudioManager()
             sdl->Stop();
             sdl->RemoveAudio(_sdlid);
         }
-        free(_pcmdata);
+        if (_cachedAudio == nullptr) {
+            free(_pcmdata);
+        }
         _pcmdata = nullptr;
     }
 
@@ -2128,6 +2153,12 @@ AudioManager::~AudioManager()
     // Grab the lock so we know the background process isnt running
     std::shared_lock<std::shared_timed_mutex> lock(_mutex);
 
+    if (_cachedAudio != nullptr) {
+        // the sample data belongs to the cache block
+        _data[0] = nullptr;
+        _data[1] = nullptr;
+        _cachedAudio.reset();
+    }
 	if (_data[1] != _data[0] && _data[1] != nullptr) {
 		free(_data[1]);
 		_data[1] = nullptr;
@@ -2174,17 +2205,12 @@ int AudioManager::OpenMediaFile()
     static log4cpp::Category &logger_base = log4cpp::Category::getInstance(std::string("log_base"));
     int err = 0;
 
-	if (_pcmdata != nullptr)
-	{
-        auto sdl = __sdlManager.GetOutputSDL(_device);
-        if (sdl != nullptr) {
-            sdl->Stop();
-            sdl->RemoveAudio(_sdlid);
-        }
-        _sdlid = -1;
-		free(_pcmdata);
-		_pcmdata = nullptr;
-	}
+    ReleaseAudioData();
+
+    // If we have decoded this file before then we can skip decoding it again
+    if (LoadFromAnalysisCache()) {
+        return err;
+    }
 
 	// Initialize FFmpeg codecs
     #if LIBAVFORMAT_VERSION_MAJOR < 58
@@ -2356,6 +2382,94 @@ int AudioManager::OpenMediaFile()
 	return err;
 }
 
+// Release the decoded audio whether we own it or it belongs to the analysis cache
+void AudioManager::ReleaseAudioData()
+{
+    if (_pcmdata != nullptr) {
+        auto sdl = __sdlManager.GetOutputSDL(_device);
+        if (sdl != nullptr) {
+            sdl->Stop();
+            sdl->RemoveAudio(_sdlid);
+        }
+        _sdlid = -1;
+        if (_cachedAudio == nullptr) {
+            free(_pcmdata);
+        }
+        _pcmdata = nullptr;
+    }
+
+    if (_cachedAudio != nullptr) {
+        _data[0] = nullptr;
+        _data[1] = nullptr;
+        _cachedAudio.reset();
+    }
+}
+
+bool AudioManager::LoadFromAnalysisCache()
+{
+    static log4cpp::Category& logger_base = log4cpp::Category::getInstance(std::string("log_base"));
+
+    if (!AudioAnalysisCache::IsEnabled()) return false;
+
+    _mediaKey = AudioAnalysisCache::GetMediaKey(_audio_file, RESAMPLE_RATE);
+    if (_mediaKey == "") return false;
+
+    auto cached = AudioAnalysisCache::LoadAudio(_mediaKey, _extra, PCMFUDGE);
+    if (cached == nullptr) return false;
+
+    // dump anything we decoded previously
+    if (_data[1] != nullptr && _data[1] != _data[0]) {
+        free(_data[1]);
+    }
+    if (_data[0] != nullptr) {
+        free(_data[0]);
+    }
+
+    _rate = cached->rate;
+    _channels = cached->channels;
+    _bits = cached->bits;
+    _trackSize = cached->trackSize;
+    _extra = cached->extra;
+    _lengthMS = cached->lengthMS;
+    _pcmdatasize = cached->pcmdatasize;
+    _title = cached->title;
+    _artist = cached->artist;
+    _album = cached->album;
+    _data[0] = cached->data0;
+    _data[1] = cached->data1;
+    _pcmdata = cached->pcmdata;
+    {
+        std::unique_lock<std::mutex> locker(_hashLock);
+        _hash = cached->hash;
+    }
+    _cachedAudio = std::move(cached);
+    SetLoadedData(_trackSize);
+
+    auto sdl = __sdlManager.GetOutputSDL(_device);
+    if (sdl != nullptr) {
+        _sdlid = sdl->AddAudio(_pcmdatasize, _pcmdata, 100, _rate, _trackSize, _lengthMS);
+    }
+
+    logger_base.debug("Audio for %s loaded from the analysis cache.", (const char*)_audio_file.c_str());
+    return true;
+}
+
+// Called once the audio is fully decoded so the next open of this file can skip decoding
+void AudioManager::SaveToAnalysisCache()
+{
+    if (!_ok || _mediaKey == "" || _cachedAudio != nullptr || !AudioAnalysisCache::IsEnabled()) return;
+
+    std::string hash = Hash();
+
+    // stop the audio being filtered in place while we write it out
+    std::shared_lock<std::shared_timed_mutex> lock(_mutex);
+    if (AudioAnalysisCache::SaveAudio(_mediaKey, hash, _rate, _channels, _bits, _trackSize, _extra, _lengthMS,
+                                      _data[0], _data[1], _pcmdata, _pcmdatasize, PCMFUDGE,
+                                      _title, _artist, _album)) {
+        AudioAnalysisCache::Trim(AUDIO_ANALYSIS_CACHE_MAX_SIZE);
+    }
+}
+
 void AudioManager::LoadTrackData(AVFormatContext* formatContext, AVCodecContext* codecContext, AVStream* audioStream)
 {
     static log4cpp::Category &logger_base = log4cpp::Category::getInstance(std::string("log_base"));
@@ -2497,6 +2611,8 @@ void AudioManager::DoLoadAudioData(AVFormatContext* formatContext, AVCodecContex
     avformat_close_input(&formatContext);
 
     logger_base.debug("DoLoadAudioData: Song data loaded in %ld. Read: %ld", sw.Time(), read);
+
+    SaveToAnalysisCache();
 }
 
 void AudioManager::LoadAudioFromFrame( AVFormatContext* formatContext, AVCodecContext* codecContext, AVPacket* decodingPacket, AVFrame* frame, SwrContext* au_convert_ctx, bool receivedEOF, int out_channels, uint8_t* out_buffer, long& read, int& lastpct )
@@ -3030,9 +3146,121 @@ void AudioManager::GetLeftDataMinMax(long start, long end, float& minimum, float
         return;
     }
 
-    for (int j = start; j < std::min(end, _trackSize); j++) {
-        minimum = std::min(minimum, fad->data0[j]);
-        maximum = std::max(maximum, fad->data0[j]);
+    {
+        std::unique_lock<std::mutex> locker(_pyramidLock);
+        BuildMinMaxPyramid(fad);
+    }
+    const MinMaxPyramid& pyramid = fad->pyramid;
+
+    // Walk the range taking the biggest aligned bucket that fits at each step and only touching raw samples
+    // at the unaligned ends
+    end = std::min(end, _trackSize);
+    long pos = std::max(start, 0L);
+    while (pos < end) {
+        int level = -1;
+        for (int l = 0; l < (int)pyramid.mins.size(); ++l) {
+            long size = (long)MINMAX_PYRAMID_BASE << l;
+            if (pos % size != 0 || pos + size > end) {
+                break;
+            }
+            level = l;
+        }
+
+        if (level < 0) {
+            minimum = std::min(minimum, fad->data0[pos]);
+            maximum = std::max(maximum, fad->data0[pos]);
+            ++pos;
+        } else {
+            long index = pos >> (MINMAX_PYRAMID_BASE_SHIFT + level);
+            minimum = std::min(minimum, pyramid.mins[level][index]);
+            maximum = std::max(maximum, pyramid.maxs[level][index]);
+            pos += (long)MINMAX_PYRAMID_BASE << level;
+        }
+    }
+}
+
+// Build the min/max pyramid for a set of filtered data ... must be called holding _pyramidLock
+void AudioManager::BuildMinMaxPyramid(FilteredAudioData* fad)
+{
+    if (fad->pyramid.IsBuilt() || fad->data0 == nullptr || _trackSize <= 0) return;
+
+    MinMaxPyramid& pyramid = fad->pyramid;
+    std::string blobType = wxString::Format("wave_%d_%d_%d", (int)fad->type, fad->lowNote, fad->highNote).ToStdString();
+
+    std::vector<uint8_t> blob;
+    if (AudioAnalysisCache::IsEnabled() && AudioAnalysisCache::LoadBlob(Hash(), blobType, blob)) {
+        // levels, then for each level the bucket count followed by the minimums and maximums
+        const uint8_t* p = blob.data();
+        const uint8_t* blobEnd = blob.data() + blob.size();
+        uint32_t levels = 0;
+        bool ok = blob.size() >= sizeof(levels);
+        if (ok) {
+            memcpy(&levels, p, sizeof(levels));
+            p += sizeof(levels);
+        }
+        for (uint32_t l = 0; ok && l < levels; ++l) {
+            uint32_t count = 0;
+            ok = p + sizeof(count) <= blobEnd;
+            if (!ok) break;
+            memcpy(&count, p, sizeof(count));
+            p += sizeof(count);
+            ok = p + 2 * count * sizeof(float) <= blobEnd;
+            if (!ok) break;
+            pyramid.mins.emplace_back((const float*)p, (const float*)p + count);
+            p += count * sizeof(float);
+            pyramid.maxs.emplace_back((const float*)p, (const float*)p + count);
+            p += count * sizeof(float);
+        }
+        if (ok && levels > 0 && pyramid.mins[0].size() == (size_t)((_trackSize + MINMAX_PYRAMID_BASE - 1) / MINMAX_PYRAMID_BASE)) {
+            return;
+        }
+        pyramid.mins.clear();
+        pyramid.maxs.clear();
+    }
+
+    long buckets = (_trackSize + MINMAX_PYRAMID_BASE - 1) / MINMAX_PYRAMID_BASE;
+    pyramid.mins.emplace_back(buckets);
+    pyramid.maxs.emplace_back(buckets);
+    for (long b = 0; b < buckets; ++b) {
+        long start = b * MINMAX_PYRAMID_BASE;
+        long end = std::min(start + MINMAX_PYRAMID_BASE, _trackSize);
+        float mn = fad->data0[start];
+        float mx = mn;
+        for (long i = start + 1; i < end; ++i) {
+            mn = std::min(mn, fad->data0[i]);
+            mx = std::max(mx, fad->data0[i]);
+        }
+        pyramid.mins[0][b] = mn;
+        pyramid.maxs[0][b] = mx;
+    }
+
+    while (pyramid.mins.back().size() > 1) {
+        const std::vector<float>& lmins = pyramid.mins.back();
+        const std::vector<float>& lmaxs = pyramid.maxs.back();
+        size_t count = (lmins.size() + 1) / 2;
+        std::vector<float> mins(count);
+        std::vector<float> maxs(count);
+        for (size_t i = 0; i < count; ++i) {
+            size_t a = i * 2;
+            size_t b = std::min(a + 1, lmins.size() - 1);
+            mins[i] = std::min(lmins[a], lmins[b]);
+            maxs[i] = std::max(lmaxs[a], lmaxs[b]);
+        }
+        pyramid.mins.push_back(std::move(mins));
+        pyramid.maxs.push_back(std::move(maxs));
+    }
+
+    if (AudioAnalysisCache::IsEnabled()) {
+        uint32_t levels = pyramid.mins.size();
+        blob.clear();
+        blob.insert(blob.end(), (const uint8_t*)&levels, (const uint8_t*)&levels + sizeof(levels));
+        for (uint32_t l = 0; l < levels; ++l) {
+            uint32_t count = pyramid.mins[l].size();
+            blob.insert(blob.end(), (const uint8_t*)&count, (const uint8_t*)&count + sizeof(count));
+            blob.insert(blob.end(), (const uint8_t*)pyramid.mins[l].data(), (const uint8_t*)(pyramid.mins[l].data() + count));
+            blob.insert(blob.end(), (const uint8_t*)pyramid.maxs[l].data(), (const uint8_t*)(pyramid.maxs[l].data() + count));
+        }
+        AudioAnalysisCache::SaveBlob(Hash(), blobType, blob);
     }
 }
 
@@ -3145,17 +3373,33 @@ xLightsVamp::~xLightsVamp() {}
 
 std::string AudioManager::Hash()
 {
+    {
+        std::unique_lock<std::mutex> locker(_hashLock);
+        if (_hash != "") return _hash;
+    }
+
+    // the lock is not held while waiting so other callers are not stuck behind a slow decode
+    static log4cpp::Category &logger_base = log4cpp::Category::getInstance(std::string("log_base"));
+    while (!IsDataLoaded(_trackSize))
+    {
+        logger_base.debug("GetLeftDataPtr waiting for data to be loaded.");
+        wxMilliSleep(100);
+    }
+
+    std::unique_lock<std::mutex> locker(_hashLock);
     if (_hash == "")
     {
-        static log4cpp::Category &logger_base = log4cpp::Category::getInstance(std::string("log_base"));
-        while (!IsDataLoaded(_trackSize))
-        {
-            logger_base.debug("GetLeftDataPtr waiting for data to be loaded.");
-            wxMilliSleep(100);
+        // hash the unfiltered audio even if a filter is currently applied
+        float* data = _data[0];
+        for (const auto& it : _filtered) {
+            if (it->type == AUDIOSAMPLETYPE::RAW && it->data0 != nullptr) {
+                data = it->data0;
+                break;
+            }
         }
 
         MD5 md5;
-        md5.update((unsigned char *)_data[0], sizeof(float)*_trackSize);
+        md5.update((unsigned char *)data, sizeof(float)*_trackSize);
         md5.finalize();
         _hash = md5.hexdigest();
     }
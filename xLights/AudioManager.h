@@ -36,6 +36,7 @@ extern "C"
 }
 
 #include "vamp-hostsdk/PluginLoader.h"
+#include "AudioAnalysisCache.h"
 #include <wx/progdlg.h>
 
 class AudioManager;
@@ -239,6 +240,18 @@ public:
     }
 };
 
+// Power of two min/max summaries of the left channel. Level 0 summarises MINMAX_PYRAMID_BASE samples per
+// bucket and each level above halves the bucket count so any range can be answered from O(log n) buckets
+#define MINMAX_PYRAMID_BASE_SHIFT 4
+#define MINMAX_PYRAMID_BASE (1 << MINMAX_PYRAMID_BASE_SHIFT)
+
+typedef struct MinMaxPyramid
+{
+    std::vector<std::vector<float>> mins;
+    std::vector<std::vector<float>> maxs;
+    bool IsBuilt() const { return !mins.empty(); }
+} MinMaxPyramid;
+
 typedef struct FilteredAudioData
 {
     AUDIOSAMPLETYPE type;
@@ -247,6 +260,7 @@ typedef struct FilteredAudioData
     float* data0 = nullptr;
     float* data1 = nullptr;
     int16_t* pcmdata = nullptr;
+    MinMaxPyramid pyramid;
 } FilteredAudioData;
 
 class AudioManager
@@ -281,9 +295,13 @@ class AudioManager
 	MEDIAPLAYINGSTATE _media_state;
 	bool _polyphonicTranscriptionDone = false;
     std::vector<FilteredAudioData*> _filtered;
+    std::mutex _pyramidLock;
     int _sdlid = 0;
     bool _ok = false;
     std::string _hash;
+    std::mutex _hashLock;
+    std::string _mediaKey;
+    std::unique_ptr<AudioAnalysisCache::AudioBlock> _cachedAudio;
     std::future<void> _prepFrameData;
     std::future<void> _loadingAudio;
     std::string _device;
@@ -295,6 +313,9 @@ class AudioManager
 	void SplitTrackDataAndNormalize(signed short* trackData, long trackSize, float* leftData, float* rightData) const;
     static void NormalizeMonoTrackData(signed short* trackData, long trackSize, float* leftData);
 	int OpenMediaFile();
+    bool LoadFromAnalysisCache();
+    void SaveToAnalysisCache();
+    void ReleaseAudioData();
 	void PrepareFrameData(bool separateThread);
     static int decodebitrateindex(int bitrateindex, int version, int layertype);
 	int decodesamplerateindex(int samplerateindex, int version) const;
@@ -309,6 +330,7 @@ class AudioManager
     void SetLoadedData(long pos);
 
     void NormaliseFilteredAudioData(FilteredAudioData* fad);
+    void BuildMinMaxPyramid(FilteredAudioData* fad);
 
     static bool WriteAudioFrame( AVFormatContext *oc, AVCodecContext* codecContext, AVStream *st, float *sampleBuff, int sampleCount, bool clearQueue = false );
 
@@ -0,0 +1,92 @@
+/***************************************************************
+ * This source files comes from the xLights project
+ * https://www.xlights.org
+ * https://github.com/smeighan/xLights
+ * See the github commit history for a record of contributing
+ * developers.
+ * Copyright claimed based on commit dates recorded in Github
+ * License: https://github.com/smeighan/xLights/blob/master/License.txt
+ **************************************************************/
+
+#include "FSEQStreamWriter.h"
+#include "FSEQFile.h"
+#include "SequenceData.h"
+#include "../common/xlBaseApp.h"
+
+#include <log4cpp/Category.hh>
+
+FSEQStreamWriter::FSEQStreamWriter(FSEQFile* file, SequenceData& seqData, bool releaseFrames) :
+    _file(file), _seqData(seqData), _releaseFrames(releaseFrames)
+{
+    _thread = std::thread([this] {
+        try {
+            xlCrashHandler::SetupCrashHandlerForNonWxThread();
+            Run();
+        } catch (...) {
+            wxTheApp->OnUnhandledException();
+        }
+    });
+}
+
+FSEQStreamWriter::~FSEQStreamWriter()
+{
+    Finish();
+}
+
+void FSEQStreamWriter::FramesComplete(int frame)
+{
+    std::unique_lock<std::mutex> lock(_lock);
+    if (frame > (int)_seqData.NumFrames()) {
+        frame = _seqData.NumFrames();
+    }
+    if (frame > _complete) {
+        _complete = frame;
+        _signal.notify_all();
+    }
+}
+
+void FSEQStreamWriter::Finish()
+{
+    static log4cpp::Category& logger_base = log4cpp::Category::getInstance(std::string("log_base"));
+
+    if (_file == nullptr) {
+        return;
+    }
+    {
+        std::unique_lock<std::mutex> lock(_lock);
+        _finishing = true;
+        _complete = _seqData.NumFrames();
+        _signal.notify_all();
+    }
+    if (_thread.joinable()) {
+        _thread.join();
+    }
+    _file->finalize();
+    delete _file;
+    _file = nullptr;
+    logger_base.debug("Streamed %d frames to fseq file.", _written);
+}
+
+void FSEQStreamWriter::Run()
+{
+    std::unique_lock<std::mutex> lock(_lock);
+    while (true) {
+        _signal.wait(lock, [this] { return _complete > _written || _finishing; });
+        int start = _written;
+        int end = _complete;
+        lock.unlock();
+
+        for (int frame = start; frame < end; ++frame) {
+            _file->addFrame(frame, &_seqData[frame][0]);
+        }
+        if (_releaseFrames && end > start) {
+            _seqData.ReleaseFrames(start, end - 1);
+        }
+
+        lock.lock();
+        _written = end;
+        if (_finishing && _written >= _complete) {
+            return;
+        }
+    }
+}
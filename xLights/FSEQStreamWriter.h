@@ -0,0 +1,54 @@
+#pragma once
+
+/***************************************************************
+ * This source files comes from the xLights project
+ * https://www.xlights.org
+ * https://github.com/smeighan/xLights
+ * See the github commit history for a record of contributing
+ * developers.
+ * Copyright claimed based on commit dates recorded in Github
+ * License: https://github.com/smeighan/xLights/blob/master/License.txt
+ **************************************************************/
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+class FSEQFile;
+class SequenceData;
+
+// Writes frames to an fseq file on a background thread as the render completes them.
+//
+// The render reports how far every model has got and frames before that point are compressed and
+// appended to the file while the rest of the sequence is still rendering. When releaseFrames is set the
+// written frames are released from the sequence data so only the frames still being rendered stay
+// resident.
+class FSEQStreamWriter
+{
+public:
+    // takes ownership of the file which must already have its header written
+    FSEQStreamWriter(FSEQFile* file, SequenceData& seqData, bool releaseFrames);
+    virtual ~FSEQStreamWriter();
+    FSEQStreamWriter(const FSEQStreamWriter&) = delete;
+    FSEQStreamWriter& operator=(const FSEQStreamWriter&) = delete;
+
+    // all frames before frame are fully rendered
+    void FramesComplete(int frame);
+
+    // write the remaining frames and close the file
+    void Finish();
+
+private:
+    void Run();
+
+    FSEQFile* _file = nullptr;
+    SequenceData& _seqData;
+    bool _releaseFrames = false;
+
+    std::mutex _lock;
+    std::condition_variable _signal;
+    int _complete = 0;
+    int _written = 0;
+    bool _finishing = false;
+    std::thread _thread;
+};
@@ -1618,11 +1618,10 @@ void FileConverter::ReadFalconFile(ConvertParameters& params)
     delete file;
 }
 
-void FileConverter::WriteFalconPiFile(ConvertParameters& params)
+FSEQFile* FileConverter::CreateFalconPiFile(ConvertParameters& params)
 {
     static log4cpp::Category &logger_conversion = log4cpp::Category::getInstance(std::string("log_conversion"));
-    logger_conversion.debug("Start fseq write");
-       
+
     const wxUint8 fType = params.xLightsFrm->_fseqVersion;
     int vMajor = 2;
     int clevel = 2;
@@ -1649,7 +1648,7 @@ void FileConverter::WriteFalconPiFile(ConvertParameters& params)
     FSEQFile *file = FSEQFile::createFSEQFile(params.out_filename, vMajor, ctype, clevel);
     if (!file) {
         params.ConversionError(wxString("Unable to create file: ") + params.out_filename + ". Check directory and file permissions.");
-        return;
+        return nullptr;
     }
     size_t stepSize = roundTo4(params.seq_data.NumChannels());
     wxUint16 stepTime = params.seq_data.FrameTime();
@@ -1687,6 +1686,18 @@ void FileConverter::WriteFalconPiFile(ConvertParameters& params)
     }
 
     file->writeHeader();
+    return file;
+}
+
+void FileConverter::WriteFalconPiFile(ConvertParameters& params)
+{
+    static log4cpp::Category &logger_conversion = log4cpp::Category::getInstance(std::string("log_conversion"));
+    logger_conversion.debug("Start fseq write");
+
+    FSEQFile *file = CreateFalconPiFile(params);
+    if (!file) {
+        return;
+    }
     size_t size = params.seq_data.NumFrames();
     for (int x = 0; x < size; x++) {
         file->addFrame(x, &params.seq_data[x][0]);
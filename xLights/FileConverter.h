@@ -20,6 +20,7 @@
 #include "Color.h"
 
 class xLightsFrame; // forward declare to prevent including the world
+class FSEQFile;
 class ConvertDialog;
 class ConvertLogDialog;
 class OutputManager;
@@ -88,6 +89,8 @@ class FileConverter
         static void ReadConductorFile(ConvertParameters& params);
         static void ReadFalconFile(ConvertParameters& params);
         static void WriteFalconPiFile(ConvertParameters& params);
+        // Create the fseq file and write its header, frames are added by the caller
+        static FSEQFile* CreateFalconPiFile(ConvertParameters& params);
 
     
         static bool LoadVixenProfile(ConvertParameters& params, const wxString& ProfileName,
@@ -43,7 +43,7 @@ void xlFont::GatherInfo()
     {
         widths[i] = char_width;
     }
-    wxImage image = bitmap.ConvertToImage();
+    image = bitmap.ConvertToImage();
     for( int y = 0; y < FONT_BITMAP_ROWS; y++)
     {
         int y_pos = (y * (char_height + 1)) + 1;
@@ -21,6 +21,7 @@ class xlFont
         xlFont(wxBitmap& bitmap_);
         virtual ~xlFont();
         wxBitmap* get_bitmap() { return &bitmap; }
+        const wxImage& get_image() const { return image; }
         int GetWidth() { return char_width; }
         int GetHeight() { return char_height; }
         int GetCharWidth(int ascii); 
@@ -34,6 +35,7 @@ class xlFont
         int caps_height;  // the capital letter height
         int widths[XL_FONT_WIDTHS];  // the trimmed width of each character
         wxBitmap& bitmap;
+        wxImage image;    // the bitmap converted once so rendering can read the pixels directly
 };
 
 class FontManager
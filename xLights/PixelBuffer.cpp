@@ -14,6 +14,7 @@
 #include "models/ModelManager.h"
 #include "models/SingleLineModel.h"
 #include "models/ModelGroup.h"
+#include "models/RenderBufferNodeCache.h"
 #include "UtilClasses.h"
 #include "AudioManager.h"
 #include "BufferPanel.h"
@@ -26,6 +27,7 @@
 #include "UtilFunctions.h"
 #include "DissolveTransitionPattern.h"
 #include "GPURenderUtils.h"
+#include "RenderArena.h"
 
 // This is needed for visual studio
 #ifdef _MSC_VER
@@ -1394,7 +1396,7 @@ void PixelBufferClass::GetMixedColor(int node, const std::vector<bool> & validLa
             if (node >= thelayer->buffer.Nodes.size()) {
                 //logger_base.crit("PixelBufferClass::GetMixedColor thelayer->buffer.Nodes does not contain node %d as it is only %d in size ... this was going to crash.", node, thelayer->buffer.Nodes.size());
             } else {
-                auto &coord = thelayer->buffer.Nodes[node]->Coords[0];
+                const auto& coord = std::as_const(thelayer->buffer.Nodes[node]->Coords)[0];
                 int x = coord.bufX;
                 int y = coord.bufY;
 
@@ -1682,37 +1684,38 @@ void PixelBufferClass::GetMixedColor(int lx, int ly, xlColor& c, const std::vect
 }
 
 //http://blog.ivank.net/fastest-gaussian-blur.html
-static void boxesForGauss(int d, int n, std::vector<float> &boxes)  // standard deviation, number of boxes
+static void boxesForGauss(int d, int n, float boxes[3])  // standard deviation, number of boxes
 {
+    boxes[0] = 0.0;
     switch (d) {
         case 2:
         case 3:
-            boxes.push_back(1.0);
+            boxes[0] = 1.0;
             break;
         case 4:
         case 5:
         case 6:
-            boxes.push_back(3.0);
+            boxes[0] = 3.0;
             break;
         case 7:
         case 8:
         case 9:
-            boxes.push_back(5.0);
+            boxes[0] = 5.0;
             break;
         case 10:
         case 11:
         case 12:
-            boxes.push_back(7.0);
+            boxes[0] = 7.0;
             break;
         case 13:
         case 14:
         case 15:
-            boxes.push_back(9.0);
+            boxes[0] = 9.0;
             break;
         default:
             break;
     }
-    float b = boxes.back();
+    float b = boxes[0];
     switch (d) {
         case 2:
         case 4:
@@ -1723,10 +1726,10 @@ static void boxesForGauss(int d, int n, std::vector<float> &boxes)  // standard
         case 11:
         case 13:
         case 14:
-            boxes.push_back(b);
+            boxes[1] = b;
             break;
         default:
-            boxes.push_back(b + 2.0);
+            boxes[1] = b + 2.0;
             break;
     }
     switch (d) {
@@ -1734,10 +1737,10 @@ static void boxesForGauss(int d, int n, std::vector<float> &boxes)  // standard
         case 7:
         case 10:
         case 13:
-            boxes.push_back(b);
+            boxes[2] = b;
             break;
         default:
-            boxes.push_back(b + 2.0);
+            boxes[2] = b + 2.0;
     }
 }
 
@@ -1745,7 +1748,7 @@ static void boxesForGauss(int d, int n, std::vector<float> &boxes)  // standard
 #define GREEN(a, b) a[(b)*4 + 1]
 #define BLUE(a, b) a[(b)*4 + 2]
 #define ALPHA(a, b) a[(b)*4 + 3]
-static inline void SET(std::vector<float>& ar, int idx, float r, float g, float b, float a) {
+static inline void SET(float* ar, int idx, float r, float g, float b, float a) {
     idx *= 4;
     ar[idx++] = r;
     ar[idx++] = g;
@@ -1753,7 +1756,7 @@ static inline void SET(std::vector<float>& ar, int idx, float r, float g, float
     ar[idx] = a;
 }
 
-static void boxBlurH_4 (const std::vector<float>& scl, std::vector<float>& tcl, int w, int h, float r) {
+static void boxBlurH_4 (const float* scl, float* tcl, int w, int h, float r) {
     float iarr = 1.0f / (r+r+1.0f);
     for(int i=0; i<h; i++) {
         int ti = i*w;
@@ -1823,7 +1826,7 @@ static void boxBlurH_4 (const std::vector<float>& scl, std::vector<float>& tcl,
     }
 }
 
-static void boxBlurT_4 (const std::vector<float>& scl, std::vector<float>& tcl, int w, int h, float r) {
+static void boxBlurT_4 (const float* scl, float* tcl, int w, int h, float r) {
     float iarr = 1.0f / (r+r+1.0f);
     for(int i=0; i<w; i++) {
         int ti = i;
@@ -1895,15 +1898,14 @@ static void boxBlurT_4 (const std::vector<float>& scl, std::vector<float>& tcl,
     }
 }
 
-static void boxBlur_4(std::vector<float>& scl, std::vector<float>& tcl, int w, int h, float r, int size) {
-    tcl = scl;
-    //memcpy(tcl, scl, sizeof(float)*4*size);
+static void boxBlur_4(float* scl, float* tcl, int w, int h, float r, int size) {
+    memcpy(tcl, scl, sizeof(float)*4*size);
     boxBlurH_4(tcl, scl, w, h, r);
     boxBlurT_4(scl, tcl, w, h, r);
 }
 
-static void gaussBlur_4(std::vector<float>& scl, std::vector<float>& tcl, int w, int h, int r, int size) {
-    std::vector<float> bxs;
+static void gaussBlur_4(float* scl, float* tcl, int w, int h, int r, int size) {
+    float bxs[3];
     boxesForGauss(r - 1, 3, bxs);
     boxBlur_4 (scl, tcl, w, h, (bxs[0]-1)/2, size);
     boxBlur_4 (tcl, scl, w, h, (bxs[1]-1)/2, size);
@@ -1936,12 +1938,10 @@ void PixelBufferClass::Blur(LayerInfo* layer, float offset)
             GPURenderUtils::waitForRenderCompletion(&layer->buffer);
             int os = std::max((int)layer->buffer.pixelVector.size(), layer->BufferWi * layer->BufferHt);
             int pixCount = layer->buffer.pixelVector.size();
-            std::vector<float> input;
-            input.resize(os * 4);
-            std::vector<float> tmp;
-            tmp.resize(os * 4);
-            //float * input = new float[pixCount * 4];
-            //float * tmp = new float[pixCount * 4];
+            RenderArena::Scope scope;
+            float* input = scope.Arena().AllocateArray<float>(os * 4);
+            float* tmp = scope.Arena().AllocateArray<float>(os * 4);
+            memset(input + pixCount * 4, 0, sizeof(float) * 4 * (os - pixCount));
             for (int x = 0; x < pixCount; x++) {
                 const xlColor &c = layer->buffer.pixels[x];
                 input[x * 4] = c.red;
@@ -1949,7 +1949,7 @@ void PixelBufferClass::Blur(LayerInfo* layer, float offset)
                 input[x * 4 + 2] = c.blue;
                 input[x * 4 + 3] = c.alpha;
             }
-            gaussBlur_4(input, tmp, layer->BufferWi, layer->BufferHt, b, pixCount);
+            gaussBlur_4(input, tmp, layer->BufferWi, layer->BufferHt, b, os);
 
             for (int x = 0; x < pixCount; x++) {
                 layer->buffer.pixels[x].Set(roundInt(tmp[x*4]),
@@ -1971,7 +1971,11 @@ void PixelBufferClass::Blur(LayerInfo* layer, float offset)
             d = (b - 1) / 2;
             u = (b - 1) / 2;
         }
-        RenderBuffer orig(layer->buffer);
+        // only the pixels are needed so copy them rather than the whole buffer
+        RenderArena::Scope scope;
+        int pixCount = std::min((int)layer->buffer.pixelVector.size(), layer->BufferWi * layer->BufferHt);
+        xlColor* orig = static_cast<xlColor*>(scope.Arena().Allocate(sizeof(xlColor) * pixCount, alignof(xlColor)));
+        memcpy(orig, layer->buffer.pixels, sizeof(xlColor) * pixCount);
         for (int x = 0; x < layer->BufferWi; x++) {
             for (int y = 0; y < layer->BufferHt; y++) {
                 int r = 0;
@@ -1983,7 +1987,8 @@ void PixelBufferClass::Blur(LayerInfo* layer, float offset)
                     if (i >= 0 && i < layer->BufferWi) {
                         for (int j = y - d; j <= y + u; j++) {
                             if (j >=0 && j < layer->BufferHt) {
-                                const xlColor &c = orig.GetPixel(i, j);
+                                int pidx = j * layer->BufferWi + i;
+                                const xlColor &c = pidx < pixCount ? orig[pidx] : xlBLACK;
                                 r += c.red;
                                 g += c.green;
                                 b2 += c.blue;
@@ -2362,10 +2367,10 @@ void PixelBufferClass::SetLayerSettings(int layer, const SettingsMap &settingsMa
 
         inf->BufferOffsetX = 0;
         inf->BufferOffsetY = 0;
-        model->InitRenderBufferNodes(tt, camera, transform, inf->buffer.Nodes, inf->BufferWi, inf->BufferHt, go_deep);
+        RenderBufferNodeCache::InitRenderBufferNodes(model, tt, camera, transform, inf->buffer.Nodes, inf->BufferWi, inf->BufferHt, go_deep);
         if (origNodeCount != 0 && origNodeCount != inf->buffer.Nodes.size()) {
             inf->buffer.Nodes.clear();
-            model->InitRenderBufferNodes(tt, camera, transform, inf->buffer.Nodes, inf->BufferWi, inf->BufferHt, go_deep);
+            RenderBufferNodeCache::InitRenderBufferNodes(model, tt, camera, transform, inf->buffer.Nodes, inf->BufferWi, inf->BufferHt, go_deep);
         }
 
         ComputeSubBuffer(subBuffer, inf->buffer.Nodes,
@@ -2423,7 +2428,7 @@ void PixelBufferClass::SetLayerSettings(int layer, const SettingsMap &settingsMa
                         std::string ntype = "Default"; // type.substr(10, type.length() - 10);
                         int bw, bh;
                         it->Nodes.clear();
-                        (*it_m)->InitRenderBufferNodes(ntype, camera, transform, it->Nodes, bw, bh);
+                        RenderBufferNodeCache::InitRenderBufferNodes(*it_m, ntype, camera, transform, it->Nodes, bw, bh);
                         if (bw == 0)
                             bw = 1; // zero sized buffers are a problem
                         if (bh == 0)
@@ -2443,7 +2448,7 @@ void PixelBufferClass::SetLayerSettings(int layer, const SettingsMap &settingsMa
                         std::string ntype = type.substr(10, type.length() - 10);
                         int bw, bh;
                         it->Nodes.clear();
-                        gp->ActiveModels()[cnt]->InitRenderBufferNodes(ntype, camera, transform, it->Nodes, bw, bh);
+                        RenderBufferNodeCache::InitRenderBufferNodes(gp->ActiveModels()[cnt], ntype, camera, transform, it->Nodes, bw, bh);
                         if (bw == 0)
                             bw = 1; // zero sized buffers are a problem
                         if (bh == 0)
@@ -2503,9 +2508,9 @@ void PixelBufferClass::UnMergeBuffersForLayer(int layer) {
         for (const auto& modelBuffer : *(layers[layer]->modelBuffers)) {
             for (const auto& mbnode : modelBuffer->Nodes) {
                 if (nc < layers[layer]->buffer.Nodes.size()) {
-                    auto &node = layers[layer]->buffer.Nodes[nc];
-                    layers[layer]->buffer.GetPixel(node->Coords[0].bufX, node->Coords[0].bufY, color);
-                    for (const auto& coord : mbnode->Coords) {
+                    const auto& coord0 = std::as_const(layers[layer]->buffer.Nodes[nc]->Coords)[0];
+                    layers[layer]->buffer.GetPixel(coord0.bufX, coord0.bufY, color);
+                    for (const auto& coord : std::as_const(mbnode->Coords)) {
                         modelBuffer->SetPixel(coord.bufX, coord.bufY, color);
                     }
                     nc++;
@@ -2541,8 +2546,9 @@ void PixelBufferClass::MergeBuffersForLayer(int layer) {
         for (const auto& modelBuffer : *(layers[layer]->modelBuffers)) {
             for (const auto& node : modelBuffer->Nodes) {
                 if (nc < layers[layer]->buffer.Nodes.size()) {
-                    modelBuffer->GetPixel(node->Coords[0].bufX, node->Coords[0].bufY, color);
-                    for (const auto& coord : layers[layer]->buffer.Nodes[nc]->Coords) {
+                    const auto& coord0 = std::as_const(node->Coords)[0];
+                    modelBuffer->GetPixel(coord0.bufX, coord0.bufY, color);
+                    for (const auto& coord : std::as_const(layers[layer]->buffer.Nodes[nc]->Coords)) {
                         layers[layer]->buffer.SetPixel(coord.bufX, coord.bufY, color);
                     }
                     nc++;
@@ -2691,7 +2697,7 @@ void PixelBufferClass::SetColors(int layer, const unsigned char *fdata)
             if (curve != nullptr) {
                 curve->reverse(color);
             }
-            for (const auto &a : n->Coords) {
+            for (const auto& a : std::as_const(n->Coords)) {
                 layers[layer]->buffer.SetPixel(a.bufX, a.bufY, color);
             }
         }
@@ -2707,7 +2713,7 @@ void PixelBufferClass::SetColors(int layer, const unsigned char *fdata)
             if (curve != nullptr) {
                 curve->reverse(color);
             }
-            for (const auto &a : n->Coords) {
+            for (const auto& a : std::as_const(n->Coords)) {
                 layers[layer]->buffer.SetPixel(a.bufX, a.bufY, color);
             }
         },  500);
@@ -2938,7 +2944,7 @@ void PixelBufferClass::PrepareVariableSubBuffer(int EffectPeriod, int layer)
     layers[layer]->buffer.Nodes.clear();
     layers[layer]->BufferOffsetX = 0;
     layers[layer]->BufferOffsetY = 0;
-    model->InitRenderBufferNodes(type, camera, transform, layers[layer]->buffer.Nodes, layers[layer]->BufferWi, layers[layer]->BufferHt);
+    RenderBufferNodeCache::InitRenderBufferNodes(model, type, camera, transform, layers[layer]->buffer.Nodes, layers[layer]->BufferWi, layers[layer]->BufferHt);
     ComputeSubBuffer(subBuffer, layers[layer]->buffer.Nodes, layers[layer]->BufferWi, layers[layer]->BufferHt,
                      layers[layer]->BufferOffsetX, layers[layer]->BufferOffsetY,
                      offset, layers[layer]->buffer.GetStartTimeMS(), layers[layer]->buffer.GetEndTimeMS());
@@ -8,6 +8,9 @@
  * License: https://github.com/smeighan/xLights/blob/master/License.txt
  **************************************************************/
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <mutex>
 #include <condition_variable>
 #include <map>
@@ -17,6 +20,7 @@
 #include "xLightsXmlFile.h"
 #include "RenderCommandEvent.h"
 #include "effects/RenderableEffect.h"
+#include "effects/PictureFrameCache.h"
 #include "RenderProgressDialog.h"
 #include "SeqExportDialog.h"
 #include "RenderUtils.h"
@@ -27,6 +31,9 @@
 #include "Parallel.h"
 #include "ExternalHooks.h"
 #include "GPURenderUtils.h"
+#include "FSEQStreamWriter.h"
+#include "RenderArena.h"
+#include "RenderCostEstimates.h"
 
 #include <log4cpp/Category.hh>
 
@@ -90,8 +97,7 @@ public:
 class NextRenderer {
 public:
 
-    NextRenderer() : nextLock(), nextSignal() {
-        previousFrameDone = -1;
+    NextRenderer() : nextLock(), nextSignal(), previousFrameDone(-1), waiters(0) {
     }
 
     virtual ~NextRenderer() {}
@@ -115,22 +121,33 @@ public:
         }
     }
 
+    // The frame watermark only moves forward and is read without locking. The lock is only taken to wake
+    // up a renderer that got ahead of the renderers it depends on and went to sleep.
     virtual void setPreviousFrameDone(int i) {
-        std::unique_lock<std::mutex> lock(nextLock);
-        previousFrameDone = i;
-        nextSignal.notify_all();
+        int cur = previousFrameDone;
+        while (cur < i && !previousFrameDone.compare_exchange_weak(cur, i)) {
+        }
+        if (waiters != 0) {
+            std::unique_lock<std::mutex> lock(nextLock);
+            nextSignal.notify_all();
+        }
     }
 
     int waitForFrame(int frame) {
+        int done = previousFrameDone;
+        if (frame <= done) {
+            return done;
+        }
         std::unique_lock<std::mutex> lock(nextLock);
+        ++waiters;
         while (frame > previousFrameDone) {
-            nextSignal.wait_for(lock, std::chrono::milliseconds(10));
+            nextSignal.wait(lock);
         }
+        --waiters;
         return previousFrameDone;
     }
 
     bool checkIfDone(int frame, int timeout = 5) {
-        std::unique_lock<std::mutex> lock(nextLock);
         return previousFrameDone >= frame;
     }
 
@@ -142,7 +159,8 @@ public:
 protected:
     std::mutex nextLock;
     std::condition_variable nextSignal;
-    volatile long previousFrameDone;
+    std::atomic_int previousFrameDone;
+    std::atomic_int waiters;
 private:
     std::vector<NextRenderer *> next;
 };
@@ -151,7 +169,7 @@ class AggregatorRenderer: public NextRenderer {
 public:
 
     AggregatorRenderer(int numFrames) : NextRenderer(), finalFrame(numFrames + 19) {
-        data = new int[numFrames + 20];
+        data = new std::atomic_int[numFrames + 20];
         for (int x = 0; x < (numFrames + 20); ++x) {
             data[x] = 0;
         }
@@ -180,20 +198,15 @@ public:
         if (idx == END_OF_RENDER_FRAME) {
             idx = finalFrame;
         }
-        if (idx % 10 == 0 || idx == finalFrame) {
-            //only record every 10th frame and the final frame to
-            //avoid a lot of lock contention
-            std::unique_lock<std::mutex> lock(nextLock);
-            ++data[idx];
-            if (data[idx] == max) {
-                previousFrameDone = frame;
-                FrameDone(previousFrameDone);
-            }
+        // the last renderer to finish a frame passes it on, the renderers after us ignore frames that
+        // arrive after a later frame
+        if (++data[idx] == max) {
+            FrameDone(frame);
         }
     }
 
 private:
-    int *data;
+    std::atomic_int *data;
     int max;
     const int finalFrame;
 };
@@ -222,13 +235,50 @@ public:
     const int node;
 };
 
+class RenderJob;
+
+// A range of frames of a model split off from its RenderJob so it can be rendered on another thread.
+// Whichever of the pool thread or the owning job claims it first renders it.
+class RenderSegment {
+public:
+    RenderSegment(RenderJob *j, int s, int e) : job(j), start(s), end(e), state(0) {}
+    ~RenderSegment();
+
+    bool Claim() {
+        int expected = 0;
+        return state.compare_exchange_strong(expected, 1);
+    }
+
+    void Done() {
+        std::unique_lock<std::mutex> lock(segmentLock);
+        state = 2;
+        segmentSignal.notify_all();
+    }
+
+    void WaitForDone() {
+        std::unique_lock<std::mutex> lock(segmentLock);
+        while (state != 2) {
+            segmentSignal.wait_for(lock, std::chrono::milliseconds(10));
+        }
+    }
+
+    RenderJob *job;
+    const int start;
+    const int end;
+
+private:
+    std::atomic_int state;
+    std::mutex segmentLock;
+    std::condition_variable segmentSignal;
+};
+
 
 class RenderJob: public Job, public NextRenderer {
 public:
     RenderJob(ModelElement *row, SequenceData &data, xLightsFrame *xframe, bool zeroBased = false)
         : Job(), NextRenderer(), rowToRender(row), seqData(&data), xLights(xframe),
             gauge(nullptr), currentFrame(0), renderLog(log4cpp::Category::getInstance(std::string("log_render"))),
-            supportsModelBlending(false), abort(false), statusMap(nullptr)
+            supportsModelBlending(false), abort(false), segmentsCancelled(false), renderTimeMS(0), renderedFrames(0), statusMap(nullptr)
     {
         name = "";
         if (row != nullptr) {
@@ -332,6 +382,10 @@ public:
     int GetCurrentFrame() const { return currentFrame;}
     int GetEndFrame() const { return endFrame;}
     int GetStartFrame() const { return startFrame;}
+    bool IsAborted() const { return abort; }
+    // time spent rendering excluding waiting on other models
+    double GetRenderTimeMS() const { return renderTimeMS; }
+    int GetRenderedFrames() const { return renderedFrames; }
 
     const std::string GetName() const override {
         return name;
@@ -674,6 +728,9 @@ public:
             renderLog.info("*** Frame #%d at %dms render on model %s (%dx%d) took more than 1/2s => %dms.", frame, frame * b.frameTimeInMs, (const char *)el->GetName().c_str(), b.BufferWi, b.BufferHt, sw.Time());
         }
 
+        // nothing allocated while rendering the frame is needed any more
+        RenderArena::ForThread().Reset();
+
         return effectsToUpdate;
     }
 
@@ -736,11 +793,16 @@ public:
                 mainModelInfo.effectStates[layer] = true;
             }
 
-            for (int frame = startFrame; frame <= endFrame; ++frame) {
+            // frames after the first split point are handed to other threads
+            int lastFrame = CreateSegments() ? segments.front()->start - 1 : (int)endFrame;
+            bool bailed = false;
+
+            for (int frame = startFrame; frame <= lastFrame; ++frame) {
                 currentFrame = frame;
                 SetGenericStatus("%s: Starting frame %d ", frame, true, true);
 
                 if (abort) {
+                    bailed = true;
                     break;
                 }
 
@@ -749,6 +811,7 @@ public:
                          || rowToRender->GetWaitCount())) {
                     //we're bailing out but make sure this range is reconsidered
                     rowToRender->SetDirtyRange(frame * seqData->FrameTime(), endFrame * seqData->FrameTime());
+                    bailed = true;
                     break;
                 }
                 //make sure we can do this frame
@@ -761,6 +824,7 @@ public:
                     }
                     SetGenericStatus("%s: Processing frame %d ", frame, true, true);
                 }
+                auto frameStart = std::chrono::steady_clock::now();
                 bool cleared = ProcessFrame(frame, rowToRender, mainModelInfo, mainBuffer, -1, supportsModelBlending);
                 if (!subModelInfos.empty()) {
                     for (const auto& a : subModelInfos) {
@@ -814,11 +878,16 @@ public:
                     }
                 }
                 //mainBuffer->ApplyDimmingCurves(&((*seqData)[frame][0]));
+                renderTimeMS += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - frameStart).count();
+                ++renderedFrames;
                 if (HasNext()) {
                     SetGenericStatus("%s: Notifying next renderer of frame %d done", frame, true);
                     FrameDone(frame);
                 }
             }
+            if (!bailed) {
+                FinishSegments(origChangeCount);
+            }
             SetGenericStatus("%s: All done - Completed frame %d ", endFrame, true, false);
         } catch ( std::exception &ex) {
             wxASSERT(false); // so when we debug we catch them
@@ -831,6 +900,7 @@ public:
 			renderLog.error("Caught an unknown exception on rendering thread.");
             logger_base.error("Caught an unknown exception on rendering thread.");
         }
+        CancelSegments();
         if (HasNext()) {
             //make sure the previous has told us we're at the end.  If we return before waiting, the previous
             //may try sending the END_OF_RENDER_FRAME to us and we'll have been deleted
@@ -857,8 +927,152 @@ public:
 
     ModelElement* GetModelElement() const { return rowToRender; }
 
+    // Render this job's range as a segment of owner's range. The owner handles the locking, waiting on
+    // the renderers it depends on and notifying the renderers that depend on it.
+    void RenderSegmentFrames(RenderJob *owner) {
+        static log4cpp::Category& logger_base = log4cpp::Category::getInstance(std::string("log_base"));
+
+        EffectLayerInfo info(numLayers);
+        try {
+            for (int layer = numLayers - 1; layer >= 0; --layer) {
+                EffectLayer *elayer = rowToRender->GetEffectLayer(layer);
+                std::unique_lock<std::recursive_mutex> elock(elayer->GetLock());
+                info.currentEffects[layer] = findEffectForFrame(elayer, startFrame, info.currentEffectIdxs[layer]);
+                SetInializingStatus(startFrame, layer, -1, -1, -1);
+                initialize(layer, startFrame, info.currentEffects[layer], info.settingsMaps[layer], mainBuffer);
+                info.effectStates[layer] = true;
+            }
+
+            int maxFrameBeforeCheck = -1;
+            for (int frame = startFrame; frame <= endFrame; ++frame) {
+                currentFrame = frame;
+                if (owner->abort || owner->segmentsCancelled) {
+                    break;
+                }
+                if (frame >= maxFrameBeforeCheck) {
+                    SetWaitingStatus(frame);
+                    maxFrameBeforeCheck = owner->waitForFrame(frame);
+                }
+                auto frameStart = std::chrono::steady_clock::now();
+                ProcessFrame(frame, rowToRender, info, mainBuffer, -1, supportsModelBlending);
+                renderTimeMS += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - frameStart).count();
+                ++renderedFrames;
+            }
+        } catch (std::exception &ex) {
+            wxASSERT(false);
+            renderLog.error("Caught an exception on segment rendering thread: " + std::string(ex.what()));
+            logger_base.error("Caught an exception on segment rendering thread: %s", ex.what());
+        } catch (...) {
+            wxASSERT(false);
+            renderLog.error("Caught an unknown exception on segment rendering thread.");
+            logger_base.error("Caught an unknown exception on segment rendering thread.");
+        }
+        currentFrame = END_OF_RENDER_FRAME;
+    }
+
 private:
 
+    // Find frames in (start, end] where every layer can start rendering from a freshly initialized buffer
+    // and still produce the same output as rendering straight through from start.
+    std::vector<bool> FindSplitFrames(int start, int end) {
+        int frameTime = seqData->FrameTime();
+        std::vector<bool> safe(end - start + 1, true);
+        safe[0] = false;
+
+        auto markUnsafe = [&safe, start, end](int s, int e) {
+            for (int f = std::max(s, start); f <= std::min(e, end); ++f) {
+                safe[f - start] = false;
+            }
+        };
+
+        for (int layer = 0; layer < rowToRender->GetEffectLayerCount(); ++layer) {
+            EffectLayer *elayer = rowToRender->GetEffectLayer(layer);
+            std::unique_lock<std::recursive_mutex> elock(elayer->GetLock());
+            for (int e = 0; e < elayer->GetEffectCount(); ++e) {
+                Effect *ef = elayer->GetEffect(e);
+                // first and last frames for which findEffectForFrame returns this effect
+                int fs = (ef->GetStartTimeMS() + frameTime - 1) / frameTime;
+                int fe = (ef->GetEndTimeMS() + frameTime - 1) / frameTime - 1;
+                if (fe < start || fs > end) {
+                    continue;
+                }
+
+                RenderableEffect *reff = xLights->GetEffectManager().GetEffect(ef->GetEffectIndex());
+                const SettingsMap &settings = ef->GetSettings();
+                const SettingsMap &palette = ef->GetPaletteMap();
+
+                // sparkles are tracked per node across frames and effects
+                if (palette.GetInt("C_SLIDER_SparkleFrequency", 0) > 0 ||
+                    palette.GetBool("C_CHECKBOX_MusicSparkles", false) ||
+                    palette.Get("C_VALUECURVE_SparkleFrequency", "").find("Active=TRUE") != std::string::npos) {
+                    markUnsafe(fs, fe + 1);
+                } else if (ef->IsPersistent()) {
+                    // draws over whatever the layer held before it started
+                    markUnsafe(fs, fe + 1);
+                } else if (reff == nullptr || !reff->CanRenderPartialTimeInterval() ||
+                           settings.GetInt("T_SPINCTRL_FreezeEffectAtFrame", 999999) != 999999) {
+                    markUnsafe(fs + 1, fe);
+                }
+            }
+        }
+        return safe;
+    }
+
+    bool CreateSegments();
+
+    // Render the segments that have not been picked up by other threads and pass on the completed frames
+    // in order to the renderers that depend on this one
+    void FinishSegments(int origChangeCount) {
+        for (const auto& seg : segments) {
+            currentFrame = seg->start;
+            if (abort) {
+                break;
+            }
+            if (!HasNext() &&
+                (origChangeCount != rowToRender->getChangeCount()
+                 || rowToRender->GetWaitCount())) {
+                rowToRender->SetDirtyRange(seg->start * seqData->FrameTime(), endFrame * seqData->FrameTime());
+                break;
+            }
+            if (seg->Claim()) {
+                SetGenericStatus("%s: Rendering segment from frame %d ", seg->start, true);
+                seg->job->RenderSegmentFrames(this);
+                seg->Done();
+            } else {
+                SetWaitingStatus(seg->start);
+                seg->WaitForDone();
+            }
+            if (abort) {
+                break;
+            }
+            renderTimeMS += seg->job->GetRenderTimeMS();
+            renderedFrames += seg->job->GetRenderedFrames();
+            if (HasNext()) {
+                SetGenericStatus("%s: Notifying next renderer of frames to %d done", seg->end, true);
+                for (int frame = seg->start; frame <= seg->end; ++frame) {
+                    FrameDone(frame);
+                }
+            }
+        }
+    }
+
+    // Make sure no other thread is still using the segments before releasing them
+    void CancelSegments() {
+        if (segments.empty()) {
+            return;
+        }
+        segmentsCancelled = true;
+        for (const auto& seg : segments) {
+            if (seg->Claim()) {
+                seg->Done();
+            } else {
+                seg->WaitForDone();
+            }
+        }
+        segments.clear();
+        segmentsCancelled = false;
+    }
+
     void initialize(int layer, int frame, Effect *el, SettingsMap &settingsMap, PixelBufferClass *buffer) {
         if (el == nullptr || el->GetEffectIndex() == -1) {
             settingsMap.clear();
@@ -937,12 +1151,109 @@ private:
     wxGauge *gauge;
     std::atomic_int currentFrame;
     std::atomic_bool abort;
+    double renderTimeMS;
+    int renderedFrames;
 
     std::vector<EffectLayerInfo *> subModelInfos;
 
     std::map<SNPair, PixelBufferClassPtr> nodeBuffers;
+
+    std::vector<std::shared_ptr<RenderSegment>> segments;
+    std::atomic_bool segmentsCancelled;
 };
 
+RenderSegment::~RenderSegment() {
+    delete job;
+}
+
+class RenderSegmentJob : public Job {
+public:
+    RenderSegmentJob(std::shared_ptr<RenderSegment> seg, RenderJob *o) : Job(), segment(seg), owner(o) {}
+
+    virtual void Process() override {
+        // owner waits for any segment it did not claim itself so it is still alive while we render
+        if (segment->Claim()) {
+            segment->job->RenderSegmentFrames(owner);
+            segment->Done();
+        }
+    }
+
+    virtual bool DeleteWhenComplete() override {
+        return true;
+    }
+
+    const std::string GetName() const override {
+        return segment->job->GetName();
+    }
+
+private:
+    std::shared_ptr<RenderSegment> segment;
+    RenderJob *owner;
+};
+
+#define MIN_RENDER_SEGMENT_FRAMES 200
+
+// Split the job's range at effect boundaries so long models with only stateless effects can be rendered
+// on several threads. Submodel, strand and node effects render together with the model so jobs with those
+// stay on one thread.
+bool RenderJob::CreateSegments() {
+    static log4cpp::Category& logger_render = log4cpp::Category::getInstance(std::string("log_render"));
+
+    if (!xLights->GetRenderSegments() || !subModelInfos.empty() || !nodeBuffers.empty()) {
+        return false;
+    }
+    int frames = endFrame - startFrame + 1;
+    int count = std::min(frames / MIN_RENDER_SEGMENT_FRAMES, xLights->GetRenderJobPool().maxSize());
+    if (count < 2) {
+        return false;
+    }
+
+    std::vector<bool> safe = FindSplitFrames(startFrame, endFrame);
+    std::vector<int> splits;
+    int window = frames / count / 2;
+    int last = startFrame;
+    for (int x = 1; x < count; ++x) {
+        int target = startFrame + frames * x / count;
+        for (int d = 0; d < window; ++d) {
+            int f = target - d;
+            if (f - last >= MIN_RENDER_SEGMENT_FRAMES / 2 && safe[f - startFrame]) {
+                splits.push_back(f);
+                break;
+            }
+            f = target + d;
+            if (endFrame - f >= MIN_RENDER_SEGMENT_FRAMES / 2 && safe[f - startFrame]) {
+                splits.push_back(f);
+                break;
+            }
+        }
+        if (!splits.empty()) {
+            last = splits.back();
+        }
+    }
+    if (splits.empty()) {
+        return false;
+    }
+    splits.push_back(endFrame + 1);
+
+    for (size_t x = 0; x + 1 < splits.size(); ++x) {
+        RenderJob *job = new RenderJob(rowToRender, *seqData, xLights, false);
+        if (job->getBuffer() == nullptr) {
+            delete job;
+            segments.clear();
+            return false;
+        }
+        job->setRenderRange(splits[x], splits[x + 1] - 1);
+        job->rangeRestriction = rangeRestriction;
+        job->supportsModelBlending = supportsModelBlending;
+        segments.push_back(std::make_shared<RenderSegment>(job, splits[x], splits[x + 1] - 1));
+    }
+    logger_render.debug("Rendering %s in %d segments.", (const char *)name.c_str(), (int)segments.size() + 1);
+    for (const auto& seg : segments) {
+        xLights->GetRenderJobPool().PushJob(new RenderSegmentJob(seg, this));
+    }
+    return true;
+}
+
 
 IMPLEMENT_DYNAMIC_CLASS(RenderCommandEvent, wxCommandEvent)
 IMPLEMENT_DYNAMIC_CLASS(SelectedEffectChangedEvent, wxCommandEvent)
@@ -1006,6 +1317,8 @@ public:
         jobs = nullptr;
         aggregators = nullptr;
         renderProgressDialog = nullptr;
+        streamWriter = nullptr;
+        costEstimates = nullptr;
     };
     std::function<void()> callback;
     int numRows;
@@ -1014,6 +1327,9 @@ public:
     RenderJob **jobs;
     AggregatorRenderer **aggregators;
     RenderProgressDialog *renderProgressDialog;
+    FSEQStreamWriter *streamWriter;
+    RenderCostEstimates *costEstimates;
+    std::string sequenceFile;
     std::list<Model *> restriction;
 };
 
@@ -1113,6 +1429,8 @@ void xLightsFrame::UpdateRenderStatus() {
 
         int frames = rpi->endFrame - rpi->startFrame + 1;
         if( frames <= 0 ) frames = 1;
+        // every frame before this one has been rendered by all the models
+        int framesComplete = rpi->endFrame + 1;
         for (size_t row = 0; row < rpi->numRows; ++row) {
 
             if (rpi->jobs[row]) {
@@ -1122,6 +1440,7 @@ void xLightsFrame::UpdateRenderStatus() {
                 }
                 if (i != END_OF_RENDER_FRAME) {
                     done = false;
+                    framesComplete = std::min(framesComplete, i);
                 }
                 if (rpi->jobs[row]->GetEndFrame() > rpi->endFrame) {
                     frames += rpi->jobs[row]->GetEndFrame() - rpi->endFrame;
@@ -1164,7 +1483,25 @@ void xLightsFrame::UpdateRenderStatus() {
             }
         }
 
+        if (rpi->streamWriter != nullptr) {
+            rpi->streamWriter->FramesComplete(framesComplete);
+        }
+
         if (done) {
+            if (rpi->costEstimates != nullptr) {
+                bool recorded = false;
+                for (size_t row = 0; row < rpi->numRows; ++row) {
+                    if (rpi->jobs[row] && !rpi->jobs[row]->IsAborted() && rpi->jobs[row]->GetRenderedFrames() > 0) {
+                        rpi->costEstimates->RecordTimePerFrame(rpi->jobs[row]->GetName(), rpi->jobs[row]->GetRenderTimeMS() / rpi->jobs[row]->GetRenderedFrames());
+                        recorded = true;
+                    }
+                }
+                if (recorded) {
+                    rpi->costEstimates->Save(rpi->sequenceFile);
+                }
+                delete rpi->costEstimates;
+                rpi->costEstimates = nullptr;
+            }
             for (size_t row = 0; row < rpi->numRows; ++row) {
                 if (rpi->jobs[row]) {
                     delete rpi->jobs[row];
@@ -1177,6 +1514,8 @@ void xLightsFrame::UpdateRenderStatus() {
             }
             _appProgress->SetValue(0);
             _appProgress->Reset();
+            RenderArena::LogStatistics();
+            PictureFrameCache::LogStatistics();
             RenderDone();
             delete []rpi->jobs;
             delete []rpi->aggregators;
@@ -1336,7 +1675,8 @@ void xLightsFrame::Render(SequenceElements& seqElements,
                           const std::list<Model *> &restrictToModels,
                           int startFrame, int endFrame,
                           bool progressDialog, bool clear,
-                          std::function<void()>&& callback) {
+                          std::function<void()>&& callback,
+                          FSEQStreamWriter* streamWriter) {
 
     static log4cpp::Category &logger_base = log4cpp::Category::getInstance(std::string("log_base"));
     static log4cpp::Category &logger_render = log4cpp::Category::getInstance(std::string("log_render"));
@@ -1361,6 +1701,7 @@ void xLightsFrame::Render(SequenceElements& seqElements,
     RenderJob **jobs = new RenderJob*[numRows];
     AggregatorRenderer **aggregators = new AggregatorRenderer*[numRows];
     std::vector<std::set<int>> channelMaps(seqData.NumChannels());
+    std::vector<std::vector<int>> feeds(numRows);
 
     size_t row = 0;
     for (auto it = models.begin(); it != models.end(); ++it, ++row) {
@@ -1412,6 +1753,7 @@ void xLightsFrame::Render(SequenceElements& seqElements,
                                     if (idx != row) {
                                         if (jobs[idx]->addNext(aggregators[row])) {
                                             aggregators[row]->incNumAggregated();
+                                            feeds[idx].push_back(row);
                                         }
                                     }
                                 }
@@ -1426,6 +1768,58 @@ void xLightsFrame::Render(SequenceElements& seqElements,
 
     logger_render.debug("Aggregators created.");
 
+    // Estimate how long each job will take, using the times measured on earlier renders of this sequence
+    // where we have them and scaling the other estimates to match. Only renders of (nearly) the whole sequence
+    // read or record the measured times ... the small renders done while editing are not worth the file access
+    // and their timings over a few frames would overwrite the better ones from full renders.
+    std::string sequenceFile = CurrentSeqXmlFile == nullptr ? "" : CurrentSeqXmlFile->GetFullPath().ToStdString();
+    RenderCostEstimates *costEstimates = nullptr;
+    if (restrictToModels.empty() && (int64_t)(endFrame - startFrame + 1) * 10 >= (int64_t)seqData.NumFrames() * 9) {
+        costEstimates = new RenderCostEstimates();
+        costEstimates->Load(sequenceFile);
+    }
+    std::vector<double> estimates(numRows, 0.0);
+    std::vector<double> measured(numRows, -1.0);
+    double estimatedTotal = 0;
+    double measuredTotal = 0;
+    for (row = 0; row < numRows; ++row) {
+        if (jobs[row]) {
+            estimates[row] = RenderCostEstimates::EstimateCost(jobs[row]->GetModelElement(), jobs[row]->getBuffer()->GetNodeCount(), seqData.FrameTime(), startFrame, endFrame);
+            double tpf = costEstimates == nullptr ? -1 : costEstimates->GetTimePerFrame(jobs[row]->GetName());
+            if (tpf >= 0) {
+                measured[row] = tpf * (endFrame - startFrame + 1);
+                estimatedTotal += estimates[row];
+                measuredTotal += measured[row];
+            }
+        }
+    }
+    double scale = (measuredTotal > 0 && estimatedTotal > 0) ? measuredTotal / estimatedTotal : 1.0;
+
+    // A job's path cost is its own cost plus the longest path through the jobs waiting on it. Jobs only
+    // wait on earlier rows so one pass from the end covers every path.
+    std::vector<double> pathCost(numRows, 0.0);
+    for (int r = numRows - 1; r >= 0; --r) {
+        if (jobs[r]) {
+            double after = 0;
+            for (const auto& f : feeds[r]) {
+                after = std::max(after, pathCost[f]);
+            }
+            pathCost[r] = (measured[r] >= 0 ? measured[r] : estimates[r] * scale) + after;
+        }
+    }
+    // Longest path first. A job always costs at least as much as the jobs waiting on it and the sort is
+    // stable so every job still starts before the jobs that wait on it.
+    std::vector<int> order;
+    for (row = 0; row < numRows; ++row) {
+        if (jobs[row]) {
+            order.push_back(row);
+        }
+    }
+    std::stable_sort(order.begin(), order.end(), [&pathCost](int a, int b) { return pathCost[a] > pathCost[b]; });
+    if (!order.empty()) {
+        logger_render.debug("Longest render path starts with %s, estimated %0.0fms.", (const char *)jobs[order.front()]->GetName().c_str(), pathCost[order.front()]);
+    }
+
     channelMaps.clear();
     RenderProgressDialog *renderProgressDialog = nullptr;
     if (progressDialog) {
@@ -1445,11 +1839,8 @@ void xLightsFrame::Render(SequenceElements& seqElements,
     for (row = 0; row < numRows; ++row) {
         if (jobs[row]) {
             if (aggregators[row]->getNumAggregated() == 0) {
-                //start all the jobs that don't depend on anything above them
-                //get them rendering while we setup the rest
+                //jobs that don't depend on anything above them can render straight through
                 jobs[row]->setPreviousFrameDone(END_OF_RENDER_FRAME);
-                jobPool.PushJob(jobs[row]);
-                ++count;
             }
             if (progressDialog) {
                 wxStaticText *label = new wxStaticText(renderProgressDialog->scrolledWindow, wxID_ANY, jobs[row]->GetName());
@@ -1464,12 +1855,9 @@ void xLightsFrame::Render(SequenceElements& seqElements,
     }
 
     logger_render.debug("Job pool start size %d.", (int)jobPool.size());
-    for (row = 0; row < numRows; ++row) {
-        if (jobs[row] && aggregators[row]->getNumAggregated() != 0) {
-            //now start the rest
-            jobPool.PushJob(jobs[row]);
-            ++count;
-        }
+    for (const auto& r : order) {
+        jobPool.PushJob(jobs[r]);
+        ++count;
     }
     logger_base.debug("Job pool new size %d.", (int)jobPool.size());
 
@@ -1489,10 +1877,14 @@ void xLightsFrame::Render(SequenceElements& seqElements,
         pi->renderProgressDialog = renderProgressDialog;
         pi->restriction = restrictToModels;
         pi->aggregators = aggregators;
+        pi->streamWriter = streamWriter;
+        pi->costEstimates = costEstimates;
+        pi->sequenceFile = sequenceFile;
 
         renderProgressInfo.push_back(pi);
         RenderStatusTimer.Start(100, false);
     } else {
+        delete costEstimates;
         callback();
         if (progressDialog) {
             delete renderProgressDialog;
@@ -1633,7 +2025,7 @@ bool xLightsFrame::AbortRender(int maxTimeMS)
     return abortCount != 0;
 }
 
-void xLightsFrame::RenderGridToSeqData(std::function<void()>&& callback) {
+void xLightsFrame::RenderGridToSeqData(std::function<void()>&& callback, FSEQStreamWriter* streamWriter) {
 
     static log4cpp::Category &logger_base = log4cpp::Category::getInstance(std::string("log_base"));
 
@@ -1683,7 +2075,7 @@ void xLightsFrame::RenderGridToSeqData(std::function<void()>&& callback) {
         });
     });
 #else
-    Render(_sequenceElements, _seqData, models, restricts, 0, _seqData.NumFrames() - 1, true, false, std::move(callback));
+    Render(_sequenceElements, _seqData, models, restricts, 0, _seqData.NumFrames() - 1, true, false, std::move(callback), streamWriter);
 #endif
 }
 
@@ -0,0 +1,119 @@
+/***************************************************************
+ * This source files comes from the xLights project
+ * https://www.xlights.org
+ * https://github.com/smeighan/xLights
+ * See the github commit history for a record of contributing
+ * developers.
+ * Copyright claimed based on commit dates recorded in Github
+ * License: https://github.com/smeighan/xLights/blob/master/License.txt
+ **************************************************************/
+
+#include "RenderArena.h"
+
+#include <algorithm>
+#include <atomic>
+
+#include <log4cpp/Category.hh>
+
+#define ARENA_MIN_BLOCK_SIZE (1024 * 1024)
+
+// Totals are only added to from the per thread counts when an arena is reset so counting costs nothing
+// per allocation
+static std::atomic<uint64_t> __allocations(0);
+static std::atomic<uint64_t> __blockAllocations(0);
+static thread_local uint64_t __threadAllocations = 0;
+static thread_local uint64_t __threadBlockAllocations = 0;
+
+RenderArena& RenderArena::ForThread()
+{
+    static thread_local RenderArena arena;
+    return arena;
+}
+
+void* RenderArena::Allocate(size_t bytes, size_t align)
+{
+    ++__threadAllocations;
+    if (bytes == 0) {
+        bytes = 1;
+    }
+    for (;;) {
+        if (_current < _blocks.size()) {
+            uintptr_t base = reinterpret_cast<uintptr_t>(_blocks[_current].get());
+            uintptr_t p = (base + _offset + align - 1) & ~(uintptr_t)(align - 1);
+            if (p + bytes <= base + _blockSizes[_current]) {
+                _offset = p + bytes - base;
+                return reinterpret_cast<void*>(p);
+            }
+            if (_current + 1 < _blocks.size()) {
+                ++_current;
+                _offset = 0;
+                continue;
+            }
+        }
+        size_t size = std::max(bytes + align, (size_t)ARENA_MIN_BLOCK_SIZE);
+        if (!_blockSizes.empty()) {
+            size = std::max(size, _blockSizes.back() * 2);
+        }
+        _blocks.emplace_back(new uint8_t[size]);
+        _blockSizes.push_back(size);
+        ++__threadBlockAllocations;
+        _current = _blocks.size() - 1;
+        _offset = 0;
+    }
+}
+
+void RenderArena::Reset()
+{
+    if (_blocks.size() > 1) {
+        size_t total = 0;
+        for (const auto& s : _blockSizes) {
+            total += s;
+        }
+        _blocks.clear();
+        _blockSizes.clear();
+        _blocks.emplace_back(new uint8_t[total]);
+        _blockSizes.push_back(total);
+        ++__threadBlockAllocations;
+    }
+    _current = 0;
+    _offset = 0;
+    FlushCounts();
+}
+
+void RenderArena::Rewind(size_t block, size_t offset)
+{
+    _current = block;
+    _offset = offset;
+    if (block == 0 && offset == 0) {
+        // outermost scope on a thread that never resets
+        FlushCounts();
+    }
+}
+
+void RenderArena::FlushCounts()
+{
+    if (__threadAllocations != 0) {
+        __allocations += __threadAllocations;
+        __blockAllocations += __threadBlockAllocations;
+        __threadAllocations = 0;
+        __threadBlockAllocations = 0;
+    }
+}
+
+uint64_t RenderArena::GetAllocationCount()
+{
+    return __allocations;
+}
+
+uint64_t RenderArena::GetBlockAllocationCount()
+{
+    return __blockAllocations;
+}
+
+void RenderArena::LogStatistics()
+{
+    static log4cpp::Category& logger_render = log4cpp::Category::getInstance(std::string("log_render"));
+    if (logger_render.isDebugEnabled()) {
+        logger_render.debug("Render arena: %llu allocations, %llu heap blocks.", (unsigned long long)GetAllocationCount(), (unsigned long long)GetBlockAllocationCount());
+    }
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+/***************************************************************
+ * This source files comes from the xLights project
+ * https://www.xlights.org
+ * https://github.com/smeighan/xLights
+ * See the github commit history for a record of contributing
+ * developers.
+ * Copyright claimed based on commit dates recorded in Github
+ * License: https://github.com/smeighan/xLights/blob/master/License.txt
+ **************************************************************/
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+// Per thread bump allocator for temporary buffers needed while rendering a frame.
+//
+// Memory handed out is only valid until the enclosing Scope ends or the arena is reset, nothing is freed
+// individually and no destructors are run so it is only for trivially copyable types. The render thread
+// resets its arena after every frame. Code that may also run on other threads (eg inside a parallel_for)
+// must take a Scope so its allocations are released when it is done. Once the arena has grown to the
+// largest frame it sees it no longer allocates from the heap.
+class RenderArena
+{
+public:
+    class Scope
+    {
+    public:
+        Scope() : _arena(RenderArena::ForThread()), _block(_arena._current), _offset(_arena._offset) {}
+        ~Scope() { _arena.Rewind(_block, _offset); }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+        RenderArena& Arena() { return _arena; }
+
+    private:
+        RenderArena& _arena;
+        size_t _block;
+        size_t _offset;
+    };
+
+    static RenderArena& ForThread();
+
+    void* Allocate(size_t bytes, size_t align = alignof(std::max_align_t));
+
+    template<class T>
+    T* AllocateArray(size_t count)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "RenderArena does not run destructors");
+        return static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+    }
+
+    // Release everything allocated from the arena, merging the blocks so the next frame fits in one
+    void Reset();
+
+    static uint64_t GetAllocationCount();
+    static uint64_t GetBlockAllocationCount();
+    static void LogStatistics();
+
+private:
+    RenderArena() {}
+    void Rewind(size_t block, size_t offset);
+    static void FlushCounts();
+
+    std::vector<std::unique_ptr<uint8_t[]>> _blocks;
+    std::vector<size_t> _blockSizes;
+    size_t _current = 0;
+    size_t _offset = 0;
+};
@@ -25,6 +25,7 @@
 #include "models/DMX/DmxColorAbility.h"
 #include "GPURenderUtils.h"
 #include "BufferPanel.h"
+#include "RenderArena.h"
 
 #include <log4cpp/Category.hh>
 #include "Parallel.h"
@@ -1015,9 +1016,13 @@ void RenderBuffer::SetPixel(int x, int y, const HSVValue& hsv, bool wrap)
     }
 }
 
+RenderArena& RenderBuffer::GetArena() const {
+    return RenderArena::ForThread();
+}
+
 void RenderBuffer::SetNodePixel(int nodeNum, const xlColor &color, bool dmx_ignore) {
     if (nodeNum < Nodes.size()) {
-        for (auto &a : Nodes[nodeNum]->Coords) {
+        for (const auto& a : std::as_const(Nodes[nodeNum]->Coords)) {
             SetPixel(a.bufX, a.bufY, color, false, false, dmx_ignore);
         }
     }
@@ -1027,7 +1032,7 @@ void RenderBuffer::CopyNodeColorsToPixels(std::vector<bool> &done) {
     parallel_for(0, Nodes.size(), [&](int n) {
         xlColor c;
         Nodes[n]->GetColor(c);
-        for (auto &a : Nodes[n]->Coords) {
+        for (const auto& a : std::as_const(Nodes[n]->Coords)) {
             int x = a.bufX;
             int y = a.bufY;
             if (x >= 0 && x < BufferWi && y >= 0 && y < BufferHt && y*BufferWi + x < pixelVector.size()) {
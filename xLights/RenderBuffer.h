@@ -67,6 +67,7 @@ class Effect;
 class SettingsMap;
 class SequenceElements;
 class MetalRenderBufferComputeData;
+class RenderArena;
 
 
 class DrawingContext {
@@ -529,6 +530,9 @@ public:
     void CopyTempBufToPixels();
     void CopyPixelsToTempBuf();
     wxPoint GetMaxBuffer(const SettingsMap& SettingsMap) const;
+    // Scratch memory for the frame being rendered on this thread, take a RenderArena::Scope around anything
+    // allocated from it as effects also render outside the render threads
+    RenderArena& GetArena() const;
 
     PaletteClass palette;
     bool _nodeBuffer = false;
@@ -0,0 +1,163 @@
+/***************************************************************
+ * This source files comes from the xLights project
+ * https://www.xlights.org
+ * https://github.com/smeighan/xLights
+ * See the github commit history for a record of contributing
+ * developers.
+ * Copyright claimed based on commit dates recorded in Github
+ * License: https://github.com/smeighan/xLights/blob/master/License.txt
+ **************************************************************/
+
+#include "RenderCostEstimates.h"
+
+#include <wx/wx.h>
+#include <wx/file.h>
+#include <wx/filename.h>
+
+#include <algorithm>
+
+#include "sequencer/Effect.h"
+#include "sequencer/EffectLayer.h"
+#include "sequencer/Element.h"
+#include "ExternalHooks.h"
+
+#include <log4cpp/Category.hh>
+
+#define COST_EXTENSION "xrcost"
+#define COST_HEADER "XLRCOST 1"
+
+// share of the measured time carried over from earlier renders
+#define COST_HISTORY_WEIGHT 0.5
+
+std::string RenderCostEstimates::GetFileName(const std::string& xsqFile)
+{
+    wxFileName fn(xsqFile);
+    fn.SetExt(COST_EXTENSION);
+    return fn.GetFullPath().ToStdString();
+}
+
+bool RenderCostEstimates::Load(const std::string& xsqFile)
+{
+    _timePerFrame.clear();
+    if (xsqFile == "") return false;
+
+    std::string filename = GetFileName(xsqFile);
+    wxFile f;
+    if (!FileExists(filename, false) || !f.Open(filename)) return false;
+    wxString content;
+    if (!f.ReadAll(&content)) return false;
+    wxArrayString lines = wxSplit(content, '\n');
+    if (lines.empty() || lines[0] != COST_HEADER) return false;
+
+    // each line is the time per frame then a tab then the model name
+    for (size_t x = 1; x < lines.size(); x++) {
+        int tab = lines[x].Find('\t');
+        double ms;
+        if (tab > 0 && lines[x].Left(tab).ToCDouble(&ms)) {
+            _timePerFrame[lines[x].Mid(tab + 1).ToStdString()] = ms;
+        }
+    }
+    return true;
+}
+
+bool RenderCostEstimates::Save(const std::string& xsqFile) const
+{
+    static log4cpp::Category& logger_base = log4cpp::Category::getInstance(std::string("log_base"));
+
+    if (xsqFile == "" || _timePerFrame.empty()) return false;
+
+    std::string filename = GetFileName(xsqFile);
+    std::string content = COST_HEADER "\n";
+    for (const auto& it : _timePerFrame) {
+        content += wxString::FromCDouble(it.second, 4).ToStdString() + "\t" + it.first + "\n";
+    }
+    wxFile f;
+    if (!f.Create(filename, true) || f.Write(content.c_str(), content.size()) != content.size()) {
+        logger_base.warn("Unable to save render cost estimates to %s.", (const char*)filename.c_str());
+        return false;
+    }
+    return true;
+}
+
+double RenderCostEstimates::GetTimePerFrame(const std::string& model) const
+{
+    auto it = _timePerFrame.find(model);
+    if (it == _timePerFrame.end()) return -1;
+    return it->second;
+}
+
+void RenderCostEstimates::RecordTimePerFrame(const std::string& model, double ms)
+{
+    auto it = _timePerFrame.find(model);
+    if (it == _timePerFrame.end()) {
+        _timePerFrame[model] = ms;
+    } else {
+        it->second = it->second * COST_HISTORY_WEIGHT + ms * (1.0 - COST_HISTORY_WEIGHT);
+    }
+}
+
+double RenderCostEstimates::GetEffectWeight(const std::string& effectName)
+{
+    static const std::map<std::string, double> weights = {
+        { "Off", 0.1 },
+        { "On", 0.5 },
+        { "Color Wash", 0.5 },
+        { "Servo", 0.5 },
+        { "DMX", 0.5 },
+        { "Fire", 2.0 },
+        { "Kaleidoscope", 2.0 },
+        { "Morph", 2.0 },
+        { "Plasma", 2.0 },
+        { "Ripple", 2.0 },
+        { "Sketch", 2.0 },
+        { "Faces", 3.0 },
+        { "Pictures", 3.0 },
+        { "Text", 3.0 },
+        { "Tendril", 3.0 },
+        { "Warp", 3.0 },
+        { "Video", 4.0 },
+        { "Liquid", 6.0 },
+        { "Shader", 8.0 }
+    };
+    auto it = weights.find(effectName);
+    if (it == weights.end()) return 1.0;
+    return it->second;
+}
+
+static double EstimateLayerCost(EffectLayer* layer, int frameTime, int startFrame, int endFrame)
+{
+    if (layer == nullptr) return 0;
+
+    std::unique_lock<std::recursive_mutex> lock(layer->GetLock());
+    double cost = 0;
+    int startMS = startFrame * frameTime;
+    int endMS = (endFrame + 1) * frameTime;
+    for (int e = 0; e < layer->GetEffectCount(); ++e) {
+        Effect* ef = layer->GetEffect(e);
+        int s = std::max(ef->GetStartTimeMS(), startMS);
+        int en = std::min(ef->GetEndTimeMS(), endMS);
+        if (en > s && !ef->IsRenderDisabled()) {
+            cost += (double)(en - s) / frameTime * RenderCostEstimates::GetEffectWeight(ef->GetEffectName());
+        }
+    }
+    return cost;
+}
+
+double RenderCostEstimates::EstimateCost(ModelElement* element, int nodes, int frameTime, int startFrame, int endFrame)
+{
+    if (element == nullptr || frameTime <= 0) return 0;
+
+    // every frame is blended and copied to the sequence data even when nothing is rendered
+    double cost = (endFrame - startFrame + 1) * 0.1;
+    for (int l = 0; l < (int)element->GetEffectLayerCount(); ++l) {
+        cost += EstimateLayerCost(element->GetEffectLayer(l), frameTime, startFrame, endFrame);
+    }
+    // submodel, strand and node effects only cover part of the model but are counted at the full node count
+    for (int x = 0; x < element->GetSubModelAndStrandCount(); ++x) {
+        SubModelElement* se = element->GetSubModel(x);
+        for (int l = 0; l < (int)se->GetEffectLayerCount(); ++l) {
+            cost += EstimateLayerCost(se->GetEffectLayer(l), frameTime, startFrame, endFrame);
+        }
+    }
+    return cost * std::max(nodes, 1);
+}
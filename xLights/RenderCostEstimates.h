@@ -0,0 +1,43 @@
+#pragma once
+
+/***************************************************************
+ * This source files comes from the xLights project
+ * https://www.xlights.org
+ * https://github.com/smeighan/xLights
+ * See the github commit history for a record of contributing
+ * developers.
+ * Copyright claimed based on commit dates recorded in Github
+ * License: https://github.com/smeighan/xLights/blob/master/License.txt
+ **************************************************************/
+
+#include <map>
+#include <string>
+
+class ModelElement;
+
+// Estimates of how long each model of a sequence takes to render, used to start the models on the longest
+// chain of dependent models first.
+//
+// Before a model has been rendered the estimate is nodes x frames x a weight for each effect type. Once it
+// has been rendered the measured time per frame is saved in a file next to the sequence and used instead.
+class RenderCostEstimates
+{
+public:
+    static std::string GetFileName(const std::string& xsqFile);
+
+    bool Load(const std::string& xsqFile);
+    bool Save(const std::string& xsqFile) const;
+
+    // Measured render time per frame in ms or a negative value if the model has not been rendered
+    double GetTimePerFrame(const std::string& model) const;
+    void RecordTimePerFrame(const std::string& model, double ms);
+
+    // Relative cost of rendering the effects of a model element over a range of frames
+    static double EstimateCost(ModelElement* element, int nodes, int frameTime, int startFrame, int endFrame);
+
+    // Cost of rendering one frame of an effect on one node relative to a simple fill
+    static double GetEffectWeight(const std::string& effectName);
+
+private:
+    std::map<std::string, double> _timePerFrame;
+};
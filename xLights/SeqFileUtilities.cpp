@@ -675,8 +675,21 @@ bool xLightsFrame::SeqLoadXlightsFile(xLightsXmlFile& xml_file, bool ChooseModel
 void xLightsFrame::ClearSequenceData()
 {
     wxASSERT(_seqData.IsValidData());
-    for (size_t i = 0; i < _seqData.NumFrames(); ++i)
-        _seqData[i].Zero();
+    if (_seqData.NumFrames() > 0) {
+        _seqData.ReleaseFrames(0, _seqData.NumFrames() - 1);
+    }
+}
+
+bool xLightsFrame::HasIseqLayersAboveEffects()
+{
+    // layers are ordered top down so anything before the Nutcracker layer is rendered over the effects
+    DataLayerSet& data_layers = CurrentSeqXmlFile->GetDataLayers();
+    for (int i = 0; i < data_layers.GetNumLayers(); ++i) {
+        if (data_layers.GetDataLayer(i)->GetName() == "Nutcracker") {
+            return i > 0;
+        }
+    }
+    return false;
 }
 
 void xLightsFrame::RenderIseqData(bool bottom_layers, ConvertLogDialog* plog)
@@ -29,6 +29,7 @@ static const size_t MAX_BLOCK_SIZE = 1024 * 1024 * 1024;
 #ifdef USE_MMAP_BLOCKS
 std::list<std::unique_ptr<SequenceData::DataBlock>> SequenceData::HUGE_BLOCK_CACHE;
 #include <thread>
+#include <unistd.h>
 // OSX/Linux allows 2MB huge pages (or Superpages as they call them on OSX)
 static const size_t LARGE_PAGE_SIZE = 2 * 1024 * 1024;
 static bool firstSeq = true;
@@ -314,6 +315,58 @@ void SequenceData::init(unsigned int numChannels, unsigned int numFrames, unsign
     _invalidFrame._numChannels = _numChannels;
 }
 
+void SequenceData::ReleaseFrames(unsigned int start, unsigned int end)
+{
+    if (_frames.empty()) return;
+    if (end >= _numFrames) end = _numFrames - 1;
+    if (start > end) return;
+
+#ifdef USE_MMAP_BLOCKS
+    static const uintptr_t pageSize = sysconf(_SC_PAGESIZE);
+#endif
+    unsigned int frame = start;
+    while (frame <= end) {
+        unsigned char* first = _frames[frame]._data;
+        DataBlock* block = nullptr;
+        for (const auto& b : _dataBlocks) {
+            if (first >= b->data && first < b->data + b->size) {
+                block = b.get();
+                break;
+            }
+        }
+        if (block == nullptr) {
+            _frames[frame].Zero();
+            ++frame;
+            continue;
+        }
+        // frames within a block are contiguous
+        unsigned int last = frame;
+        while (last < end && _frames[last + 1]._data == _frames[last]._data + _bytesPerFrame &&
+               _frames[last + 1]._data + _bytesPerFrame <= block->data + block->size) {
+            ++last;
+        }
+        size_t len = (size_t)(last - frame + 1) * _bytesPerFrame;
+        bool released = false;
+#ifdef USE_MMAP_BLOCKS
+        if (block->type == BlockType::NORMAL) {
+            uintptr_t s = ((uintptr_t)first + pageSize - 1) & ~(pageSize - 1);
+            uintptr_t e = ((uintptr_t)first + len) & ~(pageSize - 1);
+            // map fresh zero pages over the whole pages, the partial pages at the ends still belong to
+            // frames outside the range so only the bytes inside it are cleared
+            if (e > s && mmap((void*)s, e - s, PROT_READ | PROT_WRITE, MAP_ANON | MAP_PRIVATE | MAP_FIXED, -1, 0) != MAP_FAILED) {
+                memset(first, 0, s - (uintptr_t)first);
+                memset((void*)e, 0, (uintptr_t)first + len - e);
+                released = true;
+            }
+        }
+#endif
+        if (!released) {
+            memset(first, 0, len);
+        }
+        frame = last + 1;
+    }
+}
+
 // This encodes the sequence data grouped by channel
 wxString SequenceData::base64_encode()
 {
@@ -124,6 +124,10 @@ public:
     unsigned int FrameTime() const { return _frameTime;}
     bool IsValidData() const { return !_dataBlocks.empty(); }
 
+    // zero the frames from start to end inclusive. Whole pages of mmap'd memory are handed back to the
+    // system rather than written so frames that are not needed any more stop using memory
+    void ReleaseFrames(unsigned int start, unsigned int end);
+
     // encodes contents of SeqData in channel order
     wxString base64_encode();
 };
@@ -0,0 +1,423 @@
+/***************************************************************
+ * This source files comes from the xLights project
+ * https://www.xlights.org
+ * https://github.com/smeighan/xLights
+ * See the github commit history for a record of contributing
+ * developers.
+ * Copyright claimed based on commit dates recorded in Github
+ * License: https://github.com/smeighan/xLights/blob/master/License.txt
+ **************************************************************/
+
+#include "SequenceSidecar.h"
+
+#include <wx/wx.h>
+#include <wx/file.h>
+#include <wx/filename.h>
+#include <wx/xml/xml.h>
+#include <wx/mstream.h>
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "../xSchedule/md5.h"
+#include "ExternalHooks.h"
+
+#include <log4cpp/Category.hh>
+
+#define SIDECAR_VERSION 2
+#define SIDECAR_EXTENSION "xsqb"
+#define SIDECAR_HASH_CHUNK (1024 * 1024)
+
+static const char SIDECAR_MAGIC[8] = { 'X', 'L', 'S', 'Q', 'B', 'I', 'N', '\0' };
+
+// Each node is stored as NODE_WORDS uint32 values followed by a key and value string index per attribute.
+// Children follow their parent directly.
+#define NODE_WORDS 5
+
+struct SidecarHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t headerSize;
+    uint64_t xsqSize;
+    int64_t xsqModified;        // ms since the epoch
+    char xsqHash[40];
+    uint32_t stringCount;
+    uint32_t docVersion;       // string index
+    uint32_t docEncoding;      // string index
+    uint32_t reserved;
+    uint64_t stringIndexOffset; // stringCount + 1 uint32 offsets into the string data
+    uint64_t stringDataOffset;
+    uint64_t stringDataSize;
+    uint64_t nodeOffset;
+    uint64_t nodeWords;
+};
+
+bool SequenceSidecar::__enabled = true;
+
+// background writes ... the latest content saved for each xsq waiting to be written
+static std::mutex __pendingLock;
+static std::map<std::string, std::string> __pending;
+static std::mutex __writeLock;
+
+namespace
+{
+    class StringTableWriter
+    {
+        std::unordered_map<std::string, uint32_t> _index;
+
+    public:
+        std::vector<std::string> strings;
+
+        StringTableWriter()
+        {
+            Add(std::string());
+        }
+
+        uint32_t Add(const std::string& s)
+        {
+            auto it = _index.find(s);
+            if (it != _index.end()) {
+                return it->second;
+            }
+            uint32_t idx = strings.size();
+            strings.push_back(s);
+            _index[s] = idx;
+            return idx;
+        }
+
+        uint32_t Add(const wxString& s)
+        {
+            if (s.empty()) return 0;
+            const wxScopedCharBuffer buf = s.utf8_str();
+            return Add(std::string(buf.data(), buf.length()));
+        }
+    };
+
+    bool IsSupportedNode(wxXmlNodeType type)
+    {
+        return type == wxXML_ELEMENT_NODE || type == wxXML_TEXT_NODE || type == wxXML_CDATA_SECTION_NODE || type == wxXML_COMMENT_NODE;
+    }
+
+    void WriteNode(const wxXmlNode* node, StringTableWriter& strings, std::vector<uint32_t>& words)
+    {
+        uint32_t attrCount = 0;
+        for (auto a = node->GetAttributes(); a != nullptr; a = a->GetNext()) {
+            attrCount++;
+        }
+        uint32_t childCount = 0;
+        for (auto c = node->GetChildren(); c != nullptr; c = c->GetNext()) {
+            if (IsSupportedNode(c->GetType())) childCount++;
+        }
+
+        words.push_back(node->GetType());
+        words.push_back(strings.Add(node->GetName()));
+        words.push_back(strings.Add(node->GetContent()));
+        words.push_back(attrCount);
+        words.push_back(childCount);
+        for (auto a = node->GetAttributes(); a != nullptr; a = a->GetNext()) {
+            words.push_back(strings.Add(a->GetName()));
+            words.push_back(strings.Add(a->GetValue()));
+        }
+        for (auto c = node->GetChildren(); c != nullptr; c = c->GetNext()) {
+            if (IsSupportedNode(c->GetType())) {
+                WriteNode(c, strings, words);
+            }
+        }
+    }
+
+    wxXmlNode* ReadNode(const uint32_t* words, size_t count, size_t& pos, const std::vector<wxString>& strings)
+    {
+        if (pos + NODE_WORDS > count) return nullptr;
+
+        wxXmlNodeType type = (wxXmlNodeType)words[pos];
+        uint32_t name = words[pos + 1];
+        uint32_t content = words[pos + 2];
+        uint32_t attrCount = words[pos + 3];
+        uint32_t childCount = words[pos + 4];
+        pos += NODE_WORDS;
+
+        if (!IsSupportedNode(type) || name >= strings.size() || content >= strings.size()) return nullptr;
+        if (attrCount > (count - pos) / 2) return nullptr;
+
+        wxXmlNode* node = new wxXmlNode(type, strings[name], strings[content]);
+        for (uint32_t i = 0; i < attrCount; i++) {
+            uint32_t k = words[pos++];
+            uint32_t v = words[pos++];
+            if (k >= strings.size() || v >= strings.size()) {
+                delete node;
+                return nullptr;
+            }
+            node->AddAttribute(strings[k], strings[v]);
+        }
+
+        // AddChild walks the whole child list so append after the last child we added
+        wxXmlNode* last = nullptr;
+        for (uint32_t i = 0; i < childCount; i++) {
+            wxXmlNode* child = ReadNode(words, count, pos, strings);
+            if (child == nullptr) {
+                delete node;
+                return nullptr;
+            }
+            if (last == nullptr) {
+                node->AddChild(child);
+            } else {
+                node->InsertChildAfter(child, last);
+            }
+            last = child;
+        }
+        return node;
+    }
+}
+
+std::string SequenceSidecar::GetSidecarFileName(const std::string& xsqFile)
+{
+    wxFileName fn(xsqFile);
+    fn.SetExt(SIDECAR_EXTENSION);
+    return fn.GetFullPath().ToStdString();
+}
+
+int64_t SequenceSidecar::GetModified(const std::string& file)
+{
+    wxFileName fn(file);
+    if (!fn.FileExists()) return 0;
+    return fn.GetModificationTime().GetValue().GetValue();
+}
+
+std::string SequenceSidecar::HashData(const void* data, size_t size)
+{
+    MD5 md5;
+    const char* p = (const char*)data;
+    while (size > 0) {
+        size_t chunk = std::min(size, (size_t)SIDECAR_HASH_CHUNK);
+        md5.update(p, (MD5::size_type)chunk);
+        p += chunk;
+        size -= chunk;
+    }
+    md5.finalize();
+    return md5.hexdigest();
+}
+
+std::string SequenceSidecar::HashFile(const std::string& file, uint64_t& size)
+{
+    size = 0;
+    wxFile f;
+    if (!f.Open(file)) return "";
+
+    MD5 md5;
+    std::vector<char> buf(SIDECAR_HASH_CHUNK);
+    ssize_t got = 0;
+    while ((got = f.Read(buf.data(), buf.size())) > 0) {
+        md5.update(buf.data(), (MD5::size_type)got);
+        size += got;
+    }
+    if (got == wxInvalidOffset) return "";
+    md5.finalize();
+    return md5.hexdigest();
+}
+
+bool SequenceSidecar::Load(const std::string& xsqFile, wxXmlDocument& doc)
+{
+    static log4cpp::Category& logger_base = log4cpp::Category::getInstance(std::string("log_base"));
+
+    if (!__enabled) return false;
+
+    std::string filename = GetSidecarFileName(xsqFile);
+    if (!FileExists(filename, false)) return false;
+
+    wxFile file;
+    if (!file.Open(filename)) return false;
+    wxFileOffset length = file.Length();
+    if (length < (wxFileOffset)sizeof(SidecarHeader)) return false;
+
+    std::vector<uint8_t> data(length);
+    if (file.Read(data.data(), length) != length) return false;
+    file.Close();
+
+    SidecarHeader header;
+    memcpy(&header, data.data(), sizeof(header));
+    if (memcmp(header.magic, SIDECAR_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != SIDECAR_VERSION ||
+        header.headerSize != sizeof(SidecarHeader)) {
+        logger_base.debug("SequenceSidecar: %s is not a usable sidecar.", (const char*)filename.c_str());
+        return false;
+    }
+
+    // only use it if it was written from exactly this xsq ... the size and time almost always settle it so the
+    // xsq is only hashed when it has the same size but a different time, for example after being copied
+    wxFileName fn(xsqFile);
+    if ((uint64_t)fn.GetSize().GetValue() != header.xsqSize) {
+        logger_base.debug("SequenceSidecar: %s is out of date.", (const char*)filename.c_str());
+        return false;
+    }
+    if (GetModified(xsqFile) != header.xsqModified) {
+        uint64_t xsqSize = 0;
+        std::string hash = HashFile(xsqFile, xsqSize);
+        if (xsqSize != header.xsqSize || hash != std::string(header.xsqHash, strnlen(header.xsqHash, sizeof(header.xsqHash)))) {
+            logger_base.debug("SequenceSidecar: %s is out of date.", (const char*)filename.c_str());
+            return false;
+        }
+    }
+
+    uint64_t len = length;
+    if (header.stringIndexOffset + ((uint64_t)header.stringCount + 1) * sizeof(uint32_t) > len ||
+        header.stringDataOffset + header.stringDataSize > len ||
+        header.nodeOffset + header.nodeWords * sizeof(uint32_t) > len ||
+        header.stringCount == 0 ||
+        header.docVersion >= header.stringCount ||
+        header.docEncoding >= header.stringCount) {
+        logger_base.warn("SequenceSidecar: %s is corrupt.", (const char*)filename.c_str());
+        return false;
+    }
+
+    const uint32_t* stringIndex = (const uint32_t*)(data.data() + header.stringIndexOffset);
+    const char* stringData = (const char*)(data.data() + header.stringDataOffset);
+    std::vector<wxString> strings;
+    strings.reserve(header.stringCount);
+    for (uint32_t i = 0; i < header.stringCount; i++) {
+        uint32_t start = stringIndex[i];
+        uint32_t end = stringIndex[i + 1];
+        if (start > end || end > header.stringDataSize) {
+            logger_base.warn("SequenceSidecar: %s has a corrupt string table.", (const char*)filename.c_str());
+            return false;
+        }
+        strings.push_back(wxString::FromUTF8(stringData + start, end - start));
+    }
+
+    size_t pos = 0;
+    wxXmlNode* root = ReadNode((const uint32_t*)(data.data() + header.nodeOffset), header.nodeWords, pos, strings);
+    if (root == nullptr || pos != header.nodeWords) {
+        logger_base.warn("SequenceSidecar: %s has corrupt nodes.", (const char*)filename.c_str());
+        delete root;
+        return false;
+    }
+
+    doc.SetRoot(root);
+    doc.SetVersion(strings[header.docVersion]);
+    doc.SetFileEncoding(strings[header.docEncoding]);
+    logger_base.debug("SequenceSidecar: Loaded %s.", (const char*)filename.c_str());
+    return true;
+}
+
+bool SequenceSidecar::Save(const std::string& xsqFile, const wxXmlDocument& doc, const void* xsqData, size_t xsqSize)
+{
+    static log4cpp::Category& logger_base = log4cpp::Category::getInstance(std::string("log_base"));
+
+    if (!__enabled || doc.GetRoot() == nullptr) return false;
+
+    StringTableWriter strings;
+    std::vector<uint32_t> words;
+    WriteNode(doc.GetRoot(), strings, words);
+
+    SidecarHeader header;
+    memset(&header, 0x00, sizeof(header));
+    memcpy(header.magic, SIDECAR_MAGIC, sizeof(header.magic));
+    header.version = SIDECAR_VERSION;
+    header.headerSize = sizeof(SidecarHeader);
+    header.xsqSize = xsqSize;
+    header.xsqModified = GetModified(xsqFile);
+    std::string hash = HashData(xsqData, xsqSize);
+    strncpy(header.xsqHash, hash.c_str(), sizeof(header.xsqHash) - 1);
+    header.docVersion = strings.Add(doc.GetVersion());
+    header.docEncoding = strings.Add(doc.GetFileEncoding());
+    header.stringCount = strings.strings.size();
+
+    std::vector<uint32_t> stringIndex;
+    stringIndex.reserve(strings.strings.size() + 1);
+    uint64_t stringDataSize = 0;
+    for (const auto& it : strings.strings) {
+        stringIndex.push_back(stringDataSize);
+        stringDataSize += it.size();
+    }
+    stringIndex.push_back(stringDataSize);
+    if (stringDataSize > UINT32_MAX) {
+        logger_base.warn("SequenceSidecar: Sequence too large for a sidecar.");
+        return false;
+    }
+
+    // keep the node records 4 byte aligned so they can be used in place
+    uint32_t padding = (4 - (stringDataSize % 4)) % 4;
+    header.stringIndexOffset = sizeof(SidecarHeader);
+    header.stringDataOffset = header.stringIndexOffset + stringIndex.size() * sizeof(uint32_t);
+    header.stringDataSize = stringDataSize;
+    header.nodeOffset = header.stringDataOffset + stringDataSize + padding;
+    header.nodeWords = words.size();
+
+    std::string filename = GetSidecarFileName(xsqFile);
+    std::string tmp = filename + ".tmp";
+    wxFile file;
+    if (!file.Create(tmp, true)) {
+        logger_base.warn("SequenceSidecar: Unable to create %s.", (const char*)tmp.c_str());
+        return false;
+    }
+
+    bool ok = file.Write(&header, sizeof(header)) == sizeof(header) &&
+              file.Write(stringIndex.data(), stringIndex.size() * sizeof(uint32_t)) == stringIndex.size() * sizeof(uint32_t);
+    for (const auto& it : strings.strings) {
+        if (!ok) break;
+        ok = it.empty() || file.Write(it.data(), it.size()) == it.size();
+    }
+    uint32_t zero = 0;
+    ok = ok && (padding == 0 || file.Write(&zero, padding) == padding);
+    ok = ok && file.Write(words.data(), words.size() * sizeof(uint32_t)) == words.size() * sizeof(uint32_t);
+    file.Close();
+
+    if (!ok || !wxRenameFile(tmp, filename, true)) {
+        logger_base.warn("SequenceSidecar: Error writing %s.", (const char*)filename.c_str());
+        wxRemoveFile(tmp);
+        return false;
+    }
+    return true;
+}
+
+void SequenceSidecar::SaveInBackground(const std::string& xsqFile, std::string&& xsqContent)
+{
+    if (!__enabled) return;
+
+    {
+        std::unique_lock<std::mutex> lock(__pendingLock);
+        auto it = __pending.find(xsqFile);
+        if (it != __pending.end()) {
+            // a thread is already waiting to write this file so it will pick up this content instead
+            it->second = std::move(xsqContent);
+            return;
+        }
+        __pending[xsqFile] = std::move(xsqContent);
+    }
+
+    std::thread([xsqFile]() {
+        static log4cpp::Category& logger_base = log4cpp::Category::getInstance(std::string("log_base"));
+
+        // one sidecar at a time ... they are rarely needed in a hurry
+        std::unique_lock<std::mutex> writeLock(__writeLock);
+
+        std::string content;
+        {
+            std::unique_lock<std::mutex> lock(__pendingLock);
+            auto it = __pending.find(xsqFile);
+            if (it == __pending.end()) return;
+            content = std::move(it->second);
+            __pending.erase(it);
+        }
+
+        wxMemoryInputStream in(content.data(), content.size());
+        wxXmlDocument doc;
+        if (!doc.Load(in) || !Save(xsqFile, doc, content.data(), content.size())) {
+            logger_base.debug("SequenceSidecar: No sidecar written for %s.", (const char*)xsqFile.c_str());
+            Remove(xsqFile);
+        }
+    }).detach();
+}
+
+void SequenceSidecar::Remove(const std::string& xsqFile)
+{
+    std::string filename = GetSidecarFileName(xsqFile);
+    if (FileExists(filename, false)) {
+        wxRemoveFile(filename);
+    }
+}
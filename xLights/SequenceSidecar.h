@@ -0,0 +1,55 @@
+#pragma once
+
+/***************************************************************
+ * This source files comes from the xLights project
+ * https://www.xlights.org
+ * https://github.com/smeighan/xLights
+ * See the github commit history for a record of contributing
+ * developers.
+ * Copyright claimed based on commit dates recorded in Github
+ * License: https://github.com/smeighan/xLights/blob/master/License.txt
+ **************************************************************/
+
+#include <cstdint>
+#include <string>
+
+class wxXmlDocument;
+
+// Binary copy of a sequence saved alongside the .xsq.
+//
+// The .xsq remains the interchange format. The sidecar holds the same document with every distinct string
+// (names, attributes, effect settings and palettes) stored once in a string table and the nodes stored as
+// fixed size records in document order so effects stay sorted by element, layer and time. All offsets are
+// from the start of the file. It is only used when the .xsq being loaded is the one it was written from.
+//
+// Loading from the sidecar still builds the same wxXmlDocument as loading the .xsq ... it saves the XML parsing
+// but not the cost of building the document or of loading the effects from it. Saving is no faster, the sidecar
+// is written afterwards on a background thread from a copy of the saved xml so the save itself costs no more.
+// Autosave .xbkp files never get a sidecar.
+class SequenceSidecar
+{
+public:
+    static void SetEnabled(bool enabled) { __enabled = enabled; }
+    static bool IsEnabled() { return __enabled; }
+
+    static std::string GetSidecarFileName(const std::string& xsqFile);
+
+    // Load the document from the sidecar if it is current for the xsq file
+    static bool Load(const std::string& xsqFile, wxXmlDocument& doc);
+
+    // Write the sidecar for a document just saved to xsqFile with the given content
+    static bool Save(const std::string& xsqFile, const wxXmlDocument& doc, const void* xsqData, size_t xsqSize);
+
+    // Write the sidecar on a background thread from the content just saved to xsqFile. If the file is saved
+    // again before that thread gets to it only the latest content is written.
+    static void SaveInBackground(const std::string& xsqFile, std::string&& xsqContent);
+
+    static void Remove(const std::string& xsqFile);
+
+private:
+    static int64_t GetModified(const std::string& file);
+    static std::string HashData(const void* data, size_t size);
+    static std::string HashFile(const std::string& file, uint64_t& size);
+
+    static bool __enabled;
+};
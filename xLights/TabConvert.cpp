@@ -1416,6 +1416,46 @@ static void addRanges(Model* m, std::map<uint32_t, uint32_t>& ranges)
     }
 }
 
+void xLightsFrame::GetFalconPiFileRanges(std::vector<std::pair<uint32_t, uint32_t>>& ranges)
+{
+    std::map<uint32_t, uint32_t> modelRanges;
+    int numElements = _sequenceElements.GetElementCount();
+    for (int i = 0; i < numElements; ++i) {
+        Element* element = _sequenceElements.GetElement(i);
+        if (element->GetType() == ElementType::ELEMENT_TYPE_MODEL) {
+            std::string modelName = element->GetModelName();
+            Model* m = this->GetModel(modelName);
+            addRanges(m, modelRanges);
+        }
+    }
+
+    uint32_t gapEliminate = 0; // set if we want to eliminate gaps
+    std::pair<uint32_t, uint32_t> cur(INT_MAX, INT_MAX);
+    for (auto& a : modelRanges) {
+        if (cur.first == INT_MAX) {
+            cur.first = a.first;
+            cur.second = a.second;
+        } else {
+            if (a.first <= (cur.first + cur.second + gapEliminate)) {
+                // overlap or within 1025 channels of an overlap, need to combine
+                // if the two ranges are "close" (wthin 1025 channels) we'll combine
+                // as the overhead of doing ranges wouldn't benefit with a small gap
+                uint32_t max = cur.first + cur.second - 1;
+                uint32_t amax = a.first + a.second - 1;
+                max = std::max(max, amax);
+                cur.second = max - cur.first + 1;
+            } else {
+                ranges.push_back(cur);
+                cur.first = a.first;
+                cur.second = a.second;
+            }
+        }
+    }
+    if (cur.first != INT_MAX) {
+        ranges.push_back(cur);
+    }
+}
+
 void xLightsFrame::WriteFalconPiFile(const wxString& filename, bool allowSparse)
 {
     ConvertParameters write_params(filename,                               // filename
@@ -1430,43 +1470,28 @@ void xLightsFrame::WriteFalconPiFile(const wxString& filename, bool allowSparse)
                                    filename);
 
     if (allowSparse) {
-        std::map<uint32_t, uint32_t> ranges;
-        int numElements = _sequenceElements.GetElementCount();
-        for (int i = 0; i < numElements; ++i) {
-            Element* element = _sequenceElements.GetElement(i);
-            if (element->GetType() == ElementType::ELEMENT_TYPE_MODEL) {
-                std::string modelName = element->GetModelName();
-                Model* m = this->GetModel(modelName);
-                addRanges(m, ranges);
-            }
-        }
-
-        uint32_t gapEliminate = 0; // set if we want to eliminate gaps
-        std::pair<uint32_t, uint32_t> cur(INT_MAX, INT_MAX);
-        for (auto& a : ranges) {
-            if (cur.first == INT_MAX) {
-                cur.first = a.first;
-                cur.second = a.second;
-            } else {
-                if (a.first <= (cur.first + cur.second + gapEliminate)) {
-                    // overlap or within 1025 channels of an overlap, need to combine
-                    // if the two ranges are "close" (wthin 1025 channels) we'll combine
-                    // as the overhead of doing ranges wouldn't benefit with a small gap
-                    uint32_t max = cur.first + cur.second - 1;
-                    uint32_t amax = a.first + a.second - 1;
-                    max = std::max(max, amax);
-                    cur.second = max - cur.first + 1;
-                } else {
-                    write_params.ranges.push_back(cur);
-                    cur.first = a.first;
-                    cur.second = a.second;
-                }
-            }
-        }
-        if (cur.first != INT_MAX) {
-            write_params.ranges.push_back(cur);
-        }
+        GetFalconPiFileRanges(write_params.ranges);
     }
 
     FileConverter::WriteFalconPiFile(write_params);
 }
+
+FSEQFile* xLightsFrame::CreateFalconPiFile(const wxString& filename, bool allowSparse)
+{
+    ConvertParameters write_params(filename,                               // filename
+                                   _seqData,                               // sequence data object
+                                   &_outputManager,                        // global network info
+                                   ConvertParameters::READ_MODE_LOAD_MAIN, // file read mode
+                                   this,                                   // xLights main frame
+                                   nullptr,
+                                   nullptr,
+                                   &mediaFilename, // media filename
+                                   nullptr,
+                                   filename);
+
+    if (allowSparse) {
+        GetFalconPiFileRanges(write_params.ranges);
+    }
+
+    return FileConverter::CreateFalconPiFile(write_params);
+}
@@ -39,6 +39,9 @@
 #include "ColoursPanel.h"
 #include "sequencer/MainSequencer.h"
 #include "HousePreviewPanel.h"
+#include "AudioAnalysisCache.h"
+#include "controllers/FPP.h"
+#include "FSEQStreamWriter.h"
 #include "ExternalHooks.h"
 
 #include "xLightsVersion.h"
@@ -320,6 +323,8 @@ wxString xLightsFrame::LoadEffectsFileNoCheck()
         SetXmlSetting("renderCacheDir", showDirectory);
         UnsavedRgbEffectsChanges = true;
     }
+    AudioAnalysisCache::SetCacheFolder(renderCacheDirectory + wxFileName::GetPathSeparator() + "AudioCache");
+    FPP::SetUploadManifestFolder(renderCacheDirectory + wxFileName::GetPathSeparator() + "FPPUploads");
 
     mStoredLayoutGroup = GetXmlSetting("storedLayoutGroup", "Default");
 
@@ -1200,7 +1205,17 @@ void xLightsFrame::OpenRenderAndSaveSequences(const wxArrayString &origFilenames
     RenderIseqData(true, nullptr); // render ISEQ layers below the Nutcracker layer
     logger_base.info("   iseq below effects done.");
     ProgressBar->SetValue(10);
-    RenderGridToSeqData([this, sw, fileNames, exitOnDone] {
+
+    // frames can only be written as they render if nothing is layered on top of the effects afterwards
+    FSEQStreamWriter* streamWriter = nullptr;
+    if (_streamBatchRender && !HasIseqLayersAboveEffects()) {
+        FSEQFile* file = CreateFalconPiFile(xlightsFilename);
+        if (file != nullptr) {
+            logger_base.info("Streaming fseq file while rendering.");
+            streamWriter = new FSEQStreamWriter(file, _seqData, true);
+        }
+    }
+    RenderGridToSeqData([this, sw, fileNames, exitOnDone, streamWriter] {
         static log4cpp::Category &logger_base = log4cpp::Category::getInstance(std::string("log_base"));
         logger_base.info("   Effects done.");
         ProgressBar->SetValue(90);
@@ -1214,7 +1229,12 @@ void xLightsFrame::OpenRenderAndSaveSequences(const wxArrayString &origFilenames
 
         logger_base.info("Saving fseq file.");
         SetStatusText(_("Saving ") + xlightsFilename + _(" ... Writing fseq."));
-        WriteFalconPiFile(xlightsFilename);
+        if (streamWriter != nullptr) {
+            streamWriter->Finish();
+            delete streamWriter;
+        } else {
+            WriteFalconPiFile(xlightsFilename);
+        }
         logger_base.info("fseq file done.");
         DisplayXlightsFilename(xlightsFilename);
         float elapsedTime = sw.Time()/1000.0; // now stop stopwatch timer and get elapsed time. change into seconds from ms
@@ -1225,7 +1245,7 @@ void xLightsFrame::OpenRenderAndSaveSequences(const wxArrayString &origFilenames
         mLastAutosaveCount = mSavedChangeCount;
 
         CallAfter(&xLightsFrame::OpenRenderAndSaveSequences, fileNames, exitOnDone);
-    } );
+    }, streamWriter);
 }
 
 void xLightsFrame::SaveSequence()
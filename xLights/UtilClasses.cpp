@@ -2,38 +2,129 @@
 #include "effects/RenderableEffect.h"
 #include "effects/EffectManager.h"
 
+std::mutex StringIntern::__lock;
+std::unordered_map<std::string_view, std::shared_ptr<const std::string>> StringIntern::__strings;
+
+std::shared_ptr<const std::string> StringIntern::Intern(const std::string& str)
+{
+    std::unique_lock<std::mutex> lock(__lock);
+    auto it = __strings.find(str);
+    if (it != __strings.end()) {
+        return it->second;
+    }
+    auto s = std::make_shared<const std::string>(str);
+    // the key views the string the table owns so it lives as long as the entry
+    __strings.emplace(std::string_view(*s), s);
+    return s;
+}
+
+std::shared_ptr<const std::string> StringIntern::Intern(std::string&& str)
+{
+    std::unique_lock<std::mutex> lock(__lock);
+    auto it = __strings.find(str);
+    if (it != __strings.end()) {
+        return it->second;
+    }
+    auto s = std::make_shared<const std::string>(std::move(str));
+    __strings.emplace(std::string_view(*s), s);
+    return s;
+}
+
+void StringIntern::Purge()
+{
+    std::unique_lock<std::mutex> lock(__lock);
+    // only the table holds these and nothing can take a new reference without the lock
+    for (auto it = __strings.begin(); it != __strings.end();) {
+        if (it->second.use_count() == 1) {
+            it = __strings.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+size_t StringIntern::GetCount()
+{
+    std::unique_lock<std::mutex> lock(__lock);
+    return __strings.size();
+}
+
+std::shared_mutex SettingKey::__lock;
+std::unordered_map<std::string_view, const std::string*> SettingKey::__index;
+std::deque<std::string> SettingKey::__keys;
+
+const std::string* SettingKey::Intern(std::string_view key)
+{
+    {
+        std::shared_lock<std::shared_mutex> lock(__lock);
+        auto it = __index.find(key);
+        if (it != __index.end()) {
+            return it->second;
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(__lock);
+    auto it = __index.find(key);
+    if (it != __index.end()) {
+        return it->second;
+    }
+    // keys are never released and a deque never moves its elements so the pointers stay valid
+    const std::string* s = &__keys.emplace_back(key);
+    __index.emplace(std::string_view(*s), s);
+    return s;
+}
+
+size_t SettingKey::GetCount()
+{
+    std::shared_lock<std::shared_mutex> lock(__lock);
+    return __keys.size();
+}
+
+static bool ContainsEscapes(const std::string& value)
+{
+    return value.find('&') != std::string::npos;
+}
+
 void MapStringString::ParseJson(EffectManager* effectManager, const std::string& str, const std::string& effectName)
 {
     clear();
-    std::string before, after, name, value;
-    std::string settings(str);
-    ReplaceAll(settings, "{", "");
-    ReplaceAll(settings, "}", "");
-    while (!settings.empty()) {
-        size_t start_pos = settings.find(',');
-        if (start_pos != std::string::npos) {
-            before = settings.substr(0, start_pos);
-            settings = settings.substr(start_pos + 1);
-        } else {
-            before = settings;
-            settings = "";
+    std::string name, value;
+    size_t len = str.size();
+    size_t start = 0;
+    while (start < len) {
+        size_t stop = str.find(',', start);
+        if (stop == std::string::npos) {
+            stop = len;
+        }
+
+        // braces and quotes carry no meaning within an entry
+        std::string before;
+        before.reserve(stop - start);
+        for (size_t i = start; i < stop; ++i) {
+            char c = str[i];
+            if (c != '{' && c != '}' && c != '"') {
+                before += c;
+            }
         }
+        start = stop + 1;
+        if (before.empty()) continue;
 
-        start_pos = before.find(':');
-        name = before.substr(0, start_pos);
-        value = before.substr(start_pos + 1);
-        ReplaceAll(name, "\"", "");
-        ReplaceAll(value, "\"", "");
+        size_t sep = before.find(':');
+        name = before.substr(0, sep);
+        value = before.substr(sep == std::string::npos ? 0 : sep + 1);
         Trim(name);
         Trim(value);
-        ReplaceAll(value, "&comma;", ","); // unescape the commas
-        ReplaceAll(value, "&amp;", "&");   // unescape the amps
+        if (ContainsEscapes(value)) {
+            ReplaceAll(value, "&comma;", ","); // unescape the commas
+            ReplaceAll(value, "&amp;", "&");   // unescape the amps
+        }
 
         RemapKey(name, value);
         if (effectManager != nullptr)
             value = RenderableEffect::UpgradeValueCurve(effectManager, name, value, effectName);
         if (!name.empty()) {
-            (*this)[name] = value;
+            // keys are usually written in order so hinting the end makes most inserts constant time
+            insert_or_assign(end(), SettingKey(name), value);
         }
     }
 }
@@ -41,29 +132,37 @@ void MapStringString::ParseJson(EffectManager* effectManager, const std::string&
 void MapStringString::Parse(EffectManager* effectManager, const std::string& str, const std::string& effectName)
 {
     clear();
-    std::string before, after, name, value;
-    std::string settings(str);
-    while (!settings.empty()) {
-        size_t start_pos = settings.find(',');
-        if (start_pos != std::string::npos) {
-            before = settings.substr(0, start_pos);
-            settings = settings.substr(start_pos + 1);
+    std::string name, value;
+    size_t len = str.size();
+    size_t start = 0;
+    while (start < len) {
+        size_t stop = str.find(',', start);
+        if (stop == std::string::npos) {
+            stop = len;
+        }
+
+        size_t sep = str.find('=', start);
+        if (sep >= stop) {
+            // no value so the whole entry is used for both
+            name.assign(str, start, stop - start);
+            value = name;
         } else {
-            before = settings;
-            settings = "";
+            name.assign(str, start, sep - start);
+            value.assign(str, sep + 1, stop - sep - 1);
         }
+        start = stop + 1;
 
-        start_pos = before.find('=');
-        name = before.substr(0, start_pos);
-        value = before.substr(start_pos + 1);
-        ReplaceAll(value, "&comma;", ","); // unescape the commas
-        ReplaceAll(value, "&amp;", "&");   // unescape the amps
+        if (ContainsEscapes(value)) {
+            ReplaceAll(value, "&comma;", ","); // unescape the commas
+            ReplaceAll(value, "&amp;", "&");   // unescape the amps
+        }
 
         RemapKey(name, value);
         if (effectManager != nullptr)
             value = RenderableEffect::UpgradeValueCurve(effectManager, name, value, effectName);
         if (!name.empty()) {
-            (*this)[name] = value;
+            // keys are usually written in order so hinting the end makes most inserts constant time
+            insert_or_assign(end(), SettingKey(name), value);
         }
     }
 }
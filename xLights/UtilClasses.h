@@ -12,15 +12,88 @@
 
 #include <map>
 #include <string>
+#include <string_view>
 #include <algorithm>
+#include <memory>
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
 
 #include <wx/filepicker.h>
 
 class EffectManager;
 
-class MapStringString: public std::map<std::string,std::string> {
+// Thread safe table of immutable strings. Identical strings interned share a single copy which makes it cheap to hold
+// the many repeated settings and palette strings found in a sequence.
+class StringIntern
+{
+public:
+    static std::shared_ptr<const std::string> Intern(const std::string& str);
+    static std::shared_ptr<const std::string> Intern(std::string&& str);
+
+    // Release any strings which are no longer referenced outside the table
+    static void Purge();
+    static size_t GetCount();
+
+private:
+    static std::mutex __lock;
+    static std::unordered_map<std::string_view, std::shared_ptr<const std::string>> __strings;
+};
+
+// Key of a settings map. Setting names come from a small fixed vocabulary so each distinct name is interned once
+// for the life of the program and every map entry just points at the shared copy. It reads like a const std::string.
+class SettingKey
+{
+public:
+    explicit SettingKey(std::string_view key) : _key(Intern(key)) {}
+
+    const std::string& str() const { return *_key; }
+    operator const std::string&() const { return *_key; }
+
+    const char* c_str() const { return _key->c_str(); }
+    const char* data() const { return _key->data(); }
+    size_t size() const { return _key->size(); }
+    size_t length() const { return _key->length(); }
+    bool empty() const { return _key->empty(); }
+    char operator[](size_t pos) const { return (*_key)[pos]; }
+    template<typename T> size_t find(const T& s, size_t pos = 0) const { return _key->find(s, pos); }
+    template<typename T> size_t rfind(const T& s, size_t pos = std::string::npos) const { return _key->rfind(s, pos); }
+    std::string substr(size_t pos = 0, size_t n = std::string::npos) const { return _key->substr(pos, n); }
+    int compare(std::string_view s) const { return std::string_view(*_key).compare(s); }
+
+    // interned so equal keys are always the same string
+    bool operator==(const SettingKey& other) const { return _key == other._key; }
+    bool operator!=(const SettingKey& other) const { return _key != other._key; }
+    bool operator<(const SettingKey& other) const { return _key != other._key && *_key < *other._key; }
+
+    static size_t GetCount();
+
+private:
+    const std::string* _key;
+
+    static const std::string* Intern(std::string_view key);
+    static std::shared_mutex __lock;
+    static std::unordered_map<std::string_view, const std::string*> __index;
+    static std::deque<std::string> __keys;
+};
+
+// comparisons with plain strings let maps keyed by SettingKey be searched without interning the search key
+inline bool operator==(const SettingKey& a, std::string_view b) { return std::string_view(a.str()) == b; }
+inline bool operator==(std::string_view a, const SettingKey& b) { return a == std::string_view(b.str()); }
+inline bool operator!=(const SettingKey& a, std::string_view b) { return !(a == b); }
+inline bool operator!=(std::string_view a, const SettingKey& b) { return !(a == b); }
+inline bool operator<(const SettingKey& a, std::string_view b) { return std::string_view(a.str()) < b; }
+inline bool operator<(std::string_view a, const SettingKey& b) { return a < std::string_view(b.str()); }
+inline std::string operator+(const SettingKey& a, const std::string& b) { return a.str() + b; }
+inline std::string operator+(const std::string& a, const SettingKey& b) { return a + b.str(); }
+inline std::string operator+(const SettingKey& a, const char* b) { return a.str() + b; }
+inline std::string operator+(const char* a, const SettingKey& b) { return a + b.str(); }
+inline std::string operator+(const SettingKey& a, char b) { return a.str() + b; }
+
+class MapStringString: public std::map<SettingKey, std::string, std::less<>> {
 public:
-    MapStringString(): std::map<std::string,std::string>() {
+    MapStringString(): std::map<SettingKey, std::string, std::less<>>() {
     }
     virtual ~MapStringString() {}
 
@@ -28,10 +101,17 @@ public:
         return Get(key, EMPTY_STRING);
     }
     std::string &operator[](const std::string &key) {
-        return std::map<std::string, std::string>::operator[](key);
+        auto it = lower_bound(key);
+        if (it != end() && it->first == key) {
+            return it->second;
+        }
+        return emplace_hint(it, SettingKey(key), std::string())->second;
+    }
+    std::string &operator[](const SettingKey &key) {
+        return std::map<SettingKey, std::string, std::less<>>::operator[](key);
     }
     int GetInt(const std::string &key, const int def = 0) const {
-        std::map<std::string,std::string>::const_iterator i(find(key));
+        const_iterator i(find(key));
         if (i == end() || i->second.length() == 0) {
             return def;
         }
@@ -43,7 +123,7 @@ public:
     }
     float GetFloat(const std::string& key, const float def = 0.0) const
     {
-        std::map<std::string, std::string>::const_iterator i(find(key));
+        const_iterator i(find(key));
         if (i == end() || i->second.length() == 0) {
             return def;
         }
@@ -56,7 +136,7 @@ public:
     }
     double GetDouble(const std::string& key, const double def = 0.0) const
     {
-        std::map<std::string, std::string>::const_iterator i(find(key));
+        const_iterator i(find(key));
         if (i == end() || i->second.length() == 0) {
             return def;
         }
@@ -69,7 +149,7 @@ public:
     }
     bool GetBool(const std::string& key, const bool def = false) const
     {
-        std::map<std::string, std::string>::const_iterator i(find(key));
+        const_iterator i(find(key));
         if (i == end()) {
             return def;
         }
@@ -77,7 +157,7 @@ public:
     }
     const std::string& Get(const std::string& key, const std::string& def) const
     {
-        std::map<std::string, std::string>::const_iterator i(find(key));
+        const_iterator i(find(key));
         if (i == end()) {
             return def;
         }
@@ -86,7 +166,7 @@ public:
 
     std::string Get(const std::string& key, const char* def) const
     {
-        std::map<std::string, std::string>::const_iterator i(find(key));
+        const_iterator i(find(key));
         if (i == end()) {
             return def;
         }
@@ -95,7 +175,7 @@ public:
 
     bool Contains(const std::string& key) const
     {
-        std::map<std::string, std::string>::const_iterator i(find(key));
+        const_iterator i(find(key));
         if (i == end()) {
             return false;
         }
@@ -108,8 +188,7 @@ public:
     }
     std::string& operator[](const char* ckey)
     {
-        std::string key(ckey);
-        return std::map<std::string, std::string>::operator[](key);
+        return operator[](std::string(ckey));
     }
     int GetInt(const char* ckey, const int def = 0) const
     {
@@ -140,7 +219,7 @@ public:
     std::string Get(const char* ckey, const char* def) const
     {
         std::string key(ckey);
-        std::map<std::string, std::string>::const_iterator i(find(key));
+        const_iterator i(find(key));
         if (i == end()) {
             return def;
         }
@@ -148,12 +227,16 @@ public:
     }
     size_type erase(const char* ckey)
     {
-        std::string key(ckey);
-        return std::map<std::string, std::string>::erase(key);
+        return erase(std::string(ckey));
     }
     size_type erase(const std::string& key)
     {
-        return std::map<std::string, std::string>::erase(key);
+        auto it = find(key);
+        if (it == end()) {
+            return 0;
+        }
+        std::map<SettingKey, std::string, std::less<>>::erase(it);
+        return 1;
     }
 
     void ParseJson(EffectManager* effectManager, const std::string& str, const std::string& effectName);
@@ -162,7 +245,7 @@ public:
     virtual void RemapKey(std::string &n, std::string &value) {};
     std::string AsString() const {
         std::string ret;
-        for (std::map<std::string,std::string>::const_iterator it=begin(); it!=end(); ++it) {
+        for (const_iterator it=begin(); it!=end(); ++it) {
             if (ret.length() != 0) {
                 ret += ",";
             }
@@ -176,7 +259,7 @@ public:
     [[nodiscard]]std::string AsJSON() const
     {
         std::string ret ;
-        for (std::map<std::string, std::string>::const_iterator it = begin(); it != end(); ++it) {
+        for (const_iterator it = begin(); it != end(); ++it) {
             if (ret.length() != 0) {
                 ret += ",";
             }
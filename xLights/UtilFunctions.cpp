@@ -38,10 +38,13 @@
 #ifdef __WXMSW__
 #include <psapi.h>
 #include <iphlpapi.h>
+#include <ws2tcpip.h>
 #else
 #include <sys/socket.h>
 #include <ifaddrs.h>
 #include <arpa/inet.h>
+#include <netinet/in.h>
+#include <unistd.h>
 #endif
 
 #ifdef __WXOSX__
@@ -1107,6 +1110,48 @@ std::list<std::string> GetLocalIPs()
     return res;
 }
 
+// Returns the local IP of the interface the OS would send to ip through or blank if there is no route
+std::string GetLocalIPForRoute(const std::string& ip)
+{
+    std::string res;
+
+    struct sockaddr_in remote;
+    memset(&remote, 0x00, sizeof(remote));
+    remote.sin_family = AF_INET;
+    remote.sin_port = htons(9);
+    if (inet_pton(AF_INET, ip.c_str(), &remote.sin_addr) != 1) return res;
+
+    // connecting a UDP socket sends nothing but makes the OS choose the route
+#ifdef __WXMSW__
+    SOCKET s = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (s == INVALID_SOCKET) return res;
+    int len = sizeof(struct sockaddr_in);
+#else
+    int s = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (s < 0) return res;
+    socklen_t len = sizeof(struct sockaddr_in);
+#endif
+
+    if (connect(s, (struct sockaddr*)&remote, sizeof(remote)) == 0) {
+        struct sockaddr_in local;
+        memset(&local, 0x00, sizeof(local));
+        if (getsockname(s, (struct sockaddr*)&local, &len) == 0) {
+            char buf[INET_ADDRSTRLEN];
+            if (inet_ntop(AF_INET, &local.sin_addr, buf, sizeof(buf)) != nullptr) {
+                res = buf;
+            }
+        }
+    }
+
+#ifdef __WXMSW__
+    closesocket(s);
+#else
+    close(s);
+#endif
+
+    return res;
+}
+
 bool IsValidLocalIP(const std::string& ip)
 {
     for (const auto& it : GetLocalIPs()) {
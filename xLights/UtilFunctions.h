@@ -349,6 +349,7 @@ inline const char* const toStr(bool b)
 
 bool IsExcessiveMemoryUsage(double physicalMultiplier = 0.95);
 std::list<std::string> GetLocalIPs();
+std::string GetLocalIPForRoute(const std::string& ip);
 bool IsValidLocalIP(const std::string& ip);
 bool IsValidLocalIP(const wxIPV4address& ip);
 bool IsInSameSubnet(const std::string& ip1, const std::string& ip2, const std::string& mask = "255.255.255.0");
@@ -15,6 +15,7 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include "UtilFunctions.h"
+#include "models/RenderBufferNodeCache.h"
 
 void PreviewCamera::Reset()
 {
@@ -143,6 +144,8 @@ void ViewpointMgr::DeleteCamera3D(int i)
     std::advance(it, i);
     previewCameras3d.erase(it);
     delete todelete;
+    // render buffers mapped through this camera are no longer valid
+    RenderBufferNodeCache::Clear();
 }
 
 void ViewpointMgr::DeleteCamera2D(int i)
@@ -201,6 +204,7 @@ void ViewpointMgr::Clear()
     }
     previewCameras2d.clear();
     previewCameras3d.clear();
+    RenderBufferNodeCache::Clear();
 }
 
 void ViewpointMgr::AddCamera( std::string name, PreviewCamera* current_camera, bool is_3d )
@@ -218,6 +222,7 @@ void ViewpointMgr::AddCamera( std::string name, PreviewCamera* current_camera, b
     }
     if (is_3d) {
         previewCameras3d.push_back(new_camera);
+        RenderBufferNodeCache::Clear();
     }
     else {
         previewCameras2d.push_back(new_camera);
@@ -347,6 +352,7 @@ void ViewpointMgr::Load(wxXmlNode* vp_node)
 {
 	if (vp_node != nullptr)
 	{
+        RenderBufferNodeCache::Clear();
         previewCameras2d.clear();
         previewCameras3d.clear();
         for (wxXmlNode* c = vp_node->GetChildren(); c != nullptr; c = c->GetNext())
@@ -168,7 +168,7 @@ void WiringDialog::SetData(Model* model)
     float maxy = 0;
     for (int i = 0; i < nodes; ++i)
     {
-        auto points = nodeList[i]->Coords;
+        const auto& points = std::as_const(nodeList[i]->Coords);
 
         for (const auto& it : points)
         {
@@ -202,7 +202,7 @@ void WiringDialog::SetData(Model* model)
             stringnode = 1 + (nodeList[i]->ActChan - nodeList[0]->ActChan) / nodeList[0]->GetChanCount();
         }
 
-        auto points = nodeList[i]->Coords;
+        const auto& points = std::as_const(nodeList[i]->Coords);
         for (const auto& it : points)
         {
             float x = it.screenX;
@@ -14,6 +14,7 @@
 #include <string.h>
 #include <cctype>
 #include <thread>
+#include <atomic>
 #include <cinttypes>
 
 #include <curl/curl.h>
@@ -31,10 +32,12 @@
 #include <wx/config.h>
 #include <wx/secretstore.h>
 #include <wx/progdlg.h>
+#include <wx/dir.h>
 #include <zstd.h>
 
 #include "../xSchedule/wxJSON/jsonreader.h"
 #include "../xSchedule/wxJSON/jsonwriter.h"
+#include "../xSchedule/md5.h"
 
 #include "FPP.h"
 #include "../models/CustomModel.h"
@@ -69,6 +72,10 @@ using namespace TraceLog;
 
 static const std::string LEDPANELS("LED Panels");
 
+#ifndef DISCOVERYONLY
+std::string FPP::__manifestFolder;
+#endif
+
 FPP::FPP(const std::string& ad) :
     BaseController(ad, ""), majorVersion(0), minorVersion(0), outputFile(nullptr), parent(nullptr), ipAddress(ad), curl(nullptr), fppType(FPP_TYPE::FPP) {
     wxIPV4address address;
@@ -124,7 +131,8 @@ void FPP::setIPAddress(const std::string &ip) {
 
 struct FPPWriteData {
     FPPWriteData() : file(nullptr), progress(nullptr), data(nullptr), dataSize(0), curPos(0),
-        postData(nullptr), postDataSize(0), totalWritten(0), cancelled(false), lastDone(0) {}
+        postData(nullptr), postDataSize(0), totalWritten(0), cancelled(false), lastDone(0),
+        progressValue(nullptr), abort(nullptr) {}
 
     uint8_t *data;
     size_t dataSize;
@@ -141,6 +149,10 @@ struct FPPWriteData {
     size_t lastDone;
     bool cancelled;
 
+    // used instead of the progress dialog when uploading from a background thread
+    std::atomic_int *progressValue;
+    const std::atomic_bool *abort;
+
     size_t readData(void *ptr, size_t buffer_size) {
         if (data != nullptr) {
             size_t remaining = dataSize - curPos;
@@ -180,6 +192,11 @@ struct FPPWriteData {
                     cancelled = !progress->Update(donePct, progressString);
                     wxYield();
                 }
+            } else if (progressValue) {
+                *progressValue = (int)(totalWritten * 1000 / file->Length());
+            }
+            if (abort != nullptr && *abort) {
+                cancelled = true;
             }
             if (file->Eof()) {
                 curPos = 0;
@@ -782,6 +799,8 @@ bool FPP::uploadFile(const std::string &filename, const std::string &file) {
     data.progress = progressDialog;
     data.progressString = "Transferring " + filename + " to " + ipAddress;
     data.lastDone = lastDone;
+    data.progressValue = &uploadProgress;
+    data.abort = uploadAbort;
 
     int i = curl_easy_perform(curl);
     curl_slist_free_all(chunk);
@@ -969,6 +988,11 @@ bool FPP::PrepareUploadSequence(const FSEQFile &file,
         ::wxRemoveFile(tempFileName);
         tempFileName = "";
     }
+    uploadVariant = "";
+    uploadSource = nullptr;
+    uploadPending = false;
+    playerSequenceId = "";
+    uploadManifest = FSEQManifest();
 
     wxFileName fn(seq);
     std::string baseName = fn.GetFullName();
@@ -1026,6 +1050,7 @@ bool FPP::PrepareUploadSequence(const FSEQFile &file,
         wxJSONValue currentMeta;
         if (GetURLAsJSON("/api/sequence/" + URLEncode(baseName) + "/meta", currentMeta, false)) {
             doSeqUpload = false;
+            playerSequenceId = currentMeta["ID"].AsString();
             char buf[24];
             sprintf(buf, "%" PRIu64, file.getUniqueId());
             std::string version = currentMeta["Version"].AsString();
@@ -1058,6 +1083,12 @@ bool FPP::PrepareUploadSequence(const FSEQFile &file,
                 }
             }
         }
+    } else if (!IsDrive() && fppType == FPP_TYPE::ESPIXELSTICK && GetManifestFileName(baseName) != "") {
+        // the file is always rebuilt for an ESPixelStick, the id is only used to decide if the upload manifest is current
+        wxJSONValue currentMeta;
+        if (GetURLAsJSON("/api/sequence/" + URLEncode(baseName) + "/meta", currentMeta, false) && currentMeta.HasMember("ID")) {
+            playerSequenceId = currentMeta["ID"].AsString();
+        }
     }
 
     int channelCount = 0;
@@ -1143,6 +1174,16 @@ bool FPP::PrepareUploadSequence(const FSEQFile &file,
         }
     }
     outputFile->writeHeader();
+
+    if (!IsDrive() && (fppType == FPP_TYPE::FPP || fppType == FPP_TYPE::ESPIXELSTICK)) {
+        // everything that affects the bytes of the generated file
+        uploadVariant = baseName + ":" + std::to_string(type) + ":" + std::to_string((int)ctype) + ":" + std::to_string(clevel) + ":" + (IsVersionAtLeast(5, 0) ? "1" : "0");
+        if (type >= 2) {
+            for (const auto& a : newRanges) {
+                uploadVariant += ":" + std::to_string(a.first) + "-" + std::to_string(a.second);
+            }
+        }
+    }
     return false;
 }
 
@@ -1158,18 +1199,243 @@ bool FPP::AddFrameToUpload(uint32_t frame, uint8_t *data) {
 }
 
 bool FPP::FinalizeUploadSequence() {
-    bool cancelled = false;
+    EncodeUploadSequence();
+    bool cancelled = UploadEncodedSequence();
+    ClearUploadSequence();
+    return cancelled;
+}
+
+void FPP::ShareUploadSequence(FPP* encoder) {
+    if (outputFile) {
+        delete outputFile;
+        outputFile = nullptr;
+    }
+    if (tempFileName != "") {
+        ::wxRemoveFile(tempFileName);
+        tempFileName = "";
+    }
+    uploadSource = encoder;
+    uploadPending = true;
+}
+
+void FPP::EncodeUploadSequence() {
     if (outputFile) {
         outputFile->finalize();
 
         delete outputFile;
         outputFile = nullptr;
         if (tempFileName != "" && (fppType == FPP_TYPE::FPP || fppType == FPP_TYPE::ESPIXELSTICK)) {
-            cancelled = uploadOrCopyFile(baseSeqName, tempFileName, "sequences");
-            ::wxRemoveFile(tempFileName);
-            tempFileName = "";
+            uploadPending = true;
+            // instances sharing this file compare against this hash so it is needed whatever type this instance is
+            if (__manifestFolder != "") {
+                HashFSEQ(tempFileName, uploadManifest);
+            }
+        }
+    }
+}
+
+bool FPP::UploadEncodedSequence() {
+    static log4cpp::Category& logger_base = log4cpp::Category::getInstance(std::string("log_base"));
+
+    bool cancelled = false;
+    if (uploadPending) {
+        uploadPending = false;
+        const FSEQManifest& sending = uploadSource != nullptr ? uploadSource->uploadManifest : uploadManifest;
+        std::string manifest = GetManifestFileName(baseSeqName);
+        if (manifest != "" && sending.hash != "") {
+            // only trust what we last sent if the player still has that exact file
+            FSEQManifest current;
+            if (playerSequenceId != "" && LoadManifest(manifest, current) && std::to_string(current.id) == playerSequenceId) {
+                if (current.hash == sending.hash) {
+                    logger_base.debug("FPP %s already has the channel data for %s, upload skipped.", (const char*)ipAddress.c_str(), (const char*)baseSeqName.c_str());
+                    return false;
+                }
+                logger_base.debug("FPP %s: %s has changed.", (const char*)ipAddress.c_str(), (const char*)baseSeqName.c_str());
+            }
+        }
+        size_t errors = messages.size();
+        cancelled = uploadOrCopyFile(baseSeqName, uploadSource != nullptr ? uploadSource->tempFileName : tempFileName, "sequences");
+        if (manifest != "") {
+            if (!cancelled && errors == messages.size() && sending.hash != "") {
+                SaveManifest(manifest, sending);
+            } else {
+                ::wxRemoveFile(manifest);
+            }
+        }
+    }
+    return cancelled;
+}
+
+void FPP::SetUploadManifestFolder(const std::string& folder) {
+    static log4cpp::Category& logger_base = log4cpp::Category::getInstance(std::string("log_base"));
+
+    if (folder != "" && !wxDir::Exists(folder)) {
+        if (!wxFileName::Mkdir(folder, wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL)) {
+            logger_base.warn("Unable to create FPP upload manifest folder %s. Unchanged sequences will always be uploaded.", (const char*)folder.c_str());
+            __manifestFolder = "";
+            return;
         }
     }
+    __manifestFolder = folder;
+}
+
+std::string FPP::GetManifestFileName(const std::string& seq) {
+    if (__manifestFolder == "" || (fppType != FPP_TYPE::FPP && fppType != FPP_TYPE::ESPIXELSTICK) || IsDrive()) {
+        return "";
+    }
+    std::string key = (uuid != "" ? uuid : ipAddress) + "/" + seq;
+    MD5 md5;
+    md5.update(key.c_str(), (MD5::size_type)key.size());
+    md5.finalize();
+    return __manifestFolder + wxFileName::GetPathSeparator() + md5.hexdigest() + ".fppm";
+}
+
+#define FSEQ_HASH_CHUNK (1024 * 1024)
+
+// The hash ignores the unique id in the header as it changes every time the sequence is rendered
+bool FPP::HashFSEQ(const std::string& file, FSEQManifest& manifest) {
+    manifest = FSEQManifest();
+
+    wxFile f;
+    if (!f.Open(file)) return false;
+
+    std::vector<uint8_t> buf(FSEQ_HASH_CHUNK);
+    ssize_t got = f.Read(buf.data(), buf.size());
+    if (got < 32 || memcmp(buf.data(), "PSEQ", 4) != 0 || buf[7] != 2) {
+        return false;
+    }
+    uint64_t id = 0;
+    memcpy(&id, &buf[24], sizeof(id));
+    memset(&buf[24], 0, 8);
+
+    MD5 md5;
+    while (got > 0) {
+        md5.update((const char*)buf.data(), (MD5::size_type)got);
+        got = f.Read(buf.data(), buf.size());
+    }
+    if (got == wxInvalidOffset) return false;
+    md5.finalize();
+
+    manifest.id = id;
+    manifest.hash = md5.hexdigest();
+    return true;
+}
+
+bool FPP::LoadManifest(const std::string& file, FSEQManifest& manifest) {
+    wxFile f;
+    if (!FileExists(file, false) || !f.Open(file)) return false;
+    wxString content;
+    if (!f.ReadAll(&content)) return false;
+    wxArrayString lines = wxSplit(content, '\n');
+    if (lines.size() < 3 || lines[0] != "XLFPPM 2") return false;
+    manifest.id = std::strtoull(lines[1].c_str(), nullptr, 10);
+    manifest.hash = lines[2].ToStdString();
+    return manifest.hash != "";
+}
+
+bool FPP::SaveManifest(const std::string& file, const FSEQManifest& manifest) {
+    std::string content = "XLFPPM 2\n" + std::to_string(manifest.id) + "\n" + manifest.hash + "\n";
+    wxFile f;
+    if (!f.Create(file, true)) return false;
+    return f.Write(content.c_str(), content.size()) == content.size();
+}
+
+void FPP::ClearUploadSequence() {
+    if (outputFile) {
+        delete outputFile;
+        outputFile = nullptr;
+    }
+    // the falcon upload still needs the temp file
+    if (tempFileName != "" && (fppType == FPP_TYPE::FPP || fppType == FPP_TYPE::ESPIXELSTICK)) {
+        ::wxRemoveFile(tempFileName);
+        tempFileName = "";
+    }
+    uploadVariant = "";
+    uploadSource = nullptr;
+    uploadPending = false;
+}
+
+bool FPP::UploadSequences(const std::list<FPP*>& instances, int maxConnections, wxProgressDialog* prgs) {
+    static log4cpp::Category& logger_base = log4cpp::Category::getInstance(std::string("log_base"));
+
+    std::vector<FPP*> targets;
+    for (const auto& inst : instances) {
+        if (inst->uploadPending) {
+            targets.push_back(inst);
+        }
+    }
+    if (targets.empty()) {
+        return false;
+    }
+    int connections = std::max(1, std::min(maxConnections, (int)targets.size()));
+    logger_base.debug("FPP uploading sequence to %d instances using %d connections.", (int)targets.size(), connections);
+
+    std::atomic_bool abort(false);
+    std::atomic_int next(0);
+    std::atomic_int running(connections);
+    std::vector<int> results(targets.size(), 0);
+    std::vector<wxProgressDialog*> dialogs(targets.size());
+    for (size_t x = 0; x < targets.size(); x++) {
+        // progress is reported back here rather than updating the dialog from the upload threads
+        dialogs[x] = targets[x]->progressDialog;
+        targets[x]->progressDialog = nullptr;
+        targets[x]->uploadProgress = 0;
+        targets[x]->uploadAbort = &abort;
+    }
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < connections; t++) {
+        threads.emplace_back([&targets, &results, &next, &running, &abort]() {
+            int idx = next++;
+            while (idx < (int)targets.size() && !abort) {
+                results[idx] = targets[idx]->UploadEncodedSequence() ? 1 : 0;
+                targets[idx]->uploadProgress = 1000;
+                idx = next++;
+            }
+            running--;
+        });
+    }
+
+    bool cancelled = false;
+    if (prgs != nullptr) {
+        prgs->SetTitle("FPP Upload");
+        prgs->Show();
+    }
+    while (running > 0) {
+        if (prgs != nullptr) {
+            int total = 0;
+            int done = 0;
+            std::string active;
+            for (const auto& inst : targets) {
+                int p = inst->uploadProgress;
+                total += p;
+                if (p == 1000) {
+                    done++;
+                } else if (p > 0) {
+                    active += "\n" + inst->ipAddress + " - " + std::to_string(p / 10) + "%";
+                }
+            }
+            std::string msg = "Transferring " + targets.front()->baseSeqName + " (" + std::to_string(done) + "/" + std::to_string(targets.size()) + ")" + active;
+            cancelled |= !prgs->Update(std::min(999, total / (int)targets.size()), msg);
+            if (cancelled) {
+                abort = true;
+            }
+            wxYield();
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    for (size_t x = 0; x < targets.size(); x++) {
+        targets[x]->progressDialog = dialogs[x];
+        targets[x]->uploadAbort = nullptr;
+        cancelled |= results[x] != 0;
+    }
+    if (prgs != nullptr) {
+        cancelled |= !prgs->Update(1000);
+    }
     return cancelled;
 }
 
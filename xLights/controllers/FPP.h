@@ -1,10 +1,12 @@
 #pragma once
 
+#include <atomic>
 #include <list>
 #include <map>
 #include <set>
 #include <algorithm>
 #include <string>
+#include <vector>
 
 #include "../models/ModelManager.h"
 #include "ControllerUploadData.h"
@@ -88,6 +90,22 @@ class FPP : public BaseController
     bool FinalizeUploadSequence();
     std::string GetTempFile() const { return tempFileName; }
     void ClearTempFile() { tempFileName = ""; }
+
+    // Instances that would generate byte identical sequence files share the same variant so only one
+    // of them needs to encode it. The others upload the encoder's file via ShareUploadSequence.
+    const std::string& GetUploadVariant() const { return uploadVariant; }
+    void ShareUploadSequence(FPP* encoder);
+    void EncodeUploadSequence();
+    bool UploadEncodedSequence();
+    void ClearUploadSequence();
+
+    // Upload the encoded sequences to all the instances that have one pending using up to maxConnections
+    // concurrent transfers. Returns true if cancelled.
+    static bool UploadSequences(const std::list<FPP*>& instances, int maxConnections, wxProgressDialog* prgs);
+
+    // Folder holding the block hashes of the sequences last uploaded to each instance. A sequence whose
+    // channel data matches what the instance already has is not uploaded again.
+    static void SetUploadManifestFolder(const std::string& folder);
 #endif
 
     bool UploadUDPOutputsForProxy(OutputManager* outputManager);
@@ -181,6 +199,27 @@ private:
     std::string tempFileName;
     std::string baseSeqName;
     FSEQFile *outputFile = nullptr;
+    std::string uploadVariant;
+    FPP *uploadSource = nullptr;
+    bool uploadPending = false;
+    std::atomic_int uploadProgress{ 0 };
+    const std::atomic_bool *uploadAbort = nullptr;
+    std::string playerSequenceId;
+
+#ifndef DISCOVERYONLY
+    // what was last uploaded ... the players cannot patch a file so all that matters is whether it changed
+    struct FSEQManifest {
+        uint64_t id = 0;
+        std::string hash;
+    };
+    FSEQManifest uploadManifest;
+
+    std::string GetManifestFileName(const std::string& seq);
+    static bool HashFSEQ(const std::string& file, FSEQManifest& manifest);
+    static bool LoadManifest(const std::string& file, FSEQManifest& manifest);
+    static bool SaveManifest(const std::string& file, const FSEQManifest& manifest);
+    static std::string __manifestFolder;
+#endif
 
     void setupCurl(int timeout = 30000);
     CURL *curl = nullptr;
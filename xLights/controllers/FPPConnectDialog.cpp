@@ -897,7 +897,27 @@ void FPPConnectDialog::OnButton_UploadClick(wxCommandEvent& event)
                     }
                     row++;
                 }
+                // instances that would generate identical files share a single encode
+                std::map<std::string, FPP*> variants;
+                std::vector<FPP*> encoders;
+                row = 0;
+                for (const auto& inst : instances) {
+                    if (!cancelled && doUpload[row] && inst->WillUploadSequence()) {
+                        const std::string& variant = inst->GetUploadVariant();
+                        auto v = variant.empty() ? variants.end() : variants.find(variant);
+                        if (v != variants.end()) {
+                            inst->ShareUploadSequence(v->second);
+                        } else {
+                            if (!variant.empty()) {
+                                variants[variant] = inst;
+                            }
+                            encoders.push_back(inst);
+                        }
+                    }
+                    row++;
+                }
                 if (!cancelled && uploadCount) {
+                    logger_base.debug("FPPConnect generating %d FSEQ files for %d instances.", (int)encoders.size(), uploadCount);
                     prgs.SetTitle("Generating FSEQ Files");
                     cancelled |= !prgs.Update(0, "Generating " + wxFileName(fseq).GetFullName());
                     prgs.Show();
@@ -933,20 +953,22 @@ void FPPConnectDialog::OnButton_UploadClick(wxCommandEvent& event)
                             frame++;
                         }
                         frame--;
-                        std::function<void(FPP * &, int)> func = [startFrame, lastBuffered, &frames, &doUpload](FPP* &inst, int row) {
-                            if (doUpload[row]) {
-                                for (int x = 0; x < lastBuffered; x++) {
-                                    inst->AddFrameToUpload(startFrame + x, &frames[x][0]);
-                                }
+                        parallel_for(0, (int)encoders.size(), [startFrame, lastBuffered, &frames, &encoders](int idx) {
+                            for (int x = 0; x < lastBuffered; x++) {
+                                encoders[idx]->AddFrameToUpload(startFrame + x, &frames[x][0]);
                             }
-                        };
-                        parallel_for(instances, func);
+                        });
+                    }
+                    if (!cancelled) {
+                        parallel_for(0, (int)encoders.size(), [&encoders](int idx) {
+                            encoders[idx]->EncodeUploadSequence();
+                        });
+                        int maxConnections = wxConfigBase::Get()->ReadLong("xLightsFPPConnectMaxUploads", 4);
+                        cancelled |= FPP::UploadSequences(instances, maxConnections, &prgs);
                     }
                     row = 0;
                     for (const auto &inst : instances) {
                         if (!cancelled && doUpload[row]) {
-                            cancelled |= inst->FinalizeUploadSequence();
-
                             if (inst->fppType == FPP_TYPE::FALCONV4) {
                                 // a falcon
                                 std::string proxy = "";
@@ -975,6 +997,9 @@ void FPPConnectDialog::OnButton_UploadClick(wxCommandEvent& event)
                         row++;
                     }
                 }
+                for (const auto& inst : instances) {
+                    inst->ClearUploadSequence();
+                }
             }
             delete seq;
         }
@@ -43,6 +43,8 @@ class GIFImage
 		virtual ~GIFImage();
 		wxImage GetFrame(int frame);
 		wxImage GetFrameForTime(int msec, bool loop);
+        int GetFrameIndexForTime(int msec, bool loop) { return CalcFrameForTime(msec, loop); }
+        wxSize GetSize() const { return _gifSize; }
         int GetMSUntilNextFrame(int msec, bool loop);
         std::string GetFilename() const { return _filename; }
         bool IsOk() const { return _ok; }
@@ -0,0 +1,180 @@
+/***************************************************************
+ * This source files comes from the xLights project
+ * https://www.xlights.org
+ * https://github.com/smeighan/xLights
+ * See the github commit history for a record of contributing
+ * developers.
+ * Copyright claimed based on commit dates recorded in Github
+ * License: https://github.com/smeighan/xLights/blob/master/License.txt
+ **************************************************************/
+
+#include "PictureFrameCache.h"
+
+#include <wx/filename.h>
+#include <wx/log.h>
+
+#include <atomic>
+#include <list>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+
+#include <log4cpp/Category.hh>
+
+#define PICTURE_CACHE_DEFAULT_MAX_BYTES (256 * 1024 * 1024)
+
+struct CachedPictureFrame
+{
+    std::string key;
+    PictureFrameCache::ImagePtr image;
+    size_t bytes;
+};
+
+static std::mutex __lock;
+static std::list<CachedPictureFrame> __frames; // most recently used first
+static std::unordered_map<std::string, std::list<CachedPictureFrame>::iterator> __index;
+static std::map<std::string, int> __imageCounts;
+static size_t __bytes = 0;
+static size_t __maxBytes = PICTURE_CACHE_DEFAULT_MAX_BYTES;
+static std::atomic<uint64_t> __hits(0);
+static std::atomic<uint64_t> __misses(0);
+static std::atomic<uint64_t> __evictions(0);
+
+static std::string MakeKey(const std::string& fileKey, int frame, int width, int height, int flags)
+{
+    return fileKey + "|" + std::to_string(frame) + "|" + std::to_string(width) + "x" + std::to_string(height) + "|" + std::to_string(flags);
+}
+
+static size_t ImageBytes(const wxImage& image)
+{
+    size_t pixels = (size_t)image.GetWidth() * image.GetHeight();
+    return pixels * (image.HasAlpha() ? 4 : 3);
+}
+
+// must be called holding the lock
+static void Evict()
+{
+    while (__bytes > __maxBytes && !__frames.empty()) {
+        auto& last = __frames.back();
+        __bytes -= last.bytes;
+        __index.erase(last.key);
+        __frames.pop_back();
+        ++__evictions;
+    }
+}
+
+std::string PictureFrameCache::GetFileKey(const std::string& filename)
+{
+    wxFileName fn(filename);
+    wxDateTime modified;
+    if (fn.GetTimes(nullptr, &modified, nullptr) && modified.IsValid()) {
+        return filename + "|" + modified.GetValue().ToString().ToStdString();
+    }
+    return filename;
+}
+
+int PictureFrameCache::GetImageCount(const std::string& fileKey, const std::string& filename)
+{
+    {
+        std::unique_lock<std::mutex> lock(__lock);
+        auto it = __imageCounts.find(fileKey);
+        if (it != __imageCounts.end()) {
+            return it->second;
+        }
+    }
+
+    wxLogNull logNo; // suppress popups from png images. See http://trac.wxwidgets.org/ticket/15331
+    int count = wxImage::GetImageCount(filename);
+
+    std::unique_lock<std::mutex> lock(__lock);
+    __imageCounts[fileKey] = count;
+    return count;
+}
+
+PictureFrameCache::ImagePtr PictureFrameCache::Get(const std::string& fileKey, int frame, int width, int height, int flags)
+{
+    std::string key = MakeKey(fileKey, frame, width, height, flags);
+
+    std::unique_lock<std::mutex> lock(__lock);
+    auto it = __index.find(key);
+    if (it == __index.end()) {
+        ++__misses;
+        return nullptr;
+    }
+    __frames.splice(__frames.begin(), __frames, it->second);
+    ++__hits;
+    return it->second->image;
+}
+
+PictureFrameCache::ImagePtr PictureFrameCache::Put(const std::string& fileKey, int frame, int width, int height, int flags, wxImage image)
+{
+    if (!image.IsOk()) return nullptr;
+
+    size_t bytes = ImageBytes(image);
+    std::string key = MakeKey(fileKey, frame, width, height, flags);
+
+    // the shared image must be the only owner of its data, the caller's image may share it with others
+    if (image.GetRefData()->GetRefCount() > 1) {
+        image = image.Copy();
+    }
+    ImagePtr shared = std::make_shared<const wxImage>(image);
+    image.UnRef();
+
+    std::unique_lock<std::mutex> lock(__lock);
+    if (bytes > __maxBytes) return shared;
+
+    auto it = __index.find(key);
+    if (it != __index.end()) {
+        // another thread got here first
+        __frames.splice(__frames.begin(), __frames, it->second);
+        return it->second->image;
+    }
+    __frames.push_front({ key, shared, bytes });
+    __index[key] = __frames.begin();
+    __bytes += bytes;
+    Evict();
+    return shared;
+}
+
+void PictureFrameCache::SetMaxBytes(size_t bytes)
+{
+    std::unique_lock<std::mutex> lock(__lock);
+    __maxBytes = bytes;
+    Evict();
+}
+
+void PictureFrameCache::Clear()
+{
+    std::unique_lock<std::mutex> lock(__lock);
+    __index.clear();
+    __frames.clear();
+    __imageCounts.clear();
+    __bytes = 0;
+}
+
+uint64_t PictureFrameCache::GetHitCount()
+{
+    return __hits;
+}
+
+uint64_t PictureFrameCache::GetMissCount()
+{
+    return __misses;
+}
+
+void PictureFrameCache::LogStatistics()
+{
+    static log4cpp::Category& logger_render = log4cpp::Category::getInstance(std::string("log_render"));
+    if (logger_render.isDebugEnabled()) {
+        size_t frames;
+        size_t bytes;
+        {
+            std::unique_lock<std::mutex> lock(__lock);
+            frames = __frames.size();
+            bytes = __bytes;
+        }
+        logger_render.debug("Picture frame cache: %llu hits, %llu misses, %llu evictions, %d frames using %lluKB.",
+            (unsigned long long)GetHitCount(), (unsigned long long)GetMissCount(), (unsigned long long)__evictions.load(),
+            (int)frames, (unsigned long long)(bytes / 1024));
+    }
+}
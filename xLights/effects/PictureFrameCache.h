@@ -0,0 +1,55 @@
+#pragma once
+
+/***************************************************************
+ * This source files comes from the xLights project
+ * https://www.xlights.org
+ * https://github.com/smeighan/xLights
+ * See the github commit history for a record of contributing
+ * developers.
+ * Copyright claimed based on commit dates recorded in Github
+ * License: https://github.com/smeighan/xLights/blob/master/License.txt
+ **************************************************************/
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include <wx/image.h>
+
+// Decoded and scaled picture frames shared by all the picture effects being rendered.
+//
+// The same image is often used on many models at once and animated GIFs are decoded and rescaled every
+// frame so frames are kept here keyed on the file, its modification time, the frame number and the size it
+// was scaled to. The least recently used frames are dropped once the cache exceeds its memory limit.
+// Cached images are handed out as shared read only images. wxImage reference counting is not thread safe so
+// a cached image never shares its data with another wxImage and must not be copied, only read or scaled.
+class PictureFrameCache
+{
+public:
+    typedef std::shared_ptr<const wxImage> ImagePtr;
+
+    enum
+    {
+        FLAG_QUALITY_BILINEAR = 0x01,
+        FLAG_SUPPRESS_GIF_BACKGROUND = 0x02,
+        FLAG_GIF_FRAME = 0x04 // a frame decoded by GIFImage rather than the file loaded as a still image
+    };
+
+    // Key identifying the current contents of a file, it changes when the file is modified
+    static std::string GetFileKey(const std::string& filename);
+
+    // Number of frames in the file, 1 for a still image
+    static int GetImageCount(const std::string& fileKey, const std::string& filename);
+
+    // width and height are 0 for the frame as decoded, returns nullptr if the frame is not cached
+    static ImagePtr Get(const std::string& fileKey, int frame, int width, int height, int flags);
+    // Adds the frame and returns the shared image to use in place of the one passed in, nullptr if it is not ok
+    static ImagePtr Put(const std::string& fileKey, int frame, int width, int height, int flags, wxImage image);
+
+    static void SetMaxBytes(size_t bytes);
+    static void Clear();
+
+    static uint64_t GetHitCount();
+    static uint64_t GetMissCount();
+    static void LogStatistics();
+};
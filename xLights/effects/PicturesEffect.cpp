@@ -31,6 +31,7 @@
 #include "../UtilFunctions.h"
 #include "../ExternalHooks.h"
 #include "GIFImage.h"
+#include "PictureFrameCache.h"
 #include "../xLightsMain.h" 
 
 #include <log4cpp/Category.hh>
@@ -248,7 +249,7 @@ typedef std::vector< std::pair<wxPoint, xlColor> > PixelVector;
 
 class PicturesRenderCache : public EffectRenderCache {
 public:
-    PicturesRenderCache() : imageCount(0), frame(0),  gifImage(nullptr), maxmovieframes(0) {};
+    PicturesRenderCache() : imageCount(0), frame(0), rawFrame(0), rawFlags(0), gifImage(nullptr), maxmovieframes(0) {};
     virtual ~PicturesRenderCache()
     {
         if (gifImage != nullptr) {
@@ -257,12 +258,15 @@ public:
         }
     };
 
-    wxImage image;
-    wxImage rawimage;
+    PictureFrameCache::ImagePtr image;
+    PictureFrameCache::ImagePtr rawimage;
     int imageCount;
     int frame;
+    int rawFrame;
+    int rawFlags;
     int maxmovieframes;
     wxString PictureName;
+    std::string fileKey;
     GIFImage* gifImage;
     std::vector<PixelVector> PixelsByFrame;
 };
@@ -276,6 +280,43 @@ static PicturesRenderCache *GetCache(RenderBuffer &buf) {
     return cache;
 }
 
+// Rescale the current frame of the picture. Sizes that are reused every frame are shared with any other
+// effects showing the same frame at the same size but the sizes a zoom passes through once are not cached
+// as they would only push out the frames worth keeping.
+static void ScaleImage(PicturesRenderCache* cache, int width, int height, bool share = true)
+{
+    // Scale would hand back another reference to the shared raw image and wxImage reference counts are not thread safe
+    if (width == cache->rawimage->GetWidth() && height == cache->rawimage->GetHeight()) {
+        cache->image = cache->rawimage;
+        return;
+    }
+
+    int flags = cache->rawFlags;
+#ifdef __WXMSW__
+    flags |= PictureFrameCache::FLAG_QUALITY_BILINEAR;
+#endif
+    if (share) {
+        cache->image = PictureFrameCache::Get(cache->fileKey, cache->rawFrame, width, height, flags);
+        if (cache->image != nullptr) {
+            return;
+        }
+    }
+
+// work around wxWidgets image rescaling bug on windows in VS release builds
+#ifdef __WXMSW__
+    wxImage image = cache->rawimage->Scale(width, height, wxIMAGE_QUALITY_BILINEAR); // I tried bicubic but it creates visual artefacts
+#else
+    wxImage image = cache->rawimage->Scale(width, height);
+#endif
+    cache->image = nullptr;
+    if (share) {
+        cache->image = PictureFrameCache::Put(cache->fileKey, cache->rawFrame, width, height, flags, image);
+    }
+    if (cache->image == nullptr) {
+        cache->image = std::make_shared<const wxImage>(image);
+    }
+}
+
 //Vixen channel remap from Vixen 2.x back to xLights:
 //for use when you have cell-by-cell Vixen 2.x sequencing that you want to preserve in an xLights sequence
 //how it works:
@@ -294,12 +335,10 @@ void PicturesEffect::LoadPixelsFromTextFile(RenderBuffer &buffer, wxFile& debug,
     wxByte rgb[3] = { 0,0,0 };
     PicturesRenderCache *cache = GetCache(buffer);
     cache->imageCount = 0;
-    wxImage &image = cache->image;
-    wxImage &rawimage = cache->rawimage;
     std::vector<PixelVector> &PixelsByFrame = cache->PixelsByFrame;
 
-    if (image.GetWidth() && image.GetHeight()) image.Clear(); //CAUTION: image must be non-empty to clear it (memory error otherwise)
-    if (rawimage.GetWidth() && rawimage.GetHeight()) rawimage.Clear(); //CAUTION: image must be non-empty to clear it (memory error otherwise)
+    cache->image.reset();
+    cache->rawimage.reset();
 
     if (!cache->PictureName.CmpNoCase(filename)) { wrdebug("no change: " + filename); return; }
     if (!FileExists(filename)) { wrdebug("not found: " + filename); return; }
@@ -513,8 +552,8 @@ void PicturesEffect::Render(RenderBuffer& buffer,
     bool noImageFile = false;
 
     PicturesRenderCache* cache = GetCache(buffer);
-    wxImage& image = cache->image;
-    wxImage& rawimage = cache->rawimage;
+    PictureFrameCache::ImagePtr& image = cache->image;
+    PictureFrameCache::ImagePtr& rawimage = cache->rawimage;
 
     if (NewPictureName2.length() == 0) {
         noImageFile = true;
@@ -602,7 +641,8 @@ void PicturesEffect::Render(RenderBuffer& buffer,
 #ifdef LINUX
                 logger_base.debug("About to count images in bitmap %s.", (const char*)NewPictureName.c_str());
 #endif
-                cache->imageCount = wxImage::GetImageCount(NewPictureName);
+                cache->fileKey = PictureFrameCache::GetFileKey(NewPictureName.ToStdString());
+                cache->imageCount = PictureFrameCache::GetImageCount(cache->fileKey, NewPictureName.ToStdString());
                 if (cache->imageCount <= 0) {
                     logger_base.error("Image %s reports %d frames which is invalid. Overriding it to be 1.", (const char*)NewPictureName.c_str(), cache->imageCount);
 
@@ -610,9 +650,17 @@ void PicturesEffect::Render(RenderBuffer& buffer,
                     cache->imageCount = 1;
                 }
 
-                if (!image.LoadFile(NewPictureName, wxBITMAP_TYPE_ANY, 0)) {
-                    logger_base.error("Error loading image file: %s.", (const char*)NewPictureName.c_str());
-                    image.Create(5, 5, true);
+                cache->rawFrame = 0;
+                cache->rawFlags = 0;
+                image = PictureFrameCache::Get(cache->fileKey, 0, 0, 0, 0);
+                if (image == nullptr) {
+                    wxImage loaded;
+                    if (loaded.LoadFile(NewPictureName, wxBITMAP_TYPE_ANY, 0)) {
+                        image = PictureFrameCache::Put(cache->fileKey, 0, 0, 0, 0, loaded);
+                    } else {
+                        logger_base.error("Error loading image file: %s.", (const char*)NewPictureName.c_str());
+                        image = std::make_shared<const wxImage>(5, 5, true);
+                    }
                 }
 
                 rawimage = image;
@@ -633,13 +681,17 @@ void PicturesEffect::Render(RenderBuffer& buffer,
                         gifImage = nullptr;
                         cache->imageCount = 1;
                     } else {
-                        image = gifImage->GetFrame(0);
+                        cache->rawFlags = PictureFrameCache::FLAG_GIF_FRAME | (suppressGIFBackground ? PictureFrameCache::FLAG_SUPPRESS_GIF_BACKGROUND : 0);
+                        image = PictureFrameCache::Get(cache->fileKey, 0, 0, 0, cache->rawFlags);
+                        if (image == nullptr) {
+                            image = PictureFrameCache::Put(cache->fileKey, 0, 0, 0, cache->rawFlags, gifImage->GetFrame(0));
+                        }
                         rawimage = image;
                     }
                 }
             }
         }
-        if (!noImageFile && !image.IsOk()) {
+        if (!noImageFile && (image == nullptr || !image->IsOk())) {
             noImageFile = true;
         }
         if (!noImageFile && cache->imageCount > 1) {
@@ -647,17 +699,27 @@ void PicturesEffect::Render(RenderBuffer& buffer,
             //animated Gif,
             scale_image = true;
 
+            int ii;
             if (loopGIF) {
-                image = gifImage->GetFrameForTime((buffer.curPeriod - buffer.curEffStartPer) * buffer.frameTimeInMs * frameRateAdj, true);
+                ii = gifImage->GetFrameIndexForTime((buffer.curPeriod - buffer.curEffStartPer) * buffer.frameTimeInMs * frameRateAdj, true);
             }
             else {
-                int ii = cache->imageCount * buffer.GetEffectTimeIntervalPosition(frameRateAdj) * 0.99;
-                image = gifImage->GetFrame(ii);
+                ii = cache->imageCount * buffer.GetEffectTimeIntervalPosition(frameRateAdj) * 0.99;
+            }
+
+            cache->rawFrame = ii;
+            if (ii < 0) {
+                image = std::make_shared<const wxImage>(gifImage->GetSize());
+            } else {
+                image = PictureFrameCache::Get(cache->fileKey, ii, 0, 0, cache->rawFlags);
+                if (image == nullptr) {
+                    image = PictureFrameCache::Put(cache->fileKey, ii, 0, 0, cache->rawFlags, gifImage->GetFrame(ii));
+                }
             }
 
             rawimage = image;
 
-            if (!rawimage.IsOk()) {
+            if (rawimage == nullptr || !rawimage->IsOk()) {
                 noImageFile = true;
             }
         }
@@ -677,39 +739,27 @@ void PicturesEffect::Render(RenderBuffer& buffer,
         scale_image = true;
     }
 
-    int imgwidth = image.GetWidth();
-    int imght = image.GetHeight();
+    int imgwidth = image->GetWidth();
+    int imght = image->GetHeight();
     int yoffset = (BufferHt + imght) / 2; //centered if sizes don't match
     int xoffset = (imgwidth - BufferWi) / 2; //centered if sizes don't match
 
     if (scale_to_fit == "Scale To Fit" && (BufferWi != imgwidth || BufferHt != imght)) {
-        image = rawimage;
-// work around wxWidgets image rescaling bug on windows in VS release builds
-#ifdef __WXMSW__
-        image.Rescale(BufferWi, BufferHt, wxIMAGE_QUALITY_BILINEAR); // I tried bicubic but it creates visual artefacts
-#else
-        image.Rescale(BufferWi, BufferHt);
-#endif
-        imgwidth = image.GetWidth();
-        imght = image.GetHeight();
+        ScaleImage(cache, BufferWi, BufferHt);
+        imgwidth = image->GetWidth();
+        imght = image->GetHeight();
         yoffset = (BufferHt + imght) / 2; //centered if sizes don't match
         xoffset = (imgwidth - BufferWi) / 2; //centered if sizes don't match
     }
     else if (scale_to_fit == "Scale Keep Aspect Ratio" || scale_to_fit == "Scale Keep Aspect Ratio Crop") {
-        image = rawimage;
-        float xr = (float)BufferWi / (float)image.GetWidth();
-        float yr = (float)BufferHt / (float)image.GetHeight();
+        float xr = (float)BufferWi / (float)rawimage->GetWidth();
+        float yr = (float)BufferHt / (float)rawimage->GetHeight();
         float sc = std::min(xr, yr);
         if(scale_to_fit.find("Crop") != std::string::npos)
             sc = std::max(xr, yr);
-// work around wxWidgets image rescaling bug on windows in VS release builds
-#ifdef __WXMSW__
-        image.Rescale(image.GetWidth() * sc, image.GetHeight() * sc, wxIMAGE_QUALITY_BILINEAR); // I tried bicubic but it creates visual artefacts
-#else
-        image.Rescale(image.GetWidth() * sc, image.GetHeight() * sc);
-#endif
-        imgwidth = image.GetWidth();
-        imght = image.GetHeight();
+        ScaleImage(cache, rawimage->GetWidth() * sc, rawimage->GetHeight() * sc);
+        imgwidth = image->GetWidth();
+        imght = image->GetHeight();
         yoffset = (BufferHt + imght) / 2; //centered if sizes don't match
         xoffset = (imgwidth - BufferWi) / 2; //centered if sizes don't match
     }
@@ -717,15 +767,11 @@ void PicturesEffect::Render(RenderBuffer& buffer,
         if ((start_scale != 100 || end_scale != 100) && scale_image) {
             int delta_scale = end_scale - start_scale;
             int current_scale = start_scale + delta_scale * position;
-            imgwidth = (image.GetWidth() * current_scale) / 100;
-            imght = (image.GetHeight() * current_scale) / 100;
+            imgwidth = (image->GetWidth() * current_scale) / 100;
+            imght = (image->GetHeight() * current_scale) / 100;
             imgwidth = std::max(imgwidth, 1);
             imght = std::max(imght, 1);
-#ifdef __WXMSW__
-            image.Rescale(imgwidth, imght, wxIMAGE_QUALITY_BILINEAR); // I tried bicubic but it creates visual artefacts
-#else
-            image.Rescale(imgwidth, imght);
-#endif
+            ScaleImage(cache, imgwidth, imght, start_scale == end_scale);
             yoffset = (BufferHt + imght) / 2; //centered if sizes don't match
             xoffset = (imgwidth - BufferWi) / 2; //centered if sizes don't match
         }
@@ -796,16 +842,16 @@ void PicturesEffect::Render(RenderBuffer& buffer,
     }
     // copy image to buffer
     xlColor c;
-    bool hasAlpha = image.HasAlpha();
+    bool hasAlpha = image->HasAlpha();
 
     int calc_position_wi = (imgwidth + BufferWi) * position;
     int calc_position_ht = (imght + BufferHt) * position;
 
     for (int x = 0; x < imgwidth; x++) {
         for (int y = 0; y < imght; y++) {
-            if (!image.IsTransparent(x, y)) {
-                unsigned char alpha = hasAlpha ? image.GetAlpha(x, y) : 255;
-                c.Set(image.GetRed(x, y), image.GetGreen(x, y), image.GetBlue(x, y), alpha);
+            if (!image->IsTransparent(x, y)) {
+                unsigned char alpha = hasAlpha ? image->GetAlpha(x, y) : 255;
+                c.Set(image->GetRed(x, y), image->GetGreen(x, y), image->GetBlue(x, y), alpha);
                 if (!buffer.allowAlpha && alpha < 64) {
                     //almost transparent, but this mix doesn't support transparent unless it's black;
                     c = xlBLACK;
@@ -12,6 +12,7 @@
 
 #include "BulkEditControls.h"
 #include "RenderBuffer.h"
+#include "../RenderArena.h"
 #include "SketchEffectDrawing.h"
 #include "SketchPanel.h"
 #include "assist/AssistPanel.h"
@@ -90,8 +91,10 @@ void SketchEffect::Render(Effect* /*effect*/, const SettingsMap& settings, Rende
     //
     int bw = buffer.BufferWi;
     int bh = buffer.BufferHt;
-    std::vector<uint8_t> rgb(bw * 3 * bh);
-    std::vector<uint8_t> alpha(bw * bh);
+    // the image only borrows these so they can come from the arena
+    RenderArena::Scope scope;
+    uint8_t* rgb = buffer.GetArena().AllocateArray<uint8_t>(bw * 3 * bh);
+    uint8_t* alpha = buffer.GetArena().AllocateArray<uint8_t>(bw * bh);
     xlColor* px = buffer.GetPixels();
     int pxIndex = 0;
     int rgbIndex = 0;
@@ -106,7 +109,7 @@ void SketchEffect::Render(Effect* /*effect*/, const SettingsMap& settings, Rende
             alpha[alphaIndex++] = px[pxIndex].Alpha();
         }
     }
-    wxImage img(bw, bh, rgb.data(), alpha.data(), true);
+    wxImage img(bw, bh, rgb, alpha, true);
 
     //
     // rendering sketch via wxGraphicsContext
@@ -706,6 +706,14 @@ struct CachedTextInfoHasher {
     }
 };
 
+// Text drawn once on a canvas with room for all of it, textX/textY are where DrawLabel placed the text
+class CachedTextRaster {
+public:
+    wxImage image;
+    int textX = 0;
+    int textY = 0;
+};
+
 class TextRenderCache : public EffectRenderCache {
 public:
     TextRenderCache() : timer_countdown(0), synced_textsize(wxSize(0,0)) {};
@@ -717,11 +725,12 @@ public:
     int timer_countdown;
     wxSize synced_textsize;
     
-    wxImage *GetImage(const CachedTextInfo &inf) {
-        return textCache[inf];
+    CachedTextRaster *GetRaster(const CachedTextInfo &inf) {
+        auto it = textCache.find(inf);
+        return it == textCache.end() ? nullptr : it->second;
     }
-    void PutImage(const CachedTextInfo &inf, wxImage *img) {
-        textCache[inf] = img;
+    void PutRaster(const CachedTextInfo &inf, CachedTextRaster *raster) {
+        textCache[inf] = raster;
     }
     
     wxSize GetMultiLineTextExtent(const std::string &font, const wxString &msg) {
@@ -737,7 +746,7 @@ public:
         textExtentCache[key] = sz;
     }
     
-    std::unordered_map<CachedTextInfo, wxImage*, CachedTextInfoHasher> textCache;
+    std::unordered_map<CachedTextInfo, CachedTextRaster*, CachedTextInfoHasher> textCache;
     std::map<std::pair<std::string, wxString>, wxSize> textExtentCache;
 };
 
@@ -932,6 +941,67 @@ TextRenderCache *GetCache(RenderBuffer &buffer, int id) {
     return cache;
 }
 
+// Draw the text centred in a buffer sized rect on a canvas padded so none of it is clipped
+static CachedTextRaster *RasterizeText(const wxString &msg, const std::string &fontString, const std::vector<xlColor> &colors,
+                                       const wxSize &textsize, int width, int height, TextRenderCache *cache)
+{
+    TextDrawingContext *dc = TextDrawingContext::GetContext();
+    if (dc == nullptr) {
+        return nullptr;
+    }
+
+    // glyphs can overhang their extents so allow some room beyond the text
+    int padX = std::max(0, (textsize.x - width) / 2) + textsize.y / 2 + 2;
+    int padY = std::max(0, (textsize.y - height) / 2) + textsize.y / 2 + 2;
+    wxRect rect(padX, padY, width, height);
+
+    dc->ResetSize(width + padX * 2, height + padY * 2);
+    dc->Clear();
+    SetFont(dc, fontString, colors[0]);
+    DrawLabel(dc, msg, rect, wxALIGN_CENTER_HORIZONTAL|wxALIGN_CENTER_VERTICAL, cache, fontString, colors);
+
+    CachedTextRaster *raster = new CachedTextRaster();
+    raster->image = dc->FlushAndGetImage()->Copy();
+    raster->textX = (rect.GetLeft() + rect.GetRight() + 1 - textsize.x) / 2;
+    raster->textY = (rect.GetTop() + rect.GetBottom() + 1 - textsize.y) / 2;
+    TextDrawingContext::ReleaseContext(dc);
+    return raster;
+}
+
+// Copy the raster to the buffer with the text moved dx, dy from where it was drawn
+static void BlitText(RenderBuffer &buffer, const CachedTextRaster &raster, int dx, int dy)
+{
+    const wxImage &img = raster.image;
+    bool ha = img.HasAlpha();
+    const unsigned char *data = img.GetData();
+    const unsigned char *alpha = ha ? img.GetAlpha() : nullptr;
+    int w = img.GetWidth();
+    int h = img.GetHeight();
+    xlColor clear(0, 0, 0, 0);
+    xlColor c;
+    for (int row = 0; row < buffer.BufferHt; row++) {
+        int sy = row - dy;
+        int y = buffer.BufferHt - 1 - row;
+        for (int x = 0; x < buffer.BufferWi; x++) {
+            int sx = x - dx;
+            if (sx < 0 || sx >= w || sy < 0 || sy >= h) {
+                buffer.SetPixel(x, y, clear);
+                continue;
+            }
+            int idx = sy * w + sx;
+            if (ha) {
+                c.Set(data[idx * 3], data[idx * 3 + 1], data[idx * 3 + 2], alpha[idx]);
+            } else {
+                c.Set(data[idx * 3], data[idx * 3 + 1], data[idx * 3 + 2]);
+                if (c == xlBLACK) {
+                    c.alpha = 0;
+                }
+            }
+            buffer.SetPixel(x, y, c);
+        }
+    }
+}
+
 //jwylie - 2016-11-01  -- enhancement: add minute seconds countdown
 wxImage *TextEffect::RenderTextLine(RenderBuffer &buffer,
                                     TextDrawingContext* dc,
@@ -1111,18 +1181,21 @@ wxImage *TextEffect::RenderTextLine(RenderBuffer &buffer,
         if (colors.size() == 0) {
             colors.push_back(xlWHITE);
         }
-        CachedTextInfo inf(msg.ToStdString(), fontString, colors, rect);
-        wxImage *img = GetCache(buffer,id)->GetImage(inf);
-        if (img == nullptr) {
-            dc->Clear();
-            SetFont(dc, fontString, colors[0]);
-            DrawLabel(dc, msg, rect, wxALIGN_CENTER_HORIZONTAL|wxALIGN_CENTER_VERTICAL, GetCache(buffer,id), fontString, colors);
-            wxImage *i2 = dc->FlushAndGetImage();
-            img = new wxImage(i2->GetSize());
-            *img = i2->Copy();
-            GetCache(buffer,id)->PutImage(inf, img);
+        // Scrolling only moves the text so it is rasterized once per message and blitted at this frame's
+        // position, worked out the same way DrawLabel centres text in the rect
+        CachedTextInfo inf(msg.ToStdString(), fontString, colors, wxRect(0, 0, buffer.BufferWi, buffer.BufferHt));
+        CachedTextRaster *raster = cache->GetRaster(inf);
+        if (raster == nullptr) {
+            raster = RasterizeText(msg, fontString, colors, textsize, buffer.BufferWi, buffer.BufferHt, cache);
+            if (raster == nullptr) {
+                return nullptr;
+            }
+            cache->PutRaster(inf, raster);
         }
-        return img;
+        int x = (rect.GetLeft() + rect.GetRight() + 1 - textsize.x) / 2;
+        int y = (rect.GetTop() + rect.GetBottom() + 1 - textsize.y) / 2;
+        BlitText(buffer, *raster, x - raster->textX, y - raster->textY);
+        return nullptr;
     }
     
     xlColor c;
@@ -1494,8 +1567,7 @@ void TextEffect::RenderXLText(Effect* effect, const SettingsMap& settings, Rende
     font_mgr.init();  // make sure font class is initialized
     wxString xl_font = settings["CHOICE_Text_Font"];
     xlFont* font = font_mgr.get_font(xl_font);
-    wxBitmap* bmp = font->get_bitmap();
-    wxImage image = bmp->ConvertToImage();
+    const wxImage& image = font->get_image();
     int char_width = font->GetWidth();
     int char_height = font->GetHeight();
 
@@ -50,6 +50,7 @@ private:
 
     void ReplaceVaribles(wxString& msg, RenderBuffer& buffer) const;
 
+    // Returns the image to copy to the buffer or nullptr if the text was drawn straight into the buffer
     wxImage* RenderTextLine(RenderBuffer& buffer,
         TextDrawingContext* dc,
         const wxString& Line_orig,
@@ -402,7 +402,7 @@ void BoxedScreenLocation::UpdateBoundingBox(const std::vector<NodeBaseClassPtr>
         aabb_max = glm::vec3(0.0f, 0.0f, 0.0f);
 
         for (const auto& it : Nodes) {
-            for (const auto& coord : it.get()->Coords) {
+            for (const auto& coord : std::as_const(it.get()->Coords)) {
 
                 float sx = coord.screenX;
                 float sy = coord.screenY;
@@ -49,6 +49,7 @@
 #include "../ExternalHooks.h"
 #include "CustomModel.h"
 #include "RulerObject.h"
+#include "RenderBufferNodeCache.h"
 
 #include <log4cpp/Category.hh>
 
@@ -135,6 +136,7 @@ Model::Model(const ModelManager& manager) : modelManager(manager)
 
 Model::~Model()
 {
+    RenderBufferNodeCache::Invalidate(this);
     deleteUIObjects();
     if (modelDimmingCurve != nullptr) {
         delete modelDimmingCurve;
@@ -2752,6 +2754,7 @@ std::list<int> Model::ParseFaceNodes(std::string channels)
 
 void Model::SetFromXml(wxXmlNode* ModelNode, bool zb)
 {
+    RenderBufferNodeCache::Invalidate(this);
 
     if (modelDimmingCurve != nullptr) {
         delete modelDimmingCurve;
@@ -5179,7 +5182,7 @@ wxString Model::GetNodeNear(ModelPreview* preview, wxPoint pt, bool flip)
 
     int i = 1;
     for (const auto& it : Nodes) {
-        auto c = it.get()->Coords;
+        const auto& c = std::as_const(it.get()->Coords);
         for (const auto& it2 : c) {
             float sx = it2.screenX;
             float sy = it2.screenY;
@@ -5236,7 +5239,7 @@ std::vector<int> Model::GetNodesInBoundingBox(ModelPreview* preview, wxPoint sta
 
     int i = 1;
     for (const auto& it : Nodes) {
-        auto c = it.get()->Coords;
+        const auto& c = std::as_const(it.get()->Coords);
         for (const auto& it2 : c) {
             float sx = it2.screenX;
             float sy = it2.screenY;
@@ -7127,7 +7130,7 @@ void Model::GetMinScreenXY(float& minx, float& miny) const
     miny = 99999999.0f;
     for (const auto& it : Nodes)
     {
-        for (const auto& it2 : it->Coords)
+        for (const auto& it2 : std::as_const(it->Coords))
         {
             minx = std::min(minx, it2.screenX);
             miny = std::min(miny, it2.screenY);
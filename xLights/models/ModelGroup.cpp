@@ -15,6 +15,7 @@
 #include "ModelGroup.h"
 #include "ModelManager.h"
 #include "SingleLineModel.h"
+#include "RenderBufferNodeCache.h"
 #include "ModelScreenLocation.h"
 #include "../UtilFunctions.h"
 
@@ -422,6 +423,7 @@ int ModelGroup::GetYCentreOffset() const
 }
 
 bool ModelGroup::Reset(bool zeroBased) {
+    RenderBufferNodeCache::Invalidate(this);
     this->zeroBased = zeroBased;
     selected = false;
     name = ModelXml->GetAttribute("name").Trim(true).Trim(false).ToStdString();
@@ -15,6 +15,7 @@
 #include <cmath>
 #include <memory>
 #include <algorithm>
+#include <utility>
 
 #include "../Color.h"
 
@@ -42,10 +43,76 @@ public:
         float screenX, screenY, screenZ;
     };
 
+    // The coordinates of a node, shared between copies of the node until one of them is modified.
+    //
+    // Render buffers are built by cloning the model's nodes and most buffers never move them so this avoids
+    // copying every coordinate of every node each time a buffer is set up. Any non const access takes a
+    // private copy first so code which reads coordinates on a render thread should do so through a const
+    // reference to avoid the copy.
+    class CoordList
+    {
+    public:
+        typedef std::vector<CoordStruct>::iterator iterator;
+        typedef std::vector<CoordStruct>::const_iterator const_iterator;
+        typedef CoordStruct value_type;
+        typedef size_t size_type;
+
+        CoordList() {}
+        CoordList(const CoordList& c) : _coords(c._coords) {}
+        CoordList& operator=(const CoordList& c) { _coords = c._coords; return *this; }
+
+        const std::vector<CoordStruct>& Get() const
+        {
+            static const std::vector<CoordStruct> empty;
+            return _coords == nullptr ? empty : *_coords;
+        }
+        operator const std::vector<CoordStruct>&() const { return Get(); }
+
+        size_t size() const { return Get().size(); }
+        bool empty() const { return Get().empty(); }
+        const_iterator begin() const { return Get().begin(); }
+        const_iterator end() const { return Get().end(); }
+        const_iterator cbegin() const { return Get().begin(); }
+        const_iterator cend() const { return Get().end(); }
+        const CoordStruct& operator[](size_t i) const { return Get()[i]; }
+        const CoordStruct& front() const { return Get().front(); }
+        const CoordStruct& back() const { return Get().back(); }
+
+        iterator begin() { return Mutable().begin(); }
+        iterator end() { return Mutable().end(); }
+        CoordStruct& operator[](size_t i) { return Mutable()[i]; }
+        CoordStruct& front() { return Mutable().front(); }
+        CoordStruct& back() { return Mutable().back(); }
+        void resize(size_t n) { Mutable().resize(n); }
+        void reserve(size_t n) { Mutable().reserve(n); }
+        void push_back(const CoordStruct& c) { Mutable().push_back(c); }
+        iterator erase(const_iterator it)
+        {
+            // the iterator may refer to the shared copy so work out where it points before taking our own
+            auto offset = it - Get().begin();
+            auto& coords = Mutable();
+            return coords.erase(coords.begin() + offset);
+        }
+        void clear() { _coords.reset(); }
+
+    private:
+        std::vector<CoordStruct>& Mutable()
+        {
+            if (_coords == nullptr) {
+                _coords = std::make_shared<std::vector<CoordStruct>>();
+            } else if (_coords.use_count() > 1) {
+                _coords = std::make_shared<std::vector<CoordStruct>>(*_coords);
+            }
+            return *_coords;
+        }
+
+        std::shared_ptr<std::vector<CoordStruct>> _coords;
+    };
+
     uint32_t ActChan = 0;   // 0 is the first channel
     uint32_t sparkle = 0;
     uint32_t StringNum = 0; // node is part of this string (0 is the first string)
-    std::vector<CoordStruct> Coords;
+    CoordList Coords;
     std::string *name = nullptr;
     const Model *model = nullptr;
     xlColor _maskColor = xlWHITE;
@@ -0,0 +1,159 @@
+/***************************************************************
+ * This source files comes from the xLights project
+ * https://www.xlights.org
+ * https://github.com/smeighan/xLights
+ * See the github commit history for a record of contributing
+ * developers.
+ * Copyright claimed based on commit dates recorded in Github
+ * License: https://github.com/smeighan/xLights/blob/master/License.txt
+ **************************************************************/
+
+#include "RenderBufferNodeCache.h"
+#include "Model.h"
+#include "ModelGroup.h"
+#include "SubModel.h"
+#include "../xLightsApp.h"
+#include "../xLightsMain.h"
+
+// Once the cached mappings hold this many nodes in total the cache is emptied and starts again
+#define RENDER_BUFFER_NODE_CACHE_MAX_NODES (4 * 1024 * 1024)
+
+std::mutex RenderBufferNodeCache::__lock;
+std::map<RenderBufferNodeCache::Key, std::shared_ptr<const RenderBufferNodeCache::Entry>> RenderBufferNodeCache::__entries;
+size_t RenderBufferNodeCache::__nodeCount = 0;
+
+void RenderBufferNodeCache::GetSignature(const Model* model, Signature& signature)
+{
+    // moving, rotating or resizing a model in the layout does not always change its change count but it does
+    // change the buffer a per preview or camera style builds so the location is part of the signature
+    ModelState state;
+    state.model = model;
+    state.changeCount = model->GetChangeCount();
+    const auto& loc = model->GetModelScreenLocation();
+    auto pos = loc.GetWorldPosition();
+    auto rot = loc.GetRotation();
+    auto scale = loc.GetScaleMatrix();
+    state.location = { pos.x, pos.y, pos.z, rot.x, rot.y, rot.z, scale.x, scale.y, scale.z,
+                       loc.GetLeft(), loc.GetRight(), loc.GetTop(), loc.GetBottom(), loc.GetFront(), loc.GetBack(),
+                       loc.GetRenderWi(), loc.GetRenderHt(), loc.GetRenderDp() };
+    signature.push_back(std::move(state));
+
+    const SubModel* sm = dynamic_cast<const SubModel*>(model);
+    if (sm != nullptr && sm->GetParent() != nullptr) {
+        GetSignature(sm->GetParent(), signature);
+    }
+
+    const ModelGroup* mg = dynamic_cast<const ModelGroup*>(model);
+    if (mg != nullptr) {
+        for (const auto& it : mg->ActiveModels()) {
+            GetSignature(it, signature);
+        }
+    }
+}
+
+void RenderBufferNodeCache::GetCameraState(const std::string& camera, std::vector<float>& state)
+{
+    // a named camera can be moved without being renamed so its settings are part of the key
+    state.clear();
+    if (camera == "2D" || xLightsApp::GetFrame() == nullptr) {
+        return;
+    }
+    PreviewCamera* pcamera = xLightsApp::GetFrame()->viewpoint_mgr.GetNamedCamera3D(camera);
+    if (pcamera == nullptr) {
+        return;
+    }
+    state = { pcamera->GetPosX(), pcamera->GetPosY(), pcamera->GetPosZ(),
+              pcamera->GetAngleX(), pcamera->GetAngleY(), pcamera->GetAngleZ(),
+              pcamera->GetDistance(), pcamera->GetZoom(),
+              pcamera->GetPanX(), pcamera->GetPanY(), pcamera->GetPanZ(),
+              pcamera->GetZoomCorrX(), pcamera->GetZoomCorrY(), pcamera->GetIs3D() };
+}
+
+// The copies share their coordinates with the originals so this only allocates the nodes themselves
+void RenderBufferNodeCache::CopyNodes(const std::vector<NodeBaseClassPtr>& from, std::vector<NodeBaseClassPtr>& to)
+{
+    to.clear();
+    to.reserve(from.size());
+    for (const auto& it : from) {
+        to.push_back(NodeBaseClassPtr(it->clone()));
+    }
+}
+
+void RenderBufferNodeCache::InitRenderBufferNodes(const Model* model, const std::string& type, const std::string& camera, const std::string& transform,
+                                                  std::vector<NodeBaseClassPtr>& Nodes, int& BufferWi, int& BufferHi, bool deep)
+{
+    std::vector<float> cameraState;
+    GetCameraState(camera, cameraState);
+    Key key(model, type, camera, std::move(cameraState), transform, deep);
+    Signature signature;
+    GetSignature(model, signature);
+
+    std::shared_ptr<const Entry> entry;
+    {
+        std::unique_lock<std::mutex> lock(__lock);
+        auto it = __entries.find(key);
+        if (it != __entries.end()) {
+            if (it->second->signature == signature) {
+                entry = it->second;
+            } else {
+                __nodeCount -= it->second->nodes.size();
+                __entries.erase(it);
+            }
+        }
+    }
+
+    if (entry != nullptr) {
+        // the entry is never modified once cached so it can be copied without holding the lock
+        CopyNodes(entry->nodes, Nodes);
+        BufferWi = entry->bufferWi;
+        BufferHi = entry->bufferHi;
+        return;
+    }
+
+    model->InitRenderBufferNodes(type, camera, transform, Nodes, BufferWi, BufferHi, deep);
+
+    auto newEntry = std::make_shared<Entry>();
+    newEntry->signature = std::move(signature);
+    CopyNodes(Nodes, newEntry->nodes);
+    newEntry->bufferWi = BufferWi;
+    newEntry->bufferHi = BufferHi;
+
+    std::unique_lock<std::mutex> lock(__lock);
+    if (__nodeCount + newEntry->nodes.size() > RENDER_BUFFER_NODE_CACHE_MAX_NODES) {
+        __entries.clear();
+        __nodeCount = 0;
+    }
+    auto& slot = __entries[key];
+    if (slot != nullptr) {
+        __nodeCount -= slot->nodes.size();
+    }
+    __nodeCount += newEntry->nodes.size();
+    slot = newEntry;
+}
+
+void RenderBufferNodeCache::Invalidate(const Model* model)
+{
+    std::unique_lock<std::mutex> lock(__lock);
+    for (auto it = __entries.begin(); it != __entries.end();) {
+        bool uses = false;
+        for (const auto& s : it->second->signature) {
+            if (s.model == model) {
+                uses = true;
+                break;
+            }
+        }
+        if (uses) {
+            __nodeCount -= it->second->nodes.size();
+            it = __entries.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void RenderBufferNodeCache::Clear()
+{
+    std::unique_lock<std::mutex> lock(__lock);
+    __entries.clear();
+    __nodeCount = 0;
+}
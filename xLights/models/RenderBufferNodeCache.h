@@ -0,0 +1,73 @@
+#pragma once
+
+/***************************************************************
+ * This source files comes from the xLights project
+ * https://www.xlights.org
+ * https://github.com/smeighan/xLights
+ * See the github commit history for a record of contributing
+ * developers.
+ * Copyright claimed based on commit dates recorded in Github
+ * License: https://github.com/smeighan/xLights/blob/master/License.txt
+ **************************************************************/
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "Node.h"
+
+class Model;
+
+// Process wide cache of the nodes Model::InitRenderBufferNodes produces for a buffer style, camera and transform.
+//
+// Building these for a large group means cloning and transforming every member's nodes so sequences which switch
+// between buffer styles rebuild the same mapping over and over. Cached mappings are immutable and shared between
+// render threads. Each buffer gets its own nodes so it can set their colours but the node coordinates are shared
+// with the cached mapping until the buffer changes them. An entry is only used while the change count and location
+// of the model and every model it was built from, and the settings of the camera, are unchanged.
+class RenderBufferNodeCache
+{
+public:
+    // Fills Nodes, BufferWi and BufferHi from the cache, building and caching the mapping if required
+    static void InitRenderBufferNodes(const Model* model, const std::string& type, const std::string& camera, const std::string& transform,
+                                      std::vector<NodeBaseClassPtr>& Nodes, int& BufferWi, int& BufferHi, bool deep = false);
+
+    // Drop any mappings built from this model
+    static void Invalidate(const Model* model);
+    static void Clear();
+
+private:
+    typedef std::tuple<const Model*, std::string, std::string, std::vector<float>, std::string, bool> Key;
+
+    struct ModelState
+    {
+        const Model* model = nullptr;
+        unsigned long changeCount = 0;
+        std::vector<float> location;
+
+        bool operator==(const ModelState& other) const
+        {
+            return model == other.model && changeCount == other.changeCount && location == other.location;
+        }
+    };
+    typedef std::vector<ModelState> Signature;
+
+    struct Entry
+    {
+        Signature signature;
+        std::vector<NodeBaseClassPtr> nodes;
+        int bufferWi = 0;
+        int bufferHi = 0;
+    };
+
+    static void GetSignature(const Model* model, Signature& signature);
+    static void GetCameraState(const std::string& camera, std::vector<float>& state);
+    static void CopyNodes(const std::vector<NodeBaseClassPtr>& from, std::vector<NodeBaseClassPtr>& to);
+
+    static std::mutex __lock;
+    static std::map<Key, std::shared_ptr<const Entry>> __entries;
+    static size_t __nodeCount;
+};
@@ -118,7 +118,7 @@ SubModel::SubModel(Model* p, wxXmlNode* n) :
                 // ignore nodes indexes if they are out of range
                 if (idx < p->Nodes.size()) {
                     NodeBaseClass* node = p->Nodes[idx]->clone();
-                    for (const auto& c : node->Coords) {
+                    for (const auto& c : std::as_const(node->Coords)) {
                         if (c.bufX < minx)
                             minx = c.bufX;
                         if (c.bufY < miny)
@@ -282,7 +282,7 @@ SubModel::SubModel(Model* p, wxXmlNode* n) :
         for (int m = 0; m < nn; m++) {
             if (p->IsNodeInBufferRange(m, x1, y1, x2, y2)) {
                 NodeBaseClass* node = p->Nodes[m]->clone();
-                for (const auto& c : node->Coords) {
+                for (const auto& c : std::as_const(node->Coords)) {
 
                     if (c.bufX < minx) minx = c.bufX;
                     if (c.bufY < miny) miny = c.bufY;
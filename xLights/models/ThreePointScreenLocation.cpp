@@ -691,7 +691,7 @@ void ThreePointScreenLocation::UpdateBoundingBox(const std::vector<NodeBaseClass
             }
 
             for (const auto& it : Nodes) {
-                for (const auto& coord : it.get()->Coords) {
+                for (const auto& coord : std::as_const(it.get()->Coords)) {
 
                     float sx = coord.screenX;
                     float sy = coord.screenY;
@@ -728,7 +728,7 @@ void ThreePointScreenLocation::UpdateBoundingBox(const std::vector<NodeBaseClass
             aabb_min.z = 0.0f;
             aabb_max.z = 0.0f;
             for (const auto& it : Nodes) {
-                for (const auto& coord : it.get()->Coords) {
+                for (const auto& coord : std::as_const(it.get()->Coords)) {
 
                     float sx = coord.screenX;
                     float sy = coord.screenY;
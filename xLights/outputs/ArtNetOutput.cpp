@@ -425,6 +425,16 @@ void ArtNetOutput::SetManyChannels(int32_t channel, unsigned char* data, size_t
     }
 }
 
+void ArtNetOutput::SetManyChannelsChanged(int32_t channel, unsigned char* data, size_t size) {
+
+    if (!_enabled) return;
+    wxASSERT(channel + size <= _channels);
+
+    size_t chs = (std::min)((int32_t)size, _channels - channel);
+    memcpy(&_data[channel + ARTNET_PACKET_HEADERLEN], data, chs);
+    _changed = true;
+}
+
 void ArtNetOutput::AllOff() {
 
     if (!_enabled) return;
@@ -100,6 +100,7 @@ public:
 #pragma region Data Setting
     virtual void SetOneChannel(int32_t channel, unsigned char data) override;
     virtual void SetManyChannels(int32_t channel, unsigned char* data, size_t size) override;
+    virtual void SetManyChannelsChanged(int32_t channel, unsigned char* data, size_t size) override;
     virtual void AllOff() override;
 #pragma endregion
 
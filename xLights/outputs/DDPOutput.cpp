@@ -14,6 +14,7 @@
 #include <wx/xml/xml.h>
 #include <wx/propgrid/propgrid.h>
 #include <wx/propgrid/advprops.h>
+#include <wx/settings.h>
 
 #include "DDPOutput.h"
 #include "OutputManager.h"
@@ -27,11 +28,156 @@
 #include "../Discovery.h"
 #endif
 
+#ifdef __LINUX__
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <climits>
+#include <map>
+#include <mutex>
+
+// All the DDP outputs that send to one controller. The first output able to send does so for all of them
+// as one offset addressed packet stream so contiguous outputs share packets and push is only set once.
+struct DDPStream
+{
+    struct Piece
+    {
+        DDPOutput* _output;
+        int32_t _index;
+        int32_t _length;
+    };
+    struct Packet
+    {
+        int32_t _offset;
+        int32_t _length;
+        std::vector<Piece> _pieces;
+    };
+
+    std::string _key;
+    std::vector<DDPOutput*> _outputs;
+    std::vector<DDPOutput*> _layoutSenders;
+    std::vector<Packet> _packets;
+    std::vector<uint8_t> _buffer;
+    uint8_t _sequenceNum = 1;
+};
+
 #pragma region Static Variables
 bool DDPOutput::__initialised = false;
+static std::map<std::string, DDPStream*> __ddpStreams;
+static std::mutex __ddpStreamsLock;
 #pragma endregion
 
 #pragma region Private Functions
+// the MTU of the route to the controller ... only Linux lets us ask so elsewhere assume standard ethernet
+static int GetPathMTU(const std::string& ip) {
+
+    int mtu = DDP_DEFAULT_MTU;
+#ifdef __LINUX__
+    int s = socket(AF_INET, SOCK_DGRAM, 0);
+    if (s < 0) return mtu;
+
+    struct sockaddr_in addr;
+    memset(&addr, 0x00, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(DDP_PORT);
+    addr.sin_addr.s_addr = inet_addr(ip.c_str());
+    if (connect(s, (struct sockaddr*)&addr, sizeof(addr)) == 0) {
+        int val = 0;
+        socklen_t len = sizeof(val);
+        if (getsockopt(s, IPPROTO_IP, IP_MTU, &val, &len) == 0 && val > 0) {
+            mtu = val;
+        }
+    }
+    close(s);
+#endif
+    return std::min(mtu, DDP_MAX_MTU);
+}
+
+int DDPOutput::GetPayloadSize() const {
+
+    // whole pixels that fit after the IP, UDP and DDP headers
+    int mtuPayload = (_pathMTU - 28 - DDP_PACKET_HEADERLEN) / 3 * 3;
+
+    // a manual size bigger than the path can carry would only be fragmented or dropped
+    if (!_autoPacketSize) return std::max(1, std::min(_channelsPerPacket, mtuPayload));
+
+    // stick to the recommended 480 pixels unless the network carries jumbo frames
+    if (_pathMTU <= DDP_DEFAULT_MTU) return DDP_DEFAULT_CHANNELS_PER_PACKET;
+
+    return mtuPayload;
+}
+
+void DDPOutput::JoinStream() {
+
+    // without kept channel numbers every output starts at offset 0 so they cannot share a stream
+    std::string key = _resolvedIp;
+    if (!_keepChannelNumbers) {
+        key += wxString::Format("#%p", this).ToStdString();
+    }
+
+    std::unique_lock<std::mutex> lock(__ddpStreamsLock);
+    auto& stream = __ddpStreams[key];
+    if (stream == nullptr) {
+        stream = new DDPStream();
+        stream->_key = key;
+    }
+    stream->_outputs.push_back(this);
+    stream->_layoutSenders.clear();
+    _stream = stream;
+}
+
+void DDPOutput::LeaveStream() {
+
+    if (_stream == nullptr) return;
+
+    std::unique_lock<std::mutex> lock(__ddpStreamsLock);
+    auto& outputs = _stream->_outputs;
+    outputs.erase(std::remove(outputs.begin(), outputs.end(), this), outputs.end());
+    _stream->_layoutSenders.clear();
+    if (outputs.empty()) {
+        __ddpStreams.erase(_stream->_key);
+        delete _stream;
+    }
+    _stream = nullptr;
+}
+
+// splits the channels of the outputs into packets ... packets run across outputs where their channels are contiguous
+void DDPOutput::BuildStreamLayout(const std::vector<DDPOutput*>& senders) {
+
+    static log4cpp::Category& logger_base = log4cpp::Category::getInstance(std::string("log_base"));
+
+    int payload = INT_MAX;
+    for (const auto& it : senders) {
+        payload = std::min(payload, it->GetPayloadSize());
+    }
+
+    auto& packets = _stream->_packets;
+    packets.clear();
+    for (const auto& it : senders) {
+        int32_t base = it->_keepChannelNumbers ? it->_startChannel - 1 : 0;
+        int32_t index = 0;
+        while (index < it->_channels) {
+            if (packets.empty() || packets.back()._length == payload || packets.back()._offset + packets.back()._length != base + index) {
+                packets.push_back({ base + index, 0, {} });
+            }
+            auto& packet = packets.back();
+            int32_t len = std::min(payload - packet._length, it->_channels - index);
+            packet._pieces.push_back({ it, index, len });
+            packet._length += len;
+            index += len;
+        }
+    }
+    _stream->_buffer.resize(DDP_PACKET_HEADERLEN + payload);
+    _stream->_layoutSenders = senders;
+
+    logger_base.debug("DDP %s: %d outputs sent as %d packets of up to %d channels.",
+        (const char*)_ip.c_str(), (int)senders.size(), (int)packets.size(), payload);
+}
+
 void DDPOutput::OpenDatagram() {
 
     static log4cpp::Category& logger_base = log4cpp::Category::getInstance(std::string("log_base"));
@@ -70,27 +216,28 @@ void DDPOutput::OpenDatagram() {
 DDPOutput::DDPOutput(wxXmlNode* node) : IPOutput(node) {
 
     _fulldata = nullptr;
-    _channelsPerPacket = wxAtoi(node->GetAttribute("ChannelsPerPacket"));
+    _channelsPerPacket = wxAtoi(node->GetAttribute("ChannelsPerPacket", wxString::Format("%d", DDP_DEFAULT_CHANNELS_PER_PACKET)));
+    // a channels per packet of 0 was how auto packet size used to be saved
+    _autoPacketSize = node->GetAttribute("AutoPacketSize", "0") == "1" || _channelsPerPacket <= 0;
+    if (_channelsPerPacket <= 0) _channelsPerPacket = DDP_DEFAULT_CHANNELS_PER_PACKET;
     _keepChannelNumbers = wxAtoi(node->GetAttribute("KeepChannelNumbers"));
-    _sequenceNum = 0;
     _datagram = nullptr;
-    memset(_data, 0, sizeof(_data));
 }
 
 DDPOutput::DDPOutput() : IPOutput() {
 
     _universe = 64001;
     _fulldata = nullptr;
-    _channelsPerPacket = 1440;
+    _channelsPerPacket = DDP_DEFAULT_CHANNELS_PER_PACKET;
+    _autoPacketSize = true;
     _channels = 512;
-    _sequenceNum = 0;
     _datagram = nullptr;
     _keepChannelNumbers = true;
-    memset(_data, 0, sizeof(_data));
 }
 
 DDPOutput::~DDPOutput() {
 
+    LeaveStream();
     if (_datagram != nullptr) delete _datagram;
     if (_fulldata != nullptr) delete _fulldata;
 }
@@ -99,7 +246,9 @@ wxXmlNode* DDPOutput::Save() {
 
     wxXmlNode* node = new wxXmlNode(wxXML_ELEMENT_NODE, "network");
 
+    // always a real size so older versions that do not know about auto packet size still send sensible packets
     node->AddAttribute("ChannelsPerPacket", wxString::Format("%i", _channelsPerPacket));
+    node->AddAttribute("AutoPacketSize", _autoPacketSize ? "1" : "0");
     node->AddAttribute("KeepChannelNumbers", _keepChannelNumbers ? "1" : "0");
     IPOutput::Save(node);
 
@@ -413,22 +562,28 @@ bool DDPOutput::Open() {
         return _ok;
     }
 
-    memset(_data, 0x00, sizeof(_data));
-
-    _data[2] = 1;
-    _data[3] = DDP_ID_DISPLAY;
-    _sequenceNum = 1;
-
     OpenDatagram();
 
     _remoteAddr.Hostname(_ip.c_str());
     _remoteAddr.Service(DDP_PORT);
 
+    // manual sizes are also limited to what the path can carry
+    _pathMTU = GetPathMTU(_resolvedIp);
+    if (_autoPacketSize || GetPayloadSize() != _channelsPerPacket) {
+        logger_base.debug("DDP %s path MTU %d so sending up to %d channels per packet.", (const char*)_ip.c_str(), _pathMTU, GetPayloadSize());
+    }
+
+    // joined even if the socket failed to open so a later retry can send
+    LeaveStream();
+    JoinStream();
+
     return _ok;
 }
 
 void DDPOutput::Close() {
 
+    LeaveStream();
+
     if (_datagram != nullptr) {
         delete _datagram;
         _datagram = nullptr;
@@ -466,51 +621,73 @@ void DDPOutput::EndFrame(int suppressFrames) {
         _fppProxyOutput->EndFrame(suppressFrames);
         return;
     }
-    if (_datagram == nullptr) return;
+    if (_datagram == nullptr || _stream == nullptr) return;
 
-    if (_changed || NeedToOutput(suppressFrames)) {
-        int32_t index = 0;
-        int32_t chan = _keepChannelNumbers ? (_startChannel - 1) : 0;
-        int32_t tosend = _channels;
+    // the first output to the controller that is able to send does it for all of them
+    std::vector<DDPOutput*> senders;
+    for (const auto& it : _stream->_outputs) {
+        if (it->CanSend()) senders.push_back(it);
+    }
+    if (senders.empty() || senders.front() != this) return;
 
-        while (tosend > 0) {
-            int32_t thissend = (tosend < _channelsPerPacket) ? tosend : _channelsPerPacket;
+    bool send = false;
+    for (const auto& it : senders) {
+        if (it->_changed || it->NeedToOutput(suppressFrames)) {
+            send = true;
+            break;
+        }
+    }
+    if (!send) {
+        for (const auto& it : senders) {
+            it->SkipFrame();
+        }
+        return;
+    }
 
-            if (__initialised) {
-                // sync packet will boadcast later
-                _data[0] = DDP_FLAGS1_VER1;
-            }
-            else {
-                if (tosend == thissend) {
-                    _data[0] = DDP_FLAGS1_VER1 | DDP_FLAGS1_PUSH;
-                }
-                else {
-                    _data[0] = DDP_FLAGS1_VER1;
-                }
-            }
+    std::sort(senders.begin(), senders.end(), [](DDPOutput* a, DDPOutput* b) { return a->_startChannel < b->_startChannel; });
+    if (senders != _stream->_layoutSenders) {
+        BuildStreamLayout(senders);
+    }
 
-            _data[1] = (_data[1] & 0xF0) + _sequenceNum;
+    uint8_t* buffer = _stream->_buffer.data();
+    buffer[2] = 1;
+    buffer[3] = DDP_ID_DISPLAY;
+    for (size_t i = 0; i < _stream->_packets.size(); i++) {
+        const auto& packet = _stream->_packets[i];
 
-            _data[4] = (chan & 0xFF000000) >> 24;
-            _data[5] = (chan & 0xFF0000) >> 16;
-            _data[6] = (chan & 0xFF00) >> 8;
-            _data[7] = (chan & 0xFF);
+        if (__initialised) {
+            // sync packet will boadcast later
+            buffer[0] = DDP_FLAGS1_VER1;
+        }
+        else if (i == _stream->_packets.size() - 1) {
+            buffer[0] = DDP_FLAGS1_VER1 | DDP_FLAGS1_PUSH;
+        }
+        else {
+            buffer[0] = DDP_FLAGS1_VER1;
+        }
 
-            _data[8] = (thissend & 0xFF00) >> 8;
-            _data[9] = thissend & 0x00FF;
+        buffer[1] = _stream->_sequenceNum;
 
-            memcpy(&_data[10], _fulldata + index, thissend);
+        buffer[4] = (packet._offset & 0xFF000000) >> 24;
+        buffer[5] = (packet._offset & 0xFF0000) >> 16;
+        buffer[6] = (packet._offset & 0xFF00) >> 8;
+        buffer[7] = (packet._offset & 0xFF);
 
-            _datagram->SendTo(_remoteAddr, &_data[0], DDP_PACKET_LEN - (1440 - thissend));
-            _sequenceNum = _sequenceNum == 15 ? 1 : _sequenceNum + 1;
+        buffer[8] = (packet._length & 0xFF00) >> 8;
+        buffer[9] = packet._length & 0x00FF;
 
-            tosend -= thissend;
-            index += thissend;
-            chan += thissend;
+        uint8_t* data = &buffer[DDP_PACKET_HEADERLEN];
+        for (const auto& it : packet._pieces) {
+            memcpy(data, it._output->_fulldata + it._index, it._length);
+            data += it._length;
         }
-        FrameOutput();
-    } else {
-        SkipFrame();
+
+        _datagram->SendTo(_remoteAddr, buffer, DDP_PACKET_HEADERLEN + packet._length);
+        _stream->_sequenceNum = _stream->_sequenceNum == 15 ? 1 : _stream->_sequenceNum + 1;
+    }
+
+    for (const auto& it : senders) {
+        it->FrameOutput();
     }
 }
 #pragma endregion
@@ -552,6 +729,21 @@ void DDPOutput::SetManyChannels(int32_t channel, unsigned char* data, size_t siz
     }
 }
 
+void DDPOutput::SetManyChannelsChanged(int32_t channel, unsigned char* data, size_t size) {
+
+    if (!_enabled) return;
+
+    if (_fppProxyOutput) {
+        _fppProxyOutput->SetManyChannelsChanged(channel, data, size);
+        return;
+    }
+    if (_fulldata == nullptr) return;
+
+    size_t chs = (std::min)((int32_t)size, _channels - channel);
+    memcpy(_fulldata + channel, data, chs);
+    _changed = true;
+}
+
 void DDPOutput::AllOff() {
 
     if (!_enabled) return;
@@ -570,11 +762,19 @@ void DDPOutput::AllOff() {
 #ifndef EXCLUDENETWORKUI
 void DDPOutput::AddProperties(wxPropertyGrid* propertyGrid, bool allSameSize, std::list<wxPGProperty*>& expandProperties)
 {
-    auto p = propertyGrid->Append(new wxUIntProperty("Channels Per Packet", "ChannelsPerPacket", GetChannelsPerPacket()));
+    auto p = propertyGrid->Append(new wxBoolProperty("Auto Packet Size", "AutoPacketSize", IsAutoPacketSize()));
+    p->SetEditor("CheckBox");
+    p->SetHelpString("Sizes packets to suit the network path to the controller which is almost always what you want.");
+
+    p = propertyGrid->Append(new wxUIntProperty("Channels Per Packet", "ChannelsPerPacket", GetChannelsPerPacket()));
     p->SetAttribute("Min", 1);
-    p->SetAttribute("Max", 1440);
+    p->SetAttribute("Max", (DDP_MAX_MTU - 28 - DDP_PACKET_HEADERLEN) / 3 * 3);
     p->SetEditor("SpinCtrl");
-    p->SetHelpString("It would be very rare that you would ever want to change this from the default.");
+    p->SetHelpString("Packets are never made bigger than the network path to the controller can carry.");
+    if (IsAutoPacketSize()) {
+        p->SetTextColour(wxSystemSettings::GetColour(wxSYS_COLOUR_GRAYTEXT));
+        p->ChangeFlag(wxPG_PROP_READONLY, true);
+    }
 
     p = propertyGrid->Append(new wxBoolProperty("Keep Channel Numbers", "KeepChannelNumbers", IsKeepChannelNumbers()));
     p->SetEditor("CheckBox");
@@ -585,7 +785,12 @@ bool DDPOutput::HandlePropertyEvent(wxPropertyGridEvent& event, OutputModelManag
 
     wxString const name = event.GetPropertyName();
 
-    if (name == "ChannelsPerPacket") {
+    if (name == "AutoPacketSize") {
+        SetAutoPacketSize(event.GetValue().GetBool());
+        outputModelManager->AddASAPWork(OutputModelManager::WORK_NETWORK_CHANGE, "DDPOutput::HandlePropertyEvent::AutoPacketSize");
+        outputModelManager->AddASAPWork(OutputModelManager::WORK_UPDATE_NETWORK_LIST, "DDPOutput::HandlePropertyEvent::AutoPacketSize", nullptr);
+        return true;
+    } else if (name == "ChannelsPerPacket") {
         SetChannelsPerPacket(event.GetValue().GetLong());
         outputModelManager->AddASAPWork(OutputModelManager::WORK_NETWORK_CHANGE, "DDPOutput::HandlePropertyEvent::ChannelsPerPacket");
         return true;
@@ -12,6 +12,9 @@
 
 #include "IPOutput.h"
 
+#include <algorithm>
+#include <vector>
+
 #include <wx/sckaddr.h>
 #include <wx/socket.h>
 
@@ -27,6 +30,10 @@
 #define DDP_PORT 4048
 #define DDP_SYNCPACKET_LEN 10
 #define DDP_DISCOVERPACKET_LEN 10
+// auto packet size sizes packets from the path MTU to the controller
+#define DDP_DEFAULT_CHANNELS_PER_PACKET 1440
+#define DDP_DEFAULT_MTU 1500
+#define DDP_MAX_MTU 9000
 
 #define DDP_FLAGS1_VER     0xc0   
 #define DDP_FLAGS1_VER1    0x40
@@ -46,17 +53,19 @@
 #pragma endregion
 
 class Discovery;
+struct DDPStream;
 
 class DDPOutput : public IPOutput
 {
     #pragma region Member Variables
-    uint8_t _data[DDP_PACKET_LEN];
-    uint8_t _sequenceNum;
     wxIPV4address _remoteAddr;
     wxDatagramSocket *_datagram;
     uint8_t* _fulldata;
     int _channelsPerPacket;
+    bool _autoPacketSize;
+    int _pathMTU = DDP_DEFAULT_MTU;
     bool _keepChannelNumbers;
+    DDPStream* _stream = nullptr; // shared with the other outputs sending to the same controller
 
     // These are used for DDP sync
     static bool __initialised;
@@ -64,6 +73,11 @@ class DDPOutput : public IPOutput
 
     #pragma region Private Functions
     void OpenDatagram();
+    bool CanSend() const { return _enabled && !_suspend && !_tempDisable && _datagram != nullptr && _fulldata != nullptr; }
+    int GetPayloadSize() const;
+    void JoinStream();
+    void LeaveStream();
+    void BuildStreamLayout(const std::vector<DDPOutput*>& senders);
     #pragma  endregion
 
 public:
@@ -90,7 +104,10 @@ public:
     void SetId(int id) { _universe = id; _dirty = true; }
 
     int GetChannelsPerPacket() const { return _channelsPerPacket; }
-    void SetChannelsPerPacket(int cpp) { _channelsPerPacket = cpp; _dirty = true; }
+    void SetChannelsPerPacket(int cpp) { _channelsPerPacket = std::max(1, cpp); _dirty = true; }
+
+    bool IsAutoPacketSize() const { return _autoPacketSize; }
+    void SetAutoPacketSize(bool autoPacketSize) { if (_autoPacketSize != autoPacketSize) { _autoPacketSize = autoPacketSize; _dirty = true; } }
 
     virtual bool IsKeepChannelNumbers() const { return _keepChannelNumbers; }
     virtual void SetKeepChannelNumber(bool b = true) { if (_keepChannelNumbers != b) { _keepChannelNumbers = b; _dirty = true; } }
@@ -116,6 +133,7 @@ public:
     #pragma region Data Setting
     virtual void SetOneChannel(int32_t channel, unsigned char data) override;
     virtual void SetManyChannels(int32_t channel, unsigned char* data, size_t size) override;
+    virtual void SetManyChannelsChanged(int32_t channel, unsigned char* data, size_t size) override;
     virtual void AllOff() override;
     #pragma endregion
 
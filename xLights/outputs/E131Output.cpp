@@ -493,6 +493,22 @@ void E131Output::SetManyChannels(int32_t channel, unsigned char* data, size_t si
     }
 }
 
+void E131Output::SetManyChannelsChanged(int32_t channel, unsigned char* data, size_t size) {
+
+    wxASSERT(!IsOutputCollection_CONVERT());
+
+    if (!_enabled) return;
+
+    if (_fppProxyOutput) {
+        _fppProxyOutput->SetManyChannelsChanged(channel, data, size);
+    }
+    else {
+        size_t chs = (std::min)(size, (size_t)(GetMaxChannels() - channel));
+        memcpy(&_data[channel + E131_PACKET_HEADERLEN], data, chs);
+        _changed = true;
+    }
+}
+
 void E131Output::AllOff() {
 
     wxASSERT(!IsOutputCollection_CONVERT());
@@ -272,6 +272,16 @@ void KinetOutput::SetManyChannels(int32_t channel, unsigned char* data, size_t s
     }
 }
 
+void KinetOutput::SetManyChannelsChanged(int32_t channel, unsigned char* data, size_t size) {
+
+    if (!_enabled) return;
+    wxASSERT(channel + size <= _channels);
+
+    size_t chs = (std::min)((int32_t)size, _channels - channel);
+    memcpy(&_data[channel + GetHeaderPacketLength()], data, chs);
+    _changed = true;
+}
+
 void KinetOutput::AllOff() {
 
     if (!_enabled) return;
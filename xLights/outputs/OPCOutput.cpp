@@ -290,6 +290,15 @@ void OPCOutput::SetManyChannels(int32_t channel, unsigned char* data, size_t siz
     //}
 }
 
+void OPCOutput::SetManyChannelsChanged(int32_t channel, unsigned char* data, size_t size) {
+
+    if (!_enabled) return;
+
+    size_t chs = (std::min)(size, (size_t)(GetMaxChannels() - channel));
+    memcpy(&_data[channel + OPC_PACKET_HEADERLEN], data, chs);
+    _changed = true;
+}
+
 void OPCOutput::AllOff() {
 
     if (!_enabled) return;
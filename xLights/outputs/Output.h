@@ -137,6 +137,7 @@ public:
     void SetForceLocalIP(const std::string& ip) { _forceLocalIP = ip; }
     bool IsUsingForceLocalIP() const { return _forceLocalIP != ""; }
     void SetGlobalForceLocalIP(const std::string& ip) { _globalForceLocalIP = ip; }
+    std::string GetGlobalForceLocalIP() const { return _globalForceLocalIP; }
     std::string GetForceLocalIPToUse() const;
 
     int GetUniverse() const { return _universe; }
@@ -213,6 +214,8 @@ public:
     #pragma region Data Setting
     virtual void SetOneChannel(int32_t channel, unsigned char data) = 0;
     virtual void SetManyChannels(int32_t channel, unsigned char* data, size_t size);
+    // as SetManyChannels but the caller already knows the data differs so outputs can skip their own compare
+    virtual void SetManyChannelsChanged(int32_t channel, unsigned char* data, size_t size) { SetManyChannels(channel, data, size); }
     virtual void AllOff() = 0;
     #pragma endregion 
 
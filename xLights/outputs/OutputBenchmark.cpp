@@ -0,0 +1,399 @@
+/***************************************************************
+ * This source files comes from the xLights project
+ * https://www.xlights.org
+ * https://github.com/smeighan/xLights
+ * See the github commit history for a record of contributing
+ * developers.
+ * Copyright claimed based on commit dates recorded in Github
+ * License: https://github.com/smeighan/xLights/blob/master/License.txt
+ **************************************************************/
+
+#include <wx/socket.h>
+#include <wx/utils.h>
+
+#include "OutputBenchmark.h"
+#include "OutputManager.h"
+#include "ControllerEthernet.h"
+#include "E131Output.h"
+#include "ArtNetOutput.h"
+#include "DDPOutput.h"
+#include "ZCPPOutput.h"
+
+#ifndef __WXMSW__
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#else
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <thread>
+
+#include <log4cpp/Category.hh>
+
+// all the emulated controllers live on the loopback address
+#define BENCHMARK_IP "127.0.0.1"
+#define BENCHMARK_CHANNELS_PER_UNIVERSE 510
+#define BENCHMARK_SYNC_UNIVERSE 64000
+// big enough that a frame of a few hundred universes is not dropped by the listener before it is read
+#define BENCHMARK_RECEIVE_BUFFER (8 * 1024 * 1024)
+
+static double MSSince(const std::chrono::steady_clock::time_point& start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+#pragma region Constructors and Destructors
+OutputBenchmark::OutputBenchmark(const std::string& settings)
+{
+    for (const auto& it : wxSplit(settings, ',')) {
+        wxString name = it.BeforeFirst('=').Trim(false).Trim(true).Lower();
+        int value = wxAtoi(it.AfterFirst('='));
+        if (name == "universes") {
+            _universes = std::max(1, std::min(value, 10000));
+        }
+        else if (name == "fps") {
+            _fps = std::max(1, std::min(value, 200));
+        }
+        else if (name == "seconds") {
+            _seconds = std::max(1, std::min(value, 3600));
+        }
+        else if (name == "changed") {
+            _changedPercent = std::max(0, std::min(value, 100));
+        }
+        else if (name == "suppress") {
+            _suppressFrames = std::max(0, value);
+        }
+        else if (name == "parallel") {
+            _parallel = value != 0;
+        }
+        else if (name == "sync") {
+            _sync = value != 0;
+        }
+    }
+}
+#pragma endregion
+
+#pragma region Private Functions
+bool OutputBenchmark::OpenListener(ProtocolRun& run) const
+{
+    static log4cpp::Category& logger_base = log4cpp::Category::getInstance(std::string("log_base"));
+
+    // bound to every address so broadcast sync packets sent from the real interface are also seen
+    wxIPV4address addr;
+    addr.AnyAddress();
+    addr.Service(run._port);
+    // it is read from the receive thread which wx only allows for blocking sockets
+    run._listener = new wxDatagramSocket(addr, wxSOCKET_NOWAIT | wxSOCKET_BLOCK);
+    if (!run._listener->IsOk()) {
+        delete run._listener;
+        run._listener = nullptr;
+        logger_base.warn("Output benchmark unable to listen on port %d for %s.", run._port, (const char*)run._protocol.c_str());
+        return false;
+    }
+
+    int size = BENCHMARK_RECEIVE_BUFFER;
+    run._listener->SetOption(SOL_SOCKET, SO_RCVBUF, (const char*)&size, sizeof(size));
+
+    // sync packets for these protocols are multicast so join the group to see them looped back
+    std::string group;
+    if (run._protocol == OUTPUT_E131) {
+        group = wxString::Format("239.255.%d.%d", BENCHMARK_SYNC_UNIVERSE >> 8, BENCHMARK_SYNC_UNIVERSE & 0xFF).ToStdString();
+    }
+    else if (run._protocol == OUTPUT_ZCPP) {
+        group = ZCPP_MULTICAST_ADDRESS;
+    }
+    if (_sync && group != "") {
+        struct ip_mreq mreq;
+        mreq.imr_multiaddr.s_addr = inet_addr(group.c_str());
+        mreq.imr_interface.s_addr = htonl(INADDR_ANY);
+        if (!run._listener->SetOption(IPPROTO_IP, IP_ADD_MEMBERSHIP, (const char*)&mreq, sizeof(mreq))) {
+            logger_base.warn("Output benchmark unable to join %s multicast group %s.", (const char*)run._protocol.c_str(), (const char*)group.c_str());
+        }
+    }
+
+    return true;
+}
+
+// Runs on its own thread until stopped reading packets as they arrive. Each frame's packets arrive as a burst
+// so a data packet more than half a frame after the one before it is taken as the start of the next frame.
+void OutputBenchmark::Receive(ProtocolRun& run, const std::atomic<bool>& stop, const std::chrono::steady_clock::time_point& start)
+{
+    uint8_t buffer[2048];
+    wxIPV4address peer;
+    double gapMS = 500.0 / _fps;
+    double lastPacket = -1;
+    double lastFrame = -1;
+
+    while (!stop) {
+        if (!run._listener->WaitForRead(0, 10)) continue;
+
+        while (true) {
+            int len = run._listener->RecvFrom(peer, buffer, sizeof(buffer)).LastCount();
+            if (len <= 0) break;
+            double now = MSSince(start);
+
+            long before = run._packets;
+            ProcessPacket(run, buffer, len);
+            if (run._packets == before) continue;
+
+            if (lastPacket < 0 || now - lastPacket > gapMS) {
+                if (lastFrame >= 0) {
+                    run._deliveryMS.push_back(now - lastFrame);
+                }
+                lastFrame = now;
+                run._framesReceived++;
+            }
+            lastPacket = now;
+        }
+    }
+}
+
+// modulus is the number of distinct sequence numbers the protocol cycles through
+void OutputBenchmark::CheckSequence(ProtocolRun& run, int stream, int seq, int modulus)
+{
+    auto it = run._lastSeq.find(stream);
+    if (it == run._lastSeq.end()) {
+        run._lastSeq[stream] = seq;
+        return;
+    }
+
+    int delta = (seq - it->second + modulus) % modulus;
+    if (delta == 0 || delta > modulus / 2) {
+        // a repeat or a packet that was overtaken by a later one
+        run._outOfOrder++;
+        return;
+    }
+    run._lost += delta - 1;
+    it->second = seq;
+}
+
+void OutputBenchmark::ProcessPacket(ProtocolRun& run, const uint8_t* buffer, int len)
+{
+    if (run._protocol == OUTPUT_E131) {
+        if (len < 16 || memcmp(&buffer[4], "ASC-E1.17", 9) != 0) return;
+        if (len == E131_SYNCPACKET_LEN) {
+            run._syncs++;
+            return;
+        }
+        if (len < E131_PACKET_HEADERLEN) return;
+        run._packets++;
+        run._bytes += len;
+        CheckSequence(run, (buffer[113] << 8) + buffer[114], buffer[111], 256);
+    }
+    else if (run._protocol == OUTPUT_ARTNET) {
+        if (len < 10 || memcmp(buffer, "Art-Net", 8) != 0) return;
+        int opcode = buffer[8] + (buffer[9] << 8);
+        if (opcode == 0x5200) {
+            run._syncs++;
+            return;
+        }
+        if (opcode != 0x5000 || len < ARTNET_PACKET_HEADERLEN) return;
+        run._packets++;
+        run._bytes += len;
+        CheckSequence(run, buffer[14] + (buffer[15] << 8), buffer[12], 256);
+    }
+    else if (run._protocol == OUTPUT_DDP) {
+        if (len < DDP_PACKET_HEADERLEN) return;
+        int dataLen = (buffer[8] << 8) + buffer[9];
+        if (dataLen == 0 && (buffer[0] & DDP_FLAGS1_PUSH) != 0) {
+            run._syncs++;
+            return;
+        }
+        run._packets++;
+        run._bytes += len;
+        // sequence numbers run 1 to 15 and 0 means the sender does not use them
+        int seq = buffer[1] & 0x0F;
+        if (seq != 0) {
+            CheckSequence(run, 0, seq - 1, 15);
+        }
+    }
+    else if (run._protocol == OUTPUT_ZCPP) {
+        if (len < (int)sizeof(ZCPP_Header) || memcmp(buffer, "ZCPP", 4) != 0) return;
+        if (buffer[4] == ZCPP_TYPE_SYNC) {
+            run._syncs++;
+            return;
+        }
+        if (buffer[4] != ZCPP_TYPE_DATA || len < (int)ZCPP_DATA_HEADER_SIZE) return;
+        run._packets++;
+        run._bytes += len;
+        // every packet of a frame carries the same sequence number so only check it once per frame
+        const ZCPP_Data* data = (const ZCPP_Data*)buffer;
+        if ((data->flags & ZCPP_DATA_FLAG_FIRST) != 0) {
+            CheckSequence(run, 0, data->sequenceNumber, 256);
+        }
+    }
+}
+
+OutputManager* OutputBenchmark::CreateOutputManager(const std::string& protocol) const
+{
+    OutputManager* om = new OutputManager();
+
+    ControllerEthernet* c = new ControllerEthernet(om);
+    c->GetFirstOutput()->SetChannels(BENCHMARK_CHANNELS_PER_UNIVERSE);
+    if (protocol != OUTPUT_E131) {
+        c->SetProtocol(protocol);
+    }
+    if (protocol == OUTPUT_E131 || protocol == OUTPUT_ARTNET) {
+        for (int i = 1; i < _universes; i++) {
+            c->AddOutput();
+        }
+    }
+    else {
+        // DDP and ZCPP send the whole controller as one output
+        c->GetFirstOutput()->SetChannels(_universes * BENCHMARK_CHANNELS_PER_UNIVERSE);
+        auto zcpp = dynamic_cast<ZCPPOutput*>(c->GetFirstOutput());
+        if (zcpp != nullptr) {
+            // there are no models to work out the used channels from
+            zcpp->SetUsedChannels(_universes * BENCHMARK_CHANNELS_PER_UNIVERSE);
+        }
+    }
+    c->SetIP(BENCHMARK_IP);
+    c->SetSuppressDuplicateFrames(_suppressFrames > 0);
+    om->AddController(c);
+    om->SomethingChanged();
+
+    om->SetSuppressFrames(_suppressFrames);
+    om->SetParallelTransmission(_parallel);
+    om->SetSyncEnabled(_sync);
+    if (_sync) {
+        om->SetSyncUniverse(BENCHMARK_SYNC_UNIVERSE);
+    }
+
+    return om;
+}
+
+void OutputBenchmark::RunProtocol(ProtocolRun& run)
+{
+    static log4cpp::Category& logger_base = log4cpp::Category::getInstance(std::string("log_base"));
+
+    if (!OpenListener(run)) {
+        run._error = wxString::Format("Unable to listen on port %d ... is another program using it?", run._port).ToStdString();
+        return;
+    }
+
+    OutputManager* om = CreateOutputManager(run._protocol);
+    if (!om->StartOutput()) {
+        run._error = "Unable to start output.";
+        delete om;
+        delete run._listener;
+        run._listener = nullptr;
+        return;
+    }
+
+    logger_base.debug("Output benchmark %s: %d universes at %d fps for %d seconds.", (const char*)run._protocol.c_str(), _universes, _fps, _seconds);
+
+    size_t channels = (size_t)_universes * BENCHMARK_CHANNELS_PER_UNIVERSE;
+    std::vector<unsigned char> frame(channels, 0);
+    int changedUniverses = (_universes * _changedPercent + 99) / 100;
+
+    double frameMS = 1000.0 / _fps;
+    int frames = _fps * _seconds;
+    auto start = std::chrono::steady_clock::now();
+
+    // receiving on the sending thread would time packets by when we got round to reading them
+    std::atomic<bool> stop(false);
+    std::thread receiver([this, &run, &stop, start]() { Receive(run, stop, start); });
+
+    for (int f = 0; f < frames; f++) {
+
+        double wait = f * frameMS - MSSince(start);
+        if (wait >= 1) {
+            wxMilliSleep((unsigned long)wait);
+        }
+
+        // the first frame sets every universe so unchanged universes still carry data
+        int universes = f == 0 ? _universes : changedUniverses;
+        for (int u = 0; u < universes; u++) {
+            memset(&frame[u * BENCHMARK_CHANNELS_PER_UNIVERSE], (f + u) & 0xFF, BENCHMARK_CHANNELS_PER_UNIVERSE);
+        }
+
+        auto sendStart = std::chrono::steady_clock::now();
+        om->StartFrame((long)MSSince(start));
+        om->SetFrame(frame.data(), channels);
+        om->EndFrame();
+        run._sendMS.push_back(MSSince(sendStart));
+        run._framesSent++;
+    }
+
+    // anything still in flight
+    wxMilliSleep(50);
+    stop = true;
+    receiver.join();
+
+    om->StopOutput();
+    delete om;
+    delete run._listener;
+    run._listener = nullptr;
+}
+
+std::string OutputBenchmark::Report(const ProtocolRun& run) const
+{
+    std::string res = run._protocol + "\n";
+    if (run._error != "") {
+        return res + "    " + run._error + "\n";
+    }
+
+    std::vector<double> send = run._sendMS;
+    std::sort(send.begin(), send.end());
+    double sendAvg = 0;
+    for (const auto& it : send) {
+        sendAvg += it;
+    }
+    if (!send.empty()) sendAvg /= send.size();
+
+    // jitter is the average distance of the frame to frame delivery interval from the frame time
+    double frameMS = 1000.0 / _fps;
+    double jitter = 0;
+    for (const auto& it : run._deliveryMS) {
+        jitter += std::abs(it - frameMS);
+    }
+    if (!run._deliveryMS.empty()) jitter /= run._deliveryMS.size();
+
+    double loss = run._packets + run._lost == 0 ? 0 : 100.0 * run._lost / (run._packets + run._lost);
+
+    res += wxString::Format("    Frames sent: %ld, frames with no data received: %ld\n", run._framesSent, std::max(0L, run._framesSent - run._framesReceived)).ToStdString();
+    if (!send.empty()) {
+        res += wxString::Format("    Send time ms: min %.3f avg %.3f 99%% %.3f max %.3f\n",
+            send.front(), sendAvg, send[(send.size() - 1) * 99 / 100], send.back()).ToStdString();
+    }
+    res += wxString::Format("    Delivery jitter ms: %.3f\n", jitter).ToStdString();
+    res += wxString::Format("    Packets received: %ld, bytes: %ld\n", run._packets, run._bytes).ToStdString();
+    res += wxString::Format("    Lost: %ld (%.2f%%), duplicate or out of order: %ld\n", run._lost, loss, run._outOfOrder).ToStdString();
+    if (_sync) {
+        res += wxString::Format("    Sync packets received: %ld of %ld\n", run._syncs, run._framesSent).ToStdString();
+    }
+    return res;
+}
+#pragma endregion
+
+std::string OutputBenchmark::Run()
+{
+    static log4cpp::Category& logger_base = log4cpp::Category::getInstance(std::string("log_base"));
+
+    std::vector<ProtocolRun> runs(4);
+    runs[0]._protocol = OUTPUT_E131;
+    runs[0]._port = E131_PORT;
+    runs[1]._protocol = OUTPUT_ARTNET;
+    runs[1]._port = ARTNET_PORT;
+    runs[2]._protocol = OUTPUT_DDP;
+    runs[2]._port = DDP_PORT;
+    runs[3]._protocol = OUTPUT_ZCPP;
+    runs[3]._port = ZCPP_PORT;
+
+    std::string res = wxString::Format("Output benchmark: %d universes, %d fps, %d seconds, %d%% changing, suppress %d, parallel %s, sync %s\n",
+        _universes, _fps, _seconds, _changedPercent, _suppressFrames, _parallel ? "on" : "off", _sync ? "on" : "off").ToStdString();
+
+    for (auto& it : runs) {
+        RunProtocol(it);
+        res += Report(it);
+    }
+
+    logger_base.info(res);
+    return res;
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+/***************************************************************
+ * This source files comes from the xLights project
+ * https://www.xlights.org
+ * https://github.com/smeighan/xLights
+ * See the github commit history for a record of contributing
+ * developers.
+ * Copyright claimed based on commit dates recorded in Github
+ * License: https://github.com/smeighan/xLights/blob/master/License.txt
+ **************************************************************/
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+class wxDatagramSocket;
+class OutputManager;
+
+// Measures output throughput without any controllers. For each protocol a local listener stands in
+// for the controller and an OutputManager sends it synthetic frames at the requested rate. Packets are
+// received and timestamped on a thread of their own as they arrive and are checked for lost, duplicate
+// and out of order sequence numbers and sync packets are counted.
+class OutputBenchmark
+{
+    struct ProtocolRun
+    {
+        std::string _protocol;
+        int _port = 0;
+        wxDatagramSocket* _listener = nullptr;
+        std::map<int, int> _lastSeq; // by universe or 0 for protocols that send one stream
+        long _packets = 0;
+        long _bytes = 0;
+        long _lost = 0;
+        long _outOfOrder = 0;
+        long _syncs = 0;
+        long _framesSent = 0;
+        long _framesReceived = 0;
+        std::vector<double> _sendMS;
+        std::vector<double> _deliveryMS; // between the first packets of consecutive frames to arrive
+        std::string _error;
+    };
+
+    int _universes = 100;
+    int _fps = 40;
+    int _seconds = 10;
+    int _changedPercent = 100;
+    int _suppressFrames = 0;
+    bool _parallel = false;
+    bool _sync = false;
+
+    bool OpenListener(ProtocolRun& run) const;
+    void Receive(ProtocolRun& run, const std::atomic<bool>& stop, const std::chrono::steady_clock::time_point& start);
+    void ProcessPacket(ProtocolRun& run, const uint8_t* buffer, int len);
+    void CheckSequence(ProtocolRun& run, int stream, int seq, int modulus);
+    OutputManager* CreateOutputManager(const std::string& protocol) const;
+    void RunProtocol(ProtocolRun& run);
+    std::string Report(const ProtocolRun& run) const;
+
+public:
+
+    // settings are comma separated name=value pairs: universes, fps, seconds, changed (percent of
+    // universes that change each frame), suppress (duplicate frames to suppress), parallel and sync
+    OutputBenchmark(const std::string& settings);
+    virtual ~OutputBenchmark() {}
+
+    std::string Run();
+};
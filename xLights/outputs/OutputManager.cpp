@@ -26,9 +26,12 @@
 #include "xxxEthernetOutput.h"
 #include "OPCOutput.h"
 #include "TestPreset.h"
+#include "TransmitScheduler.h"
 #include "../Parallel.h"
 #include "../UtilFunctions.h"
 
+#include <cstring>
+
 #include <log4cpp/Category.hh>
 
 #pragma region Static Variables
@@ -142,6 +145,10 @@ OutputManager::~OutputManager()
         StopOutput();
     }
 
+    if (_transmitScheduler != nullptr) {
+        delete _transmitScheduler;
+    }
+
     // destroy all out output objects
     DeleteAllControllers();
 
@@ -481,6 +488,7 @@ void OutputManager::DeleteController(const std::string& controllerName) {
         if ((*it)->GetName() == controllerName) {
             delete* it;
             _controllers.erase(it);
+            _frameRangesValid = false;
             break;
         }
     }
@@ -489,6 +497,8 @@ void OutputManager::DeleteController(const std::string& controllerName) {
 
 void OutputManager::DeleteAllControllers() {
 
+    _frameRangesValid = false;
+
     while (_controllers.size() > 0) {
         delete _controllers.front();
         _controllers.pop_front();
@@ -977,6 +987,7 @@ int OutputManager::UniqueId() {
 
 // Need to call this whenever something may have changed in an output to ensure all the transient data it updated
 void OutputManager::SomethingChanged() const {
+    _frameRangesValid = false;
     int nullcnt = 0;
     int start = 1;
     for (auto& it : _controllers) {
@@ -1064,6 +1075,9 @@ bool OutputManager::StartOutput() {
 
     logger_base.debug("Starting light output.");
 
+    _frameRangesValid = false;
+    _lastFrameValid = false;
+
     int started = 0;
     bool ok = true;
     bool err = false;
@@ -1114,6 +1128,13 @@ void OutputManager::StopOutput() {
     logger_base.debug("Stopping light output.");
 
     _outputting = false;
+    _lastFrameValid = false;
+
+    // the senders must be gone before their sockets are
+    if (_transmitScheduler != nullptr) {
+        delete _transmitScheduler;
+        _transmitScheduler = nullptr;
+    }
 
     for (const auto& it : GetAllOutputs()) {
         it->Close();
@@ -1171,10 +1192,23 @@ void OutputManager::EndFrame() {
 
     auto outputs = GetAllOutputs();
     if (_parallelTransmission) {
-        std::function<void(Output*&, int)> f = [this](Output*&o, int n) {
-            o->EndFrame(_suppressFrames);
-        };
-        parallel_for(outputs, f);
+        // controllers behind different network interfaces each get a sender thread of their own
+        if (_transmitScheduler == nullptr) {
+            _transmitScheduler = new TransmitScheduler();
+        }
+        if (!_transmitScheduler->Matches(outputs)) {
+            _transmitScheduler->Start(outputs);
+        }
+
+        if (_transmitScheduler->GetInterfaceCount() > 0) {
+            _transmitScheduler->EndFrame(_suppressFrames);
+        }
+        else {
+            std::function<void(Output*&, int)> f = [this](Output*&o, int n) {
+                o->EndFrame(_suppressFrames);
+            };
+            parallel_for(outputs, f);
+        }
     }
     else {
         for (const auto& it : outputs) {
@@ -1220,6 +1254,8 @@ void OutputManager::SendHeartbeat() {
 // channel here is zero based
 void OutputManager::SetOneChannel(int32_t channel, unsigned char data) {
 
+    _lastFrameValid = false;
+
     int32_t sc = 0;
     Output* output = GetOutput(channel + 1, sc);
     if (output != nullptr) {
@@ -1234,6 +1270,8 @@ void OutputManager::SetManyChannels(int32_t channel, unsigned char* data, size_t
 
     if (size == 0) return;
 
+    _lastFrameValid = false;
+
     int32_t stch;
     Output* o = GetOutput(channel + 1, stch);
 
@@ -1267,10 +1305,62 @@ void OutputManager::SetManyChannels(int32_t channel, unsigned char* data, size_t
     }
 }
 
+// Sets every channel from a whole frame starting at channel 1. Each output's slice is compared
+// against the same slice of the previous frame and only outputs whose data differs are handed the
+// new values so unchanged universes cost one memcmp rather than a pass through the output.
+size_t OutputManager::SetFrame(unsigned char* data, size_t size) {
+
+    if (size == 0) return 0;
+
+    // take the flags before reading anything so a change made while this frame is being set is seen by the next one
+    bool rangesValid = _frameRangesValid.exchange(true);
+    bool lastFrameValid = _lastFrameValid.exchange(true);
+
+    if (!rangesValid || _frameRangesSize != size) {
+        _frameRanges.clear();
+        _frameRangesSize = size;
+        for (const auto& it : _controllers) {
+            for (const auto& o : it->GetOutputs()) {
+                if (!o->IsEnabled()) continue;
+                int32_t start = o->GetStartChannel() - 1;
+                if (start < 0 || start >= (int32_t)size) continue;
+                int32_t channels = std::min(o->GetChannels(), (int32_t)size - start);
+                if (channels > 0) {
+                    _frameRanges.push_back({ o, start, channels });
+                }
+            }
+        }
+        lastFrameValid = false;
+    }
+
+    // anything that changes the layout or writes channels behind our back means the last frame can no longer be trusted
+    if (!lastFrameValid) {
+        // only the channels that belong to an output are ever compared so only they are kept
+        _lastFrame.resize(size);
+        for (const auto& it : _frameRanges) {
+            memcpy(&_lastFrame[it._start], &data[it._start], it._channels);
+            it._output->SetManyChannels(0, &data[it._start], it._channels);
+        }
+        return _frameRanges.size();
+    }
+
+    size_t changed = 0;
+    for (const auto& it : _frameRanges) {
+        if (memcmp(&_lastFrame[it._start], &data[it._start], it._channels) != 0) {
+            memcpy(&_lastFrame[it._start], &data[it._start], it._channels);
+            it._output->SetManyChannelsChanged(0, &data[it._start], it._channels);
+            changed++;
+        }
+    }
+    return changed;
+}
+
 void OutputManager::AllOff(bool send) {
 
     if (!_outputCriticalSection.TryEnter()) return;
 
+    _lastFrameValid = false;
+
     for (const auto& it : GetAllOutputs()) {
         it->AllOff();
         if (send) {
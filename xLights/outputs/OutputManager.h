@@ -16,6 +16,7 @@
 #include <map>
 #include <string>
 #include <vector>
+#include <atomic>
 
 class wxWindow;
 class wxXmlNode;
@@ -25,6 +26,7 @@ class Controller;
 class TestPreset;
 class Controller;
 class ControllerEthernet;
+class TransmitScheduler;
 
 #define NETWORKSFILE "xlights_networks.xml";
 
@@ -45,6 +47,20 @@ class OutputManager
     std::string _globalFPPProxy;
     std::string _globalForceLocalIP;
     wxCriticalSection _outputCriticalSection; // used to protect areas that must be single threaded
+    TransmitScheduler* _transmitScheduler = nullptr; // per interface senders used for parallel transmission
+
+    // the last whole frame passed to SetFrame and the output layout it was split across
+    struct FrameRange
+    {
+        Output* _output;
+        int32_t _start; // 0 based
+        int32_t _channels;
+    };
+    std::vector<unsigned char> _lastFrame;
+    std::vector<FrameRange> _frameRanges;
+    size_t _frameRangesSize = 0; // the frame size _frameRanges was built for
+    mutable std::atomic<bool> _frameRangesValid { false }; // cleared whenever the outputs change
+    std::atomic<bool> _lastFrameValid { false }; // cleared from any thread that writes channels outside SetFrame
     #pragma endregion 
 
     #pragma region Static Variables
@@ -200,6 +216,7 @@ public:
     #pragma region Data Setting
     void SetOneChannel(int32_t channel, unsigned char data);
     void SetManyChannels(int32_t channel, unsigned char* data, size_t size);
+    size_t SetFrame(unsigned char* data, size_t size); // returns the number of outputs that changed
     void AllOff(bool send = true);
     #pragma endregion 
 
@@ -0,0 +1,224 @@
+/***************************************************************
+ * This source files comes from the xLights project
+ * https://www.xlights.org
+ * https://github.com/smeighan/xLights
+ * See the github commit history for a record of contributing
+ * developers.
+ * Copyright claimed based on commit dates recorded in Github
+ * License: https://github.com/smeighan/xLights/blob/master/License.txt
+ **************************************************************/
+
+#include "TransmitScheduler.h"
+#include "Output.h"
+#include "../UtilFunctions.h"
+
+#ifdef __WXMSW__
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+#include <log4cpp/Category.hh>
+
+#pragma region Private Functions
+// keeps a sender on one core so its sockets stay warm in that core's cache ... best effort only
+static bool PinThread(std::thread& thread, int core)
+{
+    if (core < 0) return false;
+
+#ifdef __WXMSW__
+    if (core >= (int)(sizeof(DWORD_PTR) * 8)) return false;
+    return SetThreadAffinityMask(thread.native_handle(), (DWORD_PTR)1 << core) != 0;
+#elif defined(__WXOSX__)
+    // macOS does not let us pin a thread to a core
+    return false;
+#else
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(core, &cpus);
+    return pthread_setaffinity_np(thread.native_handle(), sizeof(cpus), &cpus) == 0;
+#endif
+}
+
+// the force local IP settings as they stand ... changing either means the interfaces must be worked out again
+static std::string GetForceLocalIPSetting(Output* output)
+{
+    return output->GetForceLocalIP() + "|" + output->GetGlobalForceLocalIP();
+}
+
+// the local IP the output sends from which is the forced one if there is one or else whichever the OS routes through
+static std::string GetInterfaceKey(Output* output)
+{
+    if (output->IsSerialOutput()) return "serial";
+    if (!output->IsIpOutput()) return "";
+
+    std::string key = output->GetForceLocalIPToUse();
+    if (key == "") {
+        std::string ip = output->GetResolvedIP();
+        if (ip == "") ip = output->GetIP();
+        key = GetLocalIPForRoute(ip);
+    }
+    return key;
+}
+
+void TransmitScheduler::SenderDone()
+{
+    std::unique_lock<std::mutex> lock(_doneLock);
+    if (--_pending == 0) {
+        _doneSignal.notify_all();
+    }
+}
+#pragma endregion
+
+#pragma region Interface Sender
+void TransmitScheduler::InterfaceSender::Run(int index)
+{
+#ifdef __WXOSX__
+    pthread_setname_np(("Transmit " + std::to_string(index)).c_str());
+#elif !defined(__WXMSW__)
+    pthread_setname_np(pthread_self(), ("Transmit " + std::to_string(index)).c_str());
+#endif
+
+    while (true) {
+        int suppressFrames;
+        {
+            std::unique_lock<std::mutex> lock(_lock);
+            _signal.wait(lock, [this] { return _send || _stop; });
+            if (_stop) return;
+            _send = false;
+            suppressFrames = _suppressFrames;
+        }
+
+        for (const auto& it : _outputs) {
+            it->EndFrame(suppressFrames);
+        }
+        _scheduler->SenderDone();
+    }
+}
+
+void TransmitScheduler::InterfaceSender::Start(int index, int core)
+{
+    static log4cpp::Category& logger_base = log4cpp::Category::getInstance(std::string("log_base"));
+
+    _thread = std::thread(&InterfaceSender::Run, this, index);
+    if (!PinThread(_thread, core)) core = -1;
+
+    logger_base.debug("    Interface '%s' sending %d outputs on core %d.",
+        _localIP == "" ? "default" : (const char*)_localIP.c_str(), (int)_outputs.size(), core);
+}
+
+void TransmitScheduler::InterfaceSender::Stop()
+{
+    {
+        std::unique_lock<std::mutex> lock(_lock);
+        _stop = true;
+    }
+    _signal.notify_one();
+    if (_thread.joinable()) {
+        _thread.join();
+    }
+}
+
+void TransmitScheduler::InterfaceSender::Send(int suppressFrames)
+{
+    {
+        std::unique_lock<std::mutex> lock(_lock);
+        _suppressFrames = suppressFrames;
+        _send = true;
+    }
+    _signal.notify_one();
+}
+#pragma endregion
+
+#pragma region Constructors and Destructors
+TransmitScheduler::~TransmitScheduler()
+{
+    Stop();
+}
+#pragma endregion
+
+#pragma region Start and Stop
+void TransmitScheduler::Start(const std::list<Output*>& outputs)
+{
+    static log4cpp::Category& logger_base = log4cpp::Category::getInstance(std::string("log_base"));
+
+    Stop();
+
+    _outputs.assign(outputs.begin(), outputs.end());
+
+    for (const auto& it : _outputs) {
+        _forceLocalIPs.push_back(GetForceLocalIPSetting(it));
+        std::string key = GetInterfaceKey(it);
+
+        InterfaceSender* sender = nullptr;
+        for (const auto& s : _senders) {
+            if (s->GetLocalIP() == key) {
+                sender = s;
+                break;
+            }
+        }
+        if (sender == nullptr) {
+            sender = new InterfaceSender(this, key);
+            _senders.push_back(sender);
+        }
+        sender->AddOutput(it);
+    }
+
+    // everything on one interface gains nothing from a thread so leave it to the caller
+    if (_senders.size() < 2) {
+        for (const auto& it : _senders) {
+            delete it;
+        }
+        _senders.clear();
+        return;
+    }
+
+    // core 0 is left for the thread building the frames
+    int cores = std::thread::hardware_concurrency();
+    logger_base.debug("Transmit scheduler starting %d interface senders.", (int)_senders.size());
+    for (size_t i = 0; i < _senders.size(); i++) {
+        _senders[i]->Start(i, cores > 1 ? 1 + i % (cores - 1) : -1);
+    }
+}
+
+void TransmitScheduler::Stop()
+{
+    for (const auto& it : _senders) {
+        it->Stop();
+        delete it;
+    }
+    _senders.clear();
+    _outputs.clear();
+    _forceLocalIPs.clear();
+}
+#pragma endregion
+
+#pragma region Frame Handling
+bool TransmitScheduler::Matches(const std::list<Output*>& outputs) const
+{
+    if (outputs.size() != _outputs.size()) return false;
+
+    size_t i = 0;
+    for (const auto& it : outputs) {
+        if (it != _outputs[i] || GetForceLocalIPSetting(it) != _forceLocalIPs[i]) return false;
+        ++i;
+    }
+    return true;
+}
+
+void TransmitScheduler::EndFrame(int suppressFrames)
+{
+    if (_senders.empty()) return;
+
+    {
+        std::unique_lock<std::mutex> lock(_doneLock);
+        _pending = _senders.size();
+    }
+    for (const auto& it : _senders) {
+        it->Send(suppressFrames);
+    }
+
+    std::unique_lock<std::mutex> lock(_doneLock);
+    _doneSignal.wait(lock, [this] { return _pending == 0; });
+}
+#pragma endregion
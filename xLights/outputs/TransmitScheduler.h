@@ -0,0 +1,80 @@
+#pragma once
+
+/***************************************************************
+ * This source files comes from the xLights project
+ * https://www.xlights.org
+ * https://github.com/smeighan/xLights
+ * See the github commit history for a record of contributing
+ * developers.
+ * Copyright claimed based on commit dates recorded in Github
+ * License: https://github.com/smeighan/xLights/blob/master/License.txt
+ **************************************************************/
+
+#include <condition_variable>
+#include <list>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+class Output;
+
+// Sends each frame from one thread per local network interface so a show computer with controllers
+// on several networks transmits on all of them at once. Outputs are grouped by the local IP they are
+// bound to (the controller or global force local IP) or failing that the local IP the OS routes their
+// controller through, and serial outputs share a group of their own so slow serial ports never hold up a
+// network. Each thread only ever touches the sockets of its own group.
+class TransmitScheduler
+{
+    class InterfaceSender
+    {
+        TransmitScheduler* _scheduler;
+        std::string _localIP;
+        std::vector<Output*> _outputs;
+        std::thread _thread;
+        std::mutex _lock;
+        std::condition_variable _signal;
+        bool _send = false;
+        bool _stop = false;
+        int _suppressFrames = 0;
+
+        void Run(int index);
+
+    public:
+        InterfaceSender(TransmitScheduler* scheduler, const std::string& localIP) : _scheduler(scheduler), _localIP(localIP) {}
+        void AddOutput(Output* output) { _outputs.push_back(output); }
+        const std::string& GetLocalIP() const { return _localIP; }
+        size_t GetOutputCount() const { return _outputs.size(); }
+        void Start(int index, int core);
+        void Stop();
+        void Send(int suppressFrames);
+    };
+
+    std::vector<Output*> _outputs;
+    std::vector<std::string> _forceLocalIPs; // what each output's interface was chosen with
+    std::vector<InterfaceSender*> _senders;
+    std::mutex _doneLock;
+    std::condition_variable _doneSignal;
+    int _pending = 0;
+
+    void SenderDone();
+
+public:
+
+    #pragma region Constructors and Destructors
+    TransmitScheduler() {}
+    virtual ~TransmitScheduler();
+    #pragma endregion
+
+    // groups the outputs and starts a sender thread per interface ... no threads are started if there is only one
+    void Start(const std::list<Output*>& outputs);
+    void Stop();
+
+    // true if the outputs and their force local IPs are the ones the senders were started with
+    bool Matches(const std::list<Output*>& outputs) const;
+    // zero when everything is on one interface and no senders were started
+    size_t GetInterfaceCount() const { return _senders.size(); }
+
+    // ends the frame on every output and returns once all interfaces have sent
+    void EndFrame(int suppressFrames);
+};
@@ -945,6 +945,15 @@ void ZCPPOutput::SetManyChannels(int32_t channel, unsigned char* data, size_t si
     }
 }
 
+void ZCPPOutput::SetManyChannelsChanged(int32_t channel, unsigned char* data, size_t size) {
+
+    if (!_enabled) return;
+
+    size_t chs = std::min(size, (size_t)(_channels - channel));
+    memcpy(&_data[channel], data, chs);
+    _changed = true;
+}
+
 void ZCPPOutput::AllOff() {
 
     if (!_enabled) return;
@@ -112,6 +112,10 @@ public:
     void SetPriority(int priority) { if (_priority != priority) { _priority = priority; _dirty = true; } }
     int GetPriority() const { return _priority; }
 
+    // normally worked out from the model data uploaded to the controller
+    void SetUsedChannels(long usedChannels) { _usedChannels = std::min(usedChannels, (long)_channels); }
+    long GetUsedChannels() const { return _usedChannels; }
+
     void AllOn();
 
     void AddProtocol(const std::string& protocol) {
@@ -142,6 +146,7 @@ public:
     #pragma region Data Setting
     virtual void SetOneChannel(int32_t channel, unsigned char data) override;
     virtual void SetManyChannels(int32_t channel, unsigned char* data, size_t size) override;
+    virtual void SetManyChannelsChanged(int32_t channel, unsigned char* data, size_t size) override;
     virtual void AllOff() override;
     #pragma endregion 
     
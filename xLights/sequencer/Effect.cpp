@@ -174,20 +174,58 @@ void Effect::ParseColorMap(const SettingsMap &mPaletteMap, xlColorVector &mColor
 
 Effect::Effect(EffectManager* effectManager, EffectLayer* parent,int id, const std::string & name, const std::string &settings, const std::string &palette,
                int startTimeMS, int endTimeMS, int Selected, bool Protected)
-    : mParentLayer(parent), mID(id), mEffectIndex(-1), mName(nullptr),
-      mStartTime(startTimeMS), mEndTime(endTimeMS), mSelected(Selected), mTagged(false), mProtected(Protected), mCache(nullptr)
+    : Effect(effectManager, parent, id, name, std::make_shared<const std::string>(settings), std::make_shared<const std::string>(palette),
+             startTimeMS, endTimeMS, Selected, Protected)
 {
-    //static log4cpp::Category& logger_base = log4cpp::Category::getInstance(std::string("log_base"));
+    Materialize();
+}
 
+// Lazy constructor used when loading sequences ... the settings and palette are only parsed when first needed
+Effect::Effect(EffectManager* effectManager, EffectLayer* parent, int id, const std::string& name, const std::shared_ptr<const std::string>& settings, const std::shared_ptr<const std::string>& palette,
+               int startTimeMS, int endTimeMS, int Selected, bool Protected)
+    : mParentLayer(parent), mID(id), mEffectIndex(-1), mName(nullptr),
+      mStartTime(startTimeMS), mEndTime(endTimeMS), mSelected(Selected), mTagged(false), mProtected(Protected), mCache(nullptr),
+      mEffectManager(effectManager), mRawSettings(settings), mRawPalette(palette), mMaterialized(false)
+{
     mColorMask = xlColor::NilColor();
     mEffectIndex = (parent->GetParentElement() == nullptr) ? -1 : parent->GetParentElement()->GetSequenceElements()->GetEffectManager().GetEffectIndex(name);
+
+    if (mEndTime < mStartTime)
+    {
+        //should never happend, but if we load something with invalid times, make sure we can at least
+        //show/select/delete the effect
+        int tmp = mStartTime;
+        mStartTime = mEndTime;
+        mEndTime = tmp;
+    }
+    if (mEffectIndex == -1) {
+        mName = new std::string(name);
+    }
+}
+
+Effect::~Effect()
+{
+    if (mCache) {
+        mCache->Delete();
+        mCache = nullptr;
+    }
+    if (mName != nullptr)
+    {
+        delete mName;
+    }
+}
+
+#pragma endregion
+
+void Effect::ParseSettings(EffectManager* effectManager, const std::string& name, const std::string& settings, const std::string& palette) const
+{
     mSettings.Parse(effectManager, settings, name);
 
-    Element* parentElement = parent->GetParentElement();
+    Element* parentElement = mParentLayer->GetParentElement();
     if (parentElement != nullptr)
     {
         Model* model = parentElement->GetSequenceElements()->GetXLightsFrame()->AllModels[parentElement->GetModelName()];
-        FixBuffer(model);
+        DoFixBuffer(model);
     }
 
     // Fixes an erroneous blank settings created by using:
@@ -203,50 +241,39 @@ Effect::Effect(EffectManager* effectManager, EffectLayer* parent,int id, const s
         mSettings.erase("Converted");
     }
 
-    // check for any other odd looking blank settings
-    //for (const auto& it : mSettings)
-    //{
-    //    if (it.second == "")
-    //    {
-    //        logger_base.warn("Effect '%s' on model '%s' at time '%s' has setting '%s' with a blank value.",
-    //            (const char *)name.c_str(),
-    //            (const char *)(parent->GetParentElement() == nullptr ? "" : parent->GetParentElement()->GetName().c_str()),
-    //            FORMATTIME(startTimeMS),
-    //            (const char *)it.first.c_str()
-    //            );
-    //    }
-    //}
-
-    if (mEndTime < mStartTime)
-    {
-        //should never happend, but if we load something with invalid times, make sure we can at least
-        //show/select/delete the effect
-        int tmp = mStartTime;
-        mStartTime = mEndTime;
-        mEndTime = tmp;
-    }
-    if (mEffectIndex == -1) {
-        mName = new std::string(name);
-    }
-
     mPaletteMap.Parse(effectManager, palette, name);
     ParseColorMap(mPaletteMap, mColors, mCC);
 }
 
-Effect::~Effect()
+void Effect::Materialize() const
 {
-    if (mCache) {
-        mCache->Delete();
-        mCache = nullptr;
-    }
-    if (mName != nullptr)
+    std::unique_lock<std::recursive_mutex> lock(settingsLock);
+    if (mMaterialized) return;
+
+    ParseSettings(mEffectManager, GetEffectName(), *mRawSettings, *mRawPalette);
+    mRawSettings.reset();
+    mRawPalette.reset();
+
+    // only flag it once everything is parsed as readers check this without taking the lock
+    mMaterialized = true;
+}
+
+// Answers simple presence checks without parsing an effect which has not been materialised
+bool Effect::RawSettingsContains(const std::string& key) const
+{
+    const std::string& raw = *mRawSettings;
+    size_t pos = raw.find(key);
+    while (pos != std::string::npos)
     {
-        delete mName;
+        if ((pos == 0 || raw[pos - 1] == ',') && pos + key.size() < raw.size() && raw[pos + key.size()] == '=')
+        {
+            return true;
+        }
+        pos = raw.find(key, pos + 1);
     }
+    return false;
 }
 
-#pragma endregion
-
 void Effect::SetTimeToDelete()
 {
     // we can delete the effect 1 minute later ... this tries to guarantee all dangling pointers are gone at the expense of some memory use
@@ -262,6 +289,7 @@ bool Effect::IsTimeToDelete() const
 
 void Effect::SetEffectIndex(int effectIndex)
 {
+    EnsureMaterialized();
     if (mEffectIndex != effectIndex)
     {
         mEffectIndex = effectIndex;
@@ -307,6 +335,7 @@ const std::string& Effect::GetEffectName(int index) const
 
 void Effect::SetEffectName(const std::string & name)
 {
+    EnsureMaterialized();
     int idx = GetParentEffectLayer()->GetParentElement()->GetSequenceElements()->GetEffectManager().GetEffectIndex(name);
     if (mEffectIndex != idx || mEffectIndex == -1)
     {
@@ -327,6 +356,7 @@ void Effect::SetEffectName(const std::string & name)
 
 std::string Effect::GetSetting(const std::string& id) const
 {
+    EnsureMaterialized();
     std::unique_lock<std::recursive_mutex> lock(settingsLock);
     if (mSettings.Contains(id)) {
         return mSettings[id];
@@ -378,6 +408,7 @@ bool Effect::OverlapsWith(int startTimeMS, int EndTimeMS) const
 
 void Effect::ConvertTo(int effectIndex)
 {
+    EnsureMaterialized();
     if (effectIndex != mEffectIndex)
     {
         SetEffectIndex(effectIndex);
@@ -422,6 +453,7 @@ bool Effect::IsModelRenderDisabled() const
 bool Effect::IsEffectRenderDisabled() const
 {
     std::unique_lock<std::recursive_mutex> lock(settingsLock);
+    if (!mMaterialized) return RawSettingsContains("X_Effect_RenderDisabled");
     return mSettings.Contains("X_Effect_RenderDisabled");
 }
 
@@ -434,6 +466,7 @@ bool Effect::IsRenderDisabled() const
 
 void Effect::SetEffectRenderDisabled(bool disabled)
 {
+    EnsureMaterialized();
     std::unique_lock<std::recursive_mutex> getlock(settingsLock);
     if (disabled) {
         mSettings["X_Effect_RenderDisabled"] = "True";
@@ -446,11 +479,13 @@ void Effect::SetEffectRenderDisabled(bool disabled)
 bool Effect::IsLocked() const
 {
     std::unique_lock<std::recursive_mutex> lock(settingsLock);
+    if (!mMaterialized) return RawSettingsContains("X_Effect_Locked");
     return mSettings.Contains("X_Effect_Locked");
 }
 
 void Effect::SetLocked(bool lock)
 {
+    EnsureMaterialized();
     std::unique_lock<std::recursive_mutex> getlock(settingsLock);
     if (lock)
     {
@@ -474,17 +509,20 @@ void Effect::IncrementChangeCount()
 
 std::string Effect::GetSettingsAsString() const
 {
+    EnsureMaterialized();
     std::unique_lock<std::recursive_mutex> lock(settingsLock);
     return mSettings.AsString();
 }
 
 std::string Effect::GetSettingsAsJSON() const
 {
+    EnsureMaterialized();
     std::unique_lock<std::recursive_mutex> lock(settingsLock);
     return mSettings.AsJSON();
 }
 
 void Effect::SetSettings(const std::string& settings, bool keepxsettings, bool json) {
+    EnsureMaterialized();
     std::unique_lock<std::recursive_mutex> lock(settingsLock);
 
     auto old = GetSettingsAsString();
@@ -512,6 +550,7 @@ void Effect::SetSettings(const std::string& settings, bool keepxsettings, bool j
 // this is not sensitive to the order of the settings in the string ... it compares the effect settings with the provide settings string and return true if anything has changed
 bool Effect::SettingsChanged(const std::string& settings)
 {
+    EnsureMaterialized();
     SettingsMap x;
     x.Parse(nullptr, settings, "");
 
@@ -528,6 +567,7 @@ bool Effect::SettingsChanged(const std::string& settings)
 
 void Effect::PressButton(RenderableEffect* re, const std::string& id)
 {
+    EnsureMaterialized();
     bool changed = false;
     if (StartsWith(id, "E_"))
     {
@@ -543,6 +583,7 @@ void Effect::PressButton(RenderableEffect* re, const std::string& id)
 
 void Effect::ApplySetting(const std::string& id, const std::string& value, ValueCurve* vc, const std::string& vcid)
 {
+    EnsureMaterialized();
     static log4cpp::Category& logger_base = log4cpp::Category::getInstance(std::string("log_base"));
     wxString idd(id);
     if (idd.StartsWith("C_"))
@@ -623,6 +664,7 @@ void Effect::ApplySetting(const std::string& id, const std::string& value, Value
 
 bool Effect::UsesColour(const std::string& from)
 {
+    EnsureMaterialized();
     for (auto it : mPaletteMap) {
         if (StartsWith(it.first, "C_BUTTON")) { // only check the colours
             if (Lower(it.second) == Lower(from)) { // check the colours match
@@ -638,6 +680,7 @@ bool Effect::UsesColour(const std::string& from)
 
 int Effect::ReplaceColours(xLightsFrame* frame, const std::string& from, const std::string& to)
 {
+    EnsureMaterialized();
     int res = 0;
     for (auto it : mPaletteMap) {
         if (StartsWith(it.first, "C_BUTTON")) {
@@ -665,9 +708,10 @@ int Effect::ReplaceColours(xLightsFrame* frame, const std::string& from, const s
 
 void Effect::CopySettingsMap(SettingsMap &target, bool stripPfx) const
 {
+    EnsureMaterialized();
     std::unique_lock<std::recursive_mutex> lock(settingsLock);
 
-    for (std::map<std::string,std::string>::const_iterator it=mSettings.begin(); it!=mSettings.end(); ++it)
+    for (auto it=mSettings.cbegin(); it!=mSettings.cend(); ++it)
     {
         std::string name = it->first;
         if (stripPfx && name[1] == '_')
@@ -676,7 +720,7 @@ void Effect::CopySettingsMap(SettingsMap &target, bool stripPfx) const
         }
         target[name] = it->second;
     }
-    for (std::map<std::string,std::string>::const_iterator it=mPaletteMap.begin(); it!=mPaletteMap.end(); ++it)
+    for (auto it=mPaletteMap.cbegin(); it!=mPaletteMap.cend(); ++it)
     {
         std::string name = it->first;
         if (stripPfx && name[1] == '_'  && (name[2] == 'S' || name[2] == 'C' || name[2] == 'V')) //only need the slider, checkbox and value curve entries
@@ -689,6 +733,12 @@ void Effect::CopySettingsMap(SettingsMap &target, bool stripPfx) const
 
 // When an effect is copied between model types the buffer may not be supported so make it valid
 void Effect::FixBuffer(const Model* m)
+{
+    EnsureMaterialized();
+    DoFixBuffer(m);
+}
+
+void Effect::DoFixBuffer(const Model* m) const
 {
     if (m == nullptr) return;
 
@@ -710,23 +760,27 @@ void Effect::FixBuffer(const Model* m)
 
 bool Effect::IsPersistent() const
 {
+    EnsureMaterialized();
     return mSettings.GetBool("B_CHECKBOX_OverlayBkg", false);
 }
 
 std::string Effect::GetPaletteAsString() const
 {
+    EnsureMaterialized();
     std::unique_lock<std::recursive_mutex> lock(settingsLock);
     return mPaletteMap.AsString();
 }
 
 std::string Effect::GetPaletteAsJSON() const
 {
+    EnsureMaterialized();
     std::unique_lock<std::recursive_mutex> lock(settingsLock);
     return mPaletteMap.AsJSON();
 }
 
 void Effect::SetPalette(const std::string& i)
 {
+    EnsureMaterialized();
     std::unique_lock<std::recursive_mutex> lock(settingsLock);
 
     auto old = GetPaletteAsString();
@@ -745,6 +799,7 @@ void Effect::SetPalette(const std::string& i)
 // This only updates the colour palette ... preserving all the other colour settings
 void Effect::SetColourOnlyPalette(const std::string& i, bool json)
 {
+    EnsureMaterialized();
     std::unique_lock<std::recursive_mutex> lock(settingsLock);
 
     // save the old palette
@@ -775,12 +830,14 @@ void Effect::SetColourOnlyPalette(const std::string& i, bool json)
 
 void Effect::CopyPalette(xlColorVector &target, xlColorCurveVector& newcc) const
 {
+    EnsureMaterialized();
     std::unique_lock<std::recursive_mutex> lock(settingsLock);
     target = mColors;
     newcc = mCC;
 }
 
 void Effect::PaletteMapUpdated() {
+    EnsureMaterialized();
     std::unique_lock<std::recursive_mutex> lock(settingsLock);
     mColors.clear();
     mCC.clear();
@@ -15,6 +15,8 @@
 #include <vector>
 #include <string>
 #include <mutex>
+#include <memory>
+#include <atomic>
 
 #include "../ColorCurve.h" // This needs to be here
 #include "../UtilClasses.h"
@@ -52,23 +54,41 @@ class Effect
     EffectLayer* mParentLayer = nullptr;
     xlColor mColorMask = xlBLACK;
     mutable std::recursive_mutex settingsLock;
-    SettingsMap mSettings;
-    SettingsMap mPaletteMap;
-    xlColorVector mColors;
-    xlColorCurveVector mCC;
+    mutable SettingsMap mSettings;
+    mutable SettingsMap mPaletteMap;
+    mutable xlColorVector mColors;
+    mutable xlColorCurveVector mCC;
     xlDisplayList background;
     RenderCacheItem *mCache = nullptr;
     wxLongLong _timeToDelete = 0;
 
+    // When an effect is loaded lazily the settings and palette strings are kept as loaded (shared with
+    // every other effect using the same strings) and only parsed into the maps above on first use
+    EffectManager* mEffectManager = nullptr;
+    mutable std::shared_ptr<const std::string> mRawSettings;
+    mutable std::shared_ptr<const std::string> mRawPalette;
+    mutable std::atomic_bool mMaterialized{ true };
+
     Effect() {}  //don't allow default or copy constructor
     Effect(const Effect &e) {}
     static void ParseColorMap(const SettingsMap &mPaletteMap, xlColorVector &mColors, xlColorCurveVector& mCC);
+    void ParseSettings(EffectManager* effectManager, const std::string& name, const std::string& settings, const std::string& palette) const;
+    void DoFixBuffer(const Model* m) const;
+    void Materialize() const;
+    void EnsureMaterialized() const { if (!mMaterialized) Materialize(); }
+    bool RawSettingsContains(const std::string& key) const;
 
 public:
     Effect(EffectManager* effectManager, EffectLayer* parent, int id, const std::string & name, const std::string &settings, const std::string &palette,
         int startTimeMS, int endTimeMS, int Selected, bool Protected);
+    Effect(EffectManager* effectManager, EffectLayer* parent, int id, const std::string & name, const std::shared_ptr<const std::string>& settings, const std::shared_ptr<const std::string>& palette,
+        int startTimeMS, int endTimeMS, int Selected, bool Protected);
     virtual ~Effect();
 
+    // parse the settings and palette now if they were loaded lazily
+    bool IsMaterialized() const { return mMaterialized; }
+    void MaterializeSettings() const { EnsureMaterialized(); }
+
     int GetID() const { return mID; }
     void SetID(int i) { mID = i; }
 
@@ -124,16 +144,16 @@ public:
     bool UsesColour(const std::string& from);
     int ReplaceColours(xLightsFrame* frame, const std::string& from, const std::string& to);
     void PressButton(RenderableEffect* re, const std::string& id);
-    const SettingsMap &GetSettings() const { return mSettings; }
+    const SettingsMap &GetSettings() const { EnsureMaterialized(); return mSettings; }
     void CopySettingsMap(SettingsMap &target, bool stripPfx = false) const;
     void FixBuffer(const Model* m);
     bool IsPersistent() const;
 
 
 
-    const xlColorVector &GetPalette() const { return mColors; }
-    int GetPaletteSize() const { return mColors.size(); }
-    const SettingsMap &GetPaletteMap() const { return mPaletteMap; }
+    const xlColorVector &GetPalette() const { EnsureMaterialized(); return mColors; }
+    int GetPaletteSize() const { EnsureMaterialized(); return mColors.size(); }
+    const SettingsMap &GetPaletteMap() const { EnsureMaterialized(); return mPaletteMap; }
     std::string GetPaletteAsString() const;
     std::string GetPaletteAsJSON() const;
     void SetPalette(const std::string& i);
@@ -141,9 +161,9 @@ public:
     void CopyPalette(xlColorVector &target, xlColorCurveVector& newcc) const;
 
     /* Do NOT call these on any thread other than the main thread */
-    SettingsMap &GetSettings() { return mSettings; }
-    xlColorVector &GetPalette() { return mColors; }
-    SettingsMap &GetPaletteMap() { return mPaletteMap; }
+    SettingsMap &GetSettings() { EnsureMaterialized(); return mSettings; }
+    xlColorVector &GetPalette() { EnsureMaterialized(); return mColors; }
+    SettingsMap &GetPaletteMap() { EnsureMaterialized(); return mPaletteMap; }
     void PaletteMapUpdated();
 
     xlDisplayList &GetBackgroundDisplayList() { return background; }
@@ -187,14 +187,10 @@ void EffectLayer::RemoveAllEffects(UndoManager *undo_mgr)
     NumberEffects();
 }
 
-Effect* EffectLayer::AddEffect(int id, const std::string &n, const std::string &settings, const std::string &palette,
-                               int startTimeMS, int endTimeMS, int Selected, bool Protected, bool suppress_sort)
+bool EffectLayer::ValidateNewEffect(std::string& name, int& startTimeMS, int endTimeMS) const
 {
-    std::unique_lock<std::recursive_mutex> locker(lock);
-    std::string name(n);
-
     // really dont want to add effects which look invalid - some imports result in this
-    if (startTimeMS > endTimeMS) return nullptr;
+    if (startTimeMS > endTimeMS) return false;
 
     if (GetParentElement() != nullptr && GetParentElement()->GetType() == ElementType::ELEMENT_TYPE_MODEL) {
         if (name == "") {
@@ -205,7 +201,7 @@ Effect* EffectLayer::AddEffect(int id, const std::string &n, const std::string &
         {
             log4cpp::Category &logger_base = log4cpp::Category::getInstance(std::string("log_base"));
             logger_base.warn("Unknown effect: " + name + ". Not loaded. " + GetParentElement()->GetModelName());
-            return nullptr;
+            return false;
         }
     }
 
@@ -216,13 +212,17 @@ Effect* EffectLayer::AddEffect(int id, const std::string &n, const std::string &
     if (startTimeMS < 0 && endTimeMS <= 0)
     {
         // This effect is not visible ... so lets not load it
-        return nullptr;
+        return false;
     }
 
     // make sure they dont hang over the left side
     if (startTimeMS < 0) startTimeMS = 0;
 
-    Effect* e = new Effect(&GetParentElement()->GetSequenceElements()->GetEffectManager(), this, id, name, settings, palette, startTimeMS, endTimeMS, Selected, Protected);
+    return true;
+}
+
+Effect* EffectLayer::InsertNewEffect(Effect* e, int startTimeMS, int endTimeMS, bool suppress_sort)
+{
     wxASSERT(e != nullptr);
     mEffects.push_back(e);
     if (!suppress_sort)
@@ -233,6 +233,30 @@ Effect* EffectLayer::AddEffect(int id, const std::string &n, const std::string &
     return e;
 }
 
+Effect* EffectLayer::AddEffect(int id, const std::string &n, const std::string &settings, const std::string &palette,
+                               int startTimeMS, int endTimeMS, int Selected, bool Protected, bool suppress_sort)
+{
+    std::unique_lock<std::recursive_mutex> locker(lock);
+    std::string name(n);
+
+    if (!ValidateNewEffect(name, startTimeMS, endTimeMS)) return nullptr;
+
+    Effect* e = new Effect(&GetParentElement()->GetSequenceElements()->GetEffectManager(), this, id, name, settings, palette, startTimeMS, endTimeMS, Selected, Protected);
+    return InsertNewEffect(e, startTimeMS, endTimeMS, suppress_sort);
+}
+
+Effect* EffectLayer::AddEffect(int id, const std::string &n, const std::shared_ptr<const std::string> &settings, const std::shared_ptr<const std::string> &palette,
+                               int startTimeMS, int endTimeMS, int Selected, bool Protected, bool suppress_sort)
+{
+    std::unique_lock<std::recursive_mutex> locker(lock);
+    std::string name(n);
+
+    if (!ValidateNewEffect(name, startTimeMS, endTimeMS)) return nullptr;
+
+    Effect* e = new Effect(&GetParentElement()->GetSequenceElements()->GetEffectManager(), this, id, name, settings, palette, startTimeMS, endTimeMS, Selected, Protected);
+    return InsertNewEffect(e, startTimeMS, endTimeMS, suppress_sort);
+}
+
 void EffectLayer::NumberEffects()
 {
     for (int x = 0; x < mEffects.size(); x++) {
@@ -15,6 +15,7 @@
 #include <string>
 #include <list>
 #include <mutex>
+#include <memory>
 #include "Effect.h"
 #include "UndoManager.h"
 #include "../effects/EffectManager.h"
@@ -37,6 +38,9 @@ class EffectLayer
 
         Effect *AddEffect(int id, const std::string &name, const std::string &settings, const std::string &palette,
                           int startTimeMS, int endTimeMS, int Selected, bool Protected, bool suppress_sort = false);
+        // Adds an effect whose settings and palette are only parsed when first used ... used when loading sequences
+        Effect *AddEffect(int id, const std::string &name, const std::shared_ptr<const std::string> &settings, const std::shared_ptr<const std::string> &palette,
+                          int startTimeMS, int endTimeMS, int Selected, bool Protected, bool suppress_sort = false);
         Effect* GetEffect(int index) const;
         const std::vector<Effect*>& GetEffects() const { return mEffects; }
         Effect* GetEffectByTime(int ms);
@@ -128,6 +132,8 @@ class EffectLayer
     private:
         void SortEffects();
         void PlayEffect(Effect* effect);
+        bool ValidateNewEffect(std::string& name, int& startTimeMS, int endTimeMS) const;
+        Effect* InsertNewEffect(Effect* e, int startTimeMS, int endTimeMS, bool suppress_sort);
 
         static std::atomic_int exclusive_index;
 
@@ -27,6 +27,7 @@
 #include "../SequenceViewManager.h"
 #include "../JukeboxPanel.h"
 #include "../TraceLog.h"
+#include "../Parallel.h"
 #include "../UtilFunctions.h"
 
 #include <log4cpp/Category.hh>
@@ -643,16 +644,19 @@ void SequenceElements::MoveElement(int index,int destinationIndex)
 int SequenceElements::LoadEffects(EffectLayer* effectLayer,
     const std::string& type,
     wxXmlNode* effectLayerNode,
-    const std::vector<std::string>& effectStrings,
-    const std::vector<std::string>& colorPalettes)
+    const std::vector<std::shared_ptr<const std::string>>& effectStrings,
+    const std::vector<std::shared_ptr<const std::string>>& colorPalettes)
 {
     static log4cpp::Category& logger_base = log4cpp::Category::getInstance(std::string("log_base"));
+    static const std::shared_ptr<const std::string> EMPTY_SETTINGS = StringIntern::Intern(std::string());
 
     int loaded = 0;
     for (wxXmlNode* effect = effectLayerNode->GetChildren(); effect != nullptr; effect = effect->GetNext()) {
         if (effect->GetName() == STR_EFFECT) {
             std::string effectName;
-            std::string settings;
+            // settings and palettes are shared between all effects which use the same EffectDB/ColorPalettes entry
+            // and are only parsed when the effect is first used
+            std::shared_ptr<const std::string> settings = EMPTY_SETTINGS;
             int id = 0;
             long palette = -1;
 
@@ -675,21 +679,20 @@ int SequenceElements::LoadEffects(EffectLayer* effectLayer,
                     int ref = wxAtoi(effect->GetAttribute(STR_REF));
                     if (ref >= effectStrings.size()) {
                         logger_base.warn("Effect string not found for effect %s between %d and %d. Settings ignored.", (const char*)effectName.c_str(), (int)startTime, (int)endTime);
-                        settings = "";
                     }
                     else {
                         settings = effectStrings[ref];
                     }
                 }
                 else {
-                    settings = ToStdString(effect->GetNodeContent());
+                    settings = StringIntern::Intern(ToStdString(effect->GetNodeContent()));
                 }
 
-                if (settings.find("E_FILEPICKER_Pictures_Filename") != std::string::npos) {
-                    settings = FixEffectFileParameter("E_FILEPICKER_Pictures_Filename", settings, "");
+                if (settings->find("E_FILEPICKER_Pictures_Filename") != std::string::npos) {
+                    settings = StringIntern::Intern(FixEffectFileParameter("E_FILEPICKER_Pictures_Filename", *settings, "").ToStdString());
                 }
-                else if (settings.find("E_FILEPICKER_Glediator_Filename") != std::string::npos) {
-                    settings = FixEffectFileParameter("E_FILEPICKER_Glediator_Filename", settings, "");
+                else if (settings->find("E_FILEPICKER_Glediator_Filename") != std::string::npos) {
+                    settings = StringIntern::Intern(FixEffectFileParameter("E_FILEPICKER_Glediator_Filename", *settings, "").ToStdString());
                 }
 
                 wxString tmp;
@@ -701,7 +704,7 @@ int SequenceElements::LoadEffects(EffectLayer* effectLayer,
                 // store timing labels in name attribute
                 effectName = UnXmlSafe(effect->GetAttribute(STR_LABEL));
             }
-            std::string pal = STR_EMPTY;
+            std::shared_ptr<const std::string> pal = EMPTY_SETTINGS;
             if (palette != -1) {
                 pal = colorPalettes[palette];
             }
@@ -727,6 +730,66 @@ int SequenceElements::LoadEffects(EffectLayer* effectLayer,
     return loaded;
 }
 
+static void AddUnmaterializedEffects(EffectLayer* layer, std::vector<Effect*>& effects, size_t maxEffects)
+{
+    if (layer == nullptr) return;
+    for (const auto& it : layer->GetEffects()) {
+        if (effects.size() >= maxEffects) return;
+        if (!it->IsMaterialized()) {
+            effects.push_back(it);
+        }
+    }
+}
+
+bool SequenceElements::MaterializeEffects(size_t maxEffects)
+{
+    if (!mEffectsToMaterialize) return false;
+
+    // Gather the batch on the main thread where effects are added and removed so the batch cannot go stale
+    std::vector<Effect*> effects;
+    size_t count = GetElementCount();
+    size_t scanned = 0;
+    while (effects.size() < maxEffects && scanned < count) {
+        if (mMaterializeElement >= count) {
+            mMaterializeElement = 0;
+        }
+        Element* elem = GetElement(mMaterializeElement);
+        for (size_t l = 0; l < elem->GetEffectLayerCount(); l++) {
+            AddUnmaterializedEffects(elem->GetEffectLayer(l), effects, maxEffects);
+        }
+        if (elem->GetType() == ElementType::ELEMENT_TYPE_MODEL) {
+            ModelElement* me = dynamic_cast<ModelElement*>(elem);
+            for (int s = 0; s < me->GetSubModelAndStrandCount(); s++) {
+                SubModelElement* se = me->GetSubModel(s);
+                for (size_t l = 0; l < se->GetEffectLayerCount(); l++) {
+                    AddUnmaterializedEffects(se->GetEffectLayer(l), effects, maxEffects);
+                }
+                if (se->GetType() == ElementType::ELEMENT_TYPE_STRAND) {
+                    StrandElement* ste = dynamic_cast<StrandElement*>(se);
+                    for (int n = 0; n < ste->GetNodeLayerCount(); n++) {
+                        AddUnmaterializedEffects(ste->GetNodeLayer(n), effects, maxEffects);
+                    }
+                }
+            }
+        }
+        if (effects.size() < maxEffects) {
+            // this element is done
+            mMaterializeElement++;
+            scanned++;
+        }
+    }
+
+    if (effects.empty()) {
+        mEffectsToMaterialize = false;
+        return false;
+    }
+
+    parallel_for(0, (int)effects.size(), [&effects](int i) {
+        effects[i]->MaterializeSettings();
+    }, 16);
+    return true;
+}
+
 bool SequenceElements::LoadSequencerFile(xLightsXmlFile& xml_file, const wxString& ShowDir)
 {
     static log4cpp::Category& logger_base = log4cpp::Category::getInstance(std::string("log_base"));
@@ -737,11 +800,15 @@ bool SequenceElements::LoadSequencerFile(xLightsXmlFile& xml_file, const wxStrin
     wxXmlDocument& seqDocument = xml_file.GetXmlDocument();
 
     wxXmlNode* root = seqDocument.GetRoot();
-    std::vector<std::string> effectStrings;
-    std::vector<std::string> colorPalettes;
+    std::vector<std::shared_ptr<const std::string>> effectStrings;
+    std::vector<std::shared_ptr<const std::string>> colorPalettes;
     TraceLog::AddTraceMessage("About to clear sequence");
     Clear();
     TraceLog::AddTraceMessage("   Cleared");
+    // drop the strings the previous sequence was holding
+    StringIntern::Purge();
+    mEffectsToMaterialize = true;
+    mMaterializeElement = 0;
     supportsModelBlending = xml_file.supportsModelBlending();
     for (wxXmlNode* e = root->GetChildren(); e != nullptr; e = e->GetNext()) {
         TraceLog::PushTraceContext();
@@ -806,14 +873,14 @@ bool SequenceElements::LoadSequencerFile(xLightsXmlFile& xml_file, const wxStrin
                         elementNode->SetContent(FixEffectFileParameter("E_TEXTCTRL_Glediator_Filename", elementNode->GetNodeContent(), ShowDir));
                     }
 
-                    effectStrings.push_back(ToStdString(elementNode->GetNodeContent()));
+                    effectStrings.push_back(StringIntern::Intern(ToStdString(elementNode->GetNodeContent())));
                 }
             }
         } else if (e->GetName() == "ColorPalettes") {
             colorPalettes.clear();
             for (wxXmlNode* elementNode = e->GetChildren(); elementNode != nullptr; elementNode = elementNode->GetNext()) {
                 if (elementNode->GetName() == STR_COLORPALETTE) {
-                    colorPalettes.push_back(ToStdString(elementNode->GetNodeContent()));
+                    colorPalettes.push_back(StringIntern::Intern(ToStdString(elementNode->GetNodeContent())));
                 }
             }
         } else if (e->GetName() == "Jukebox") {
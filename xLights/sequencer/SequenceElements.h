@@ -207,13 +207,16 @@ public:
     wxFileName &GetFileName() { return mFilename; }
     EffectManager &GetEffectManager();
     xLightsFrame *GetXLightsFrame() const { return xframe; };
+
+    // Parse the settings of up to maxEffects of the effects loaded lazily ... returns true if more remain
+    bool MaterializeEffects(size_t maxEffects);
 protected:
 private:
     int LoadEffects(EffectLayer *layer,
         const std::string &type,
         wxXmlNode *effectLayerNode,
-        const std::vector<std::string> & effectStrings,
-        const std::vector<std::string> & colorPalettes);
+        const std::vector<std::shared_ptr<const std::string>> & effectStrings,
+        const std::vector<std::shared_ptr<const std::string>> & colorPalettes);
     static bool SortElementsByIndex(const Element *element1, const Element *element2)
     {
         return (element1->GetIndex() < element2->GetIndex());
@@ -259,5 +262,8 @@ private:
     std::map<std::string, std::set<std::string>> renderDependency;
     std::set<std::string> modelsToRender;
     std::mutex renderDepLock;
+
+    bool mEffectsToMaterialize = false;
+    size_t mMaterializeElement = 0;
 };
 
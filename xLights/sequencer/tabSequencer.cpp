@@ -2748,7 +2748,7 @@ void xLightsFrame::SetEffectControls(const SettingsMap &settings) {
     for (const auto& it : settings) {
 		if (it.first.find("APPLYLAST") == std::string::npos)
 		{
-			ApplySetting(it.first, ToWXString(it.second));
+			ApplySetting(it.first.str(), ToWXString(it.second));
 		}
         else
         {
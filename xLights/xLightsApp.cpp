@@ -36,6 +36,7 @@
 #include "TraceLog.h"
 #include "ExternalHooks.h"
 #include "BitmapCache.h"
+#include "outputs/OutputBenchmark.h"
 
 #ifndef __WXMSW__
 #include "automation/automation.h"
@@ -474,6 +475,7 @@ bool xLightsApp::OnInit()
         { wxCMD_LINE_OPTION, "g", "opengl", "specify OpenGL version" },
         { wxCMD_LINE_SWITCH, "w", "wipe", "wipe settings clean" },
         { wxCMD_LINE_SWITCH, "o", "on", "turn on output to lights" },
+        { wxCMD_LINE_OPTION, "ob", "outputbenchmark", "benchmark output against emulated local controllers and exit (universes=,fps=,seconds=,changed=,suppress=,parallel=,sync=)" },
         { wxCMD_LINE_SWITCH, "a", "aport", "turn on xFade A port" },
         { wxCMD_LINE_SWITCH, "b", "bport", "turn on xFade B port" },
 #ifdef __LINUX__
@@ -613,6 +615,14 @@ bool xLightsApp::OnInit()
         return false;
     }
 
+    wxString benchmark;
+    if (parser.Found("ob", &benchmark)) {
+        logger_base.info("-ob: Running output benchmark %s", (const char*)benchmark.c_str());
+        OutputBenchmark ob(benchmark.ToStdString());
+        printf("%s", ob.Run().c_str());
+        return false;
+    }
+
     //(*AppInitialize
     bool wxsOK = true;
     wxInitAllImageHandlers();
@@ -63,6 +63,9 @@
 #include "EffectsPanel.h"
 #include "MultiControllerUploadDialog.h"
 #include "Parallel.h"
+#include "AudioAnalysisCache.h"
+#include "controllers/FPP.h"
+#include "SequenceSidecar.h"
 #include "outputs/IPOutput.h"
 #include "outputs/E131Output.h"
 #include "GenerateLyricsDialog.h"
@@ -1270,6 +1273,7 @@ xLightsFrame::xLightsFrame(wxWindow* parent, int ab, wxWindowID id) :
 
     Connect(wxEVT_HELP, (wxObjectEventFunction)&xLightsFrame::OnHelp);
     Notebook1->Connect(wxEVT_HELP, (wxObjectEventFunction) & xLightsFrame::OnHelp, 0, this);
+    Bind(wxEVT_IDLE, &xLightsFrame::OnIdle, this);
 
     logger_base.debug("xLightsFrame constructor UI code done.");
 
@@ -1533,6 +1537,12 @@ xLightsFrame::xLightsFrame(wxWindow* parent, int ab, wxWindowID id) :
     config->Read("xLightsPromptBatchRenderIssues", &_promptBatchRenderIssues, true);
     logger_base.debug("Prompt for issues during batch render: %s.", toStr( _promptBatchRenderIssues ));
 
+    config->Read("xLightsStreamBatchRender", &_streamBatchRender, false);
+    logger_base.debug("Stream fseq during batch render: %s.", toStr( _streamBatchRender ));
+
+    config->Read("xLightsRenderSegments", &_renderSegments, true);
+    logger_base.debug("Split long model renders into segments: %s.", toStr( _renderSegments ));
+
     // I was willing to default this off ... but after multiple attempts to sneak this in ... this will default off in windows and if it is changed
     // again it will be totally and permanently disabled in windows.
 #ifdef __WXMSW__
@@ -1589,6 +1599,11 @@ xLightsFrame::xLightsFrame(wxWindow* parent, int ab, wxWindowID id) :
         mRenderOnSave = false;
     }
 
+    bool sequenceSidecar = true;
+    config->Read("xLightsSequenceSidecar", &sequenceSidecar, true);
+    SequenceSidecar::SetEnabled(sequenceSidecar);
+    logger_base.debug("Sequence binary sidecar: %s.", toStr(sequenceSidecar));
+
     config->Read("xLightsModelHandleSize", &_modelHandleSize, 1);
     logger_base.debug("Model Handle Size: %d.", _modelHandleSize);
 
@@ -2076,6 +2091,17 @@ void xLightsFrame::OnHelp(wxHelpEvent& event)
     // deliberately do nothing
 }
 
+// Effects are loaded without parsing their settings so sequences open quickly ... parse them in batches while idle
+// so the first render or edit of an effect does not have to
+#define EFFECTS_TO_MATERIALIZE_PER_IDLE 2000
+void xLightsFrame::OnIdle(wxIdleEvent& event)
+{
+    if (_sequenceElements.MaterializeEffects(EFFECTS_TO_MATERIALIZE_PER_IDLE)) {
+        event.RequestMore();
+    }
+    event.Skip();
+}
+
 void xLightsFrame::DoPostStartupCommands() {
     static log4cpp::Category &logger_base = log4cpp::Category::getInstance(std::string("log_base"));
     logger_base.debug("In Post Startup");
@@ -4322,6 +4348,8 @@ void xLightsFrame::SetRenderCacheFolder(bool useShow, const std::string& folder)
     }
 
     SetXmlSetting("renderCacheDir", renderCacheDirectory);
+    AudioAnalysisCache::SetCacheFolder(renderCacheDirectory + wxFileName::GetPathSeparator() + "AudioCache");
+    FPP::SetUploadManifestFolder(renderCacheDirectory + wxFileName::GetPathSeparator() + "FPPUploads");
     UnsavedRgbEffectsChanges = true;
     UpdateLayoutSave();
     UpdateControllerSave();
@@ -7775,7 +7803,7 @@ void xLightsFrame::TimerOutput(int period)
 {
     if (CheckBoxLightOutput->IsChecked())
     {
-        _outputManager.SetManyChannels(0, &_seqData[period][0], _seqData.NumChannels());
+        _outputManager.SetFrame(&_seqData[period][0], _seqData.NumChannels());
     }
 }
 
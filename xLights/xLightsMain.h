@@ -220,6 +220,8 @@ class BufferPanel;
 class LayoutPanel;
 class RenderProgressDialog;
 class RenderProgressInfo;
+class FSEQStreamWriter;
+class FSEQFile;
 class wxLed;
 
 class xlAuiToolBar : public wxAuiToolBar {
@@ -398,6 +400,7 @@ public:
     std::string GetPresetIconFilename(const std::string& preset) const;
     void CreatePresetIcons();
     void ClearSequenceData();
+    bool HasIseqLayersAboveEffects();
     void LoadAudioData(xLightsXmlFile& xml_file);
     virtual void CreateDebugReport(xlCrashHandler* crashHandler) override;
     virtual std::string GetCurrentDir() const override { return CurrentDir.ToStdString(); }
@@ -619,6 +622,7 @@ public:
     //*)
     void OnCharHook(wxKeyEvent& event);
     void OnHelp(wxHelpEvent& event);
+    void OnIdle(wxIdleEvent& event);
 
 private :
 
@@ -1046,6 +1050,8 @@ public:
     bool _excludePresetsFromPackagedSequences = true;
     bool _excludeAudioFromPackagedSequences = true;
     bool _promptBatchRenderIssues = true;
+    bool _streamBatchRender = false;
+    bool _renderSegments = true;
     bool _hwVideoAccleration = false;
     bool _showACLights = false;
     bool _showACRamps = false;
@@ -1179,6 +1185,9 @@ public:
     bool GetPromptBatchRenderIssues() const { return _promptBatchRenderIssues; }
     void SetPromptBatchRenderIssues(bool b) { _promptBatchRenderIssues = b; }
 
+    bool GetRenderSegments() const { return _renderSegments; }
+    JobPool& GetRenderJobPool() { return jobPool; }
+
     bool GetIgnoreVendorModelRecommendations() const { return _ignoreVendorModelRecommendations; }
     void SetIgnoreVendorModelRecommendations(bool b) { _ignoreVendorModelRecommendations = b; }
     void PurgeDownloadCache();
@@ -1362,12 +1371,14 @@ public:
     void ReadXlightsFile(const wxString& FileName, wxString *mediaFilename = nullptr);
     void ReadFalconFile(const wxString& FileName, ConvertDialog* convertdlg);
     void WriteFalconPiFile(const wxString& filename, bool allowSparse = true); //  Falcon Pi Player *.fseq
+    FSEQFile* CreateFalconPiFile(const wxString& filename, bool allowSparse = true);
     OutputManager* GetOutputManager() { return &_outputManager; };
     OutputModelManager* GetOutputModelManager() { return&_outputModelManager; }
     void WriteGIFForPreset(const std::string& preset);
 
 private:
 
+    void GetFalconPiFileRanges(std::vector<std::pair<uint32_t, uint32_t>>& ranges);
     void WriteFalconPiModelFile(const wxString& filename, long numChans, unsigned int startFrame, unsigned int endFrame,
                                 SeqDataType *dataBuf, int startAddr, int modelSize,
                                 bool v2 = false); //Falcon Pi sub sequence .eseq
@@ -1395,7 +1406,7 @@ public:
     int GetCurrentPlayTime();
     bool InitPixelBuffer(const std::string &modelName, PixelBufferClass &buffer, int layerCount, bool zeroBased = false);
     Model *GetModel(const std::string& name) const;
-    void RenderGridToSeqData(std::function<void()>&& callback);
+    void RenderGridToSeqData(std::function<void()>&& callback, FSEQStreamWriter* streamWriter = nullptr);
     bool AbortRender(int maxTimeMs = 60000);
     std::string GetSelectedLayoutPanelPreview() const;
     void UpdateRenderStatus();
@@ -1414,7 +1425,8 @@ public:
                 const std::list<Model *> &restrictToModels,
                 int startFrame, int endFrame,
                 bool progressDialog, bool clear,
-                std::function<void()>&& callback);
+                std::function<void()>&& callback,
+                FSEQStreamWriter* streamWriter = nullptr);
     void BuildRenderTree();
 
     void RenderRange(RenderCommandEvent &cmd);
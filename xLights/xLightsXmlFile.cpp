@@ -14,6 +14,7 @@
 #include <wx/zipstrm.h>
 #include <wx/wfstream.h>
 #include <wx/dir.h>
+#include <wx/file.h>
 #include <wx/textfile.h>
 #include <wx/mstream.h>
 #include <wx/base64.h>
@@ -32,6 +33,7 @@
 #include "sequencer/TimeLine.h"
 #include "Vixen3.h"
 #include "ExternalHooks.h"
+#include "SequenceSidecar.h"
 
 #include <log4cpp/Category.hh>
 
@@ -1039,7 +1041,10 @@ bool xLightsXmlFile::LoadSequence(const wxString& ShowDir, bool ignore_audio)
     static log4cpp::Category& logger_base = log4cpp::Category::getInstance(std::string("log_base"));
     logger_base.info("LoadSequence: Loading sequence " + GetFullPath());
 
-    if (!seqDocument.Load(GetFullPath())) {
+    if (SequenceSidecar::Load(GetFullPath().ToStdString(), seqDocument)) {
+        logger_base.info("LoadSequence: Loaded from binary sidecar.");
+    }
+    else if (!seqDocument.Load(GetFullPath())) {
         logger_base.error("LoadSequence: XML file load failed.");
         return false;
     }
@@ -2550,7 +2555,34 @@ wxArrayString xLightsXmlFile::GetTimingList(const SequenceElements& seq_elements
 bool xLightsXmlFile::Save()
 {
     UpdateVersion();
-    return seqDocument.Save(GetFullPath());
+    return SaveDocument();
+}
+
+// Writes the xml and, for sequences, hands the saved content to a background thread to write the binary sidecar
+bool xLightsXmlFile::SaveDocument()
+{
+    static log4cpp::Category& logger_base = log4cpp::Category::getInstance(std::string("log_base"));
+
+    if (!SequenceSidecar::IsEnabled() || GetExt().Lower() != "xsq") {
+        return seqDocument.Save(GetFullPath());
+    }
+
+    wxMemoryOutputStream out;
+    if (!seqDocument.Save(out)) {
+        return false;
+    }
+    const wxStreamBuffer* buffer = out.GetOutputStreamBuffer();
+    std::string content((const char*)buffer->GetBufferStart(), buffer->Tell());
+
+    wxFile file;
+    if (!file.Create(GetFullPath(), true) || file.Write(content.data(), content.size()) != content.size()) {
+        logger_base.error("Unable to save sequence %s.", (const char*)GetFullPath().c_str());
+        return false;
+    }
+    file.Close();
+
+    SequenceSidecar::SaveInBackground(GetFullPath().ToStdString(), std::move(content));
+    return true;
 }
 
 void xLightsXmlFile::WriteEffects(EffectLayer *layer,
@@ -2841,7 +2873,7 @@ void xLightsXmlFile::Save(SequenceElements& seq_elements)
     }
 #endif
 
-    seqDocument.Save(GetFullPath());
+    SaveDocument();
 }
 
 bool xLightsXmlFile::TimingAlreadyExists(const std::string & section, xLightsFrame* xLightsParent)
@@ -227,6 +227,7 @@ private:
     bool LoadSequence(const wxString& ShowDir, bool ignore_audio = false);
     bool LoadV3Sequence();
     bool Save();
+    bool SaveDocument();
     bool SaveCopy() const;
     void AddTimingDisplayElement(const wxString& name, const wxString& visible, const wxString& active);
     void AddDisplayElement(const wxString& name, const wxString& type, const wxString& visible, const wxString& collapsed, const wxString& active, const wxString& renderDisabled);
@@ -12,6 +12,7 @@
 #include <wx/string.h>
 #include <wx/xml/xml.h>
 #include <wx/wx.h>
+#include <wx/image.h>
 #include "../xLights/outputs/OutputManager.h"
 #include <log4cpp/Category.hh>
 
@@ -311,6 +312,74 @@ size_t MatrixMapper::Map(int x, int y) const
     return loc;
 }
 
+std::shared_ptr<const std::vector<size_t>> MatrixMapper::GetImageOffsets() const
+{
+    long startChannel = GetStartChannelAsNumber();
+
+    // an unresolved start channel decodes as 0 which would put every offset before the start of the buffer
+    if (startChannel < 1) return nullptr;
+
+    std::unique_lock<std::mutex> lock(_offsetsLock);
+    if (_offsets == nullptr || _offsetsChangeCount != _changeCount || _offsetsStartChannel != startChannel)
+    {
+        int width = GetWidth();
+        int height = GetHeight();
+        auto offsets = std::make_shared<std::vector<size_t>>((size_t)width * height);
+        size_t* o = offsets->data();
+        for (int y = 0; y < height; ++y)
+        {
+            for (int x = 0; x < width; ++x)
+            {
+                *o++ = Map(x, height - y - 1) - 1;
+            }
+        }
+        _offsets = offsets;
+        _offsetsChangeCount = _changeCount;
+        _offsetsStartChannel = startChannel;
+    }
+    return _offsets;
+}
+
+void MatrixMapper::BlitImage(const wxImage& image, uint8_t* buffer, size_t size, APPLYMETHOD blendMode) const
+{
+    auto offsets = GetImageOffsets();
+    if (offsets == nullptr) return;
+
+    int width = GetWidth();
+    int height = std::min(GetHeight(), image.GetHeight());
+    int copyWidth = std::min(width, image.GetWidth());
+    int imageWidth = image.GetWidth();
+    uint8_t* data = image.GetData();
+    if (data == nullptr) return;
+
+    for (int y = 0; y < height; ++y)
+    {
+        const size_t* o = offsets->data() + (size_t)y * width;
+        uint8_t* src = data + (size_t)y * imageWidth * 3;
+        for (int x = 0; x < copyWidth; ++x, src += 3)
+        {
+            size_t bl = o[x];
+            if (bl < size && size - bl >= 3)
+            {
+                if (blendMode == APPLYMETHOD::METHOD_OVERWRITE)
+                {
+                    buffer[bl] = src[0];
+                    buffer[bl + 1] = src[1];
+                    buffer[bl + 2] = src[2];
+                }
+                else
+                {
+                    Blend(buffer + bl, 3, src, 3, blendMode);
+                }
+            }
+            else
+            {
+                wxASSERT(false);
+            }
+        }
+    }
+}
+
 size_t MatrixMapper::GetChannels() const
 {
     return _stringLength * _strings * 3;
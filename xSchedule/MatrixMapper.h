@@ -10,9 +10,15 @@
  * License: https://github.com/smeighan/xLights/blob/master/License.txt
  **************************************************************/
 
+#include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
+
+#include "Blend.h"
 
 class wxXmlNode;
+class wxImage;
 class OutputManager;
 
 typedef enum {HORIZONTAL, VERTICAL} MMORIENTATION;
@@ -31,6 +37,13 @@ class MatrixMapper
 	MMSTARTLOCATION _startLocation;
     std::string _startChannel;
 
+    // buffer offset of each pixel in wxImage order (top row first) built on first use and rebuilt when the
+    // matrix changes
+    mutable std::mutex _offsetsLock;
+    mutable std::shared_ptr<const std::vector<size_t>> _offsets;
+    mutable int _offsetsChangeCount = -1;
+    mutable long _offsetsStartChannel = -1;
+
 public:
 
 		static MMORIENTATION EncodeOrientation(const std::string orientation);
@@ -44,6 +57,9 @@ public:
         MatrixMapper(OutputManager* outputManager);
         virtual ~MatrixMapper() {}
 		size_t Map(int x, int y) const;
+        // nullptr if the start channel cannot be resolved
+        std::shared_ptr<const std::vector<size_t>> GetImageOffsets() const;
+        void BlitImage(const wxImage& image, uint8_t* buffer, size_t size, APPLYMETHOD blendMode) const;
 		size_t GetChannels() const;
 		int GetWidth() const;
 		int GetHeight() const;
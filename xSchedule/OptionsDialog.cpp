@@ -82,6 +82,10 @@ const long OptionsDialog::ID_STATICTEXT1 = wxNewId();
 const long OptionsDialog::ID_CHOICE3 = wxNewId();
 const long OptionsDialog::ID_STATICTEXT10 = wxNewId();
 const long OptionsDialog::ID_CHOICE5 = wxNewId();
+const long OptionsDialog::ID_STATICTEXT15 = wxNewId();
+const long OptionsDialog::ID_SPINCTRL3 = wxNewId();
+const long OptionsDialog::ID_STATICTEXT16 = wxNewId();
+const long OptionsDialog::ID_SPINCTRL4 = wxNewId();
 const long OptionsDialog::ID_BUTTONDEFAULTWINODOWLOC = wxNewId();
 const long OptionsDialog::ID_BUTTON1 = wxNewId();
 const long OptionsDialog::ID_BUTTON2 = wxNewId();
@@ -256,6 +260,17 @@ OptionsDialog::OptionsDialog(wxWindow* parent, CommandManager* commandManager, S
     Choice1 = new wxChoice(this, ID_CHOICE5, wxDefaultPosition, wxDefaultSize, 0, 0, 0, wxDefaultValidator, _T("ID_CHOICE5"));
     Choice1->SetToolTip(_("When set this will override any forced IP on all controllers. If you want to set individual controllers to specific network cards then you must do this in xLights."));
     FlexGridSizer3->Add(Choice1, 1, wxALL|wxEXPAND, 5);
+    StaticText15 = new wxStaticText(this, ID_STATICTEXT15, _("Steps To Prefetch:"), wxDefaultPosition, wxDefaultSize, 0, _T("ID_STATICTEXT15"));
+    FlexGridSizer3->Add(StaticText15, 1, wxALL|wxALIGN_LEFT|wxALIGN_CENTER_VERTICAL, 5);
+    SpinCtrl_PrefetchSteps = new wxSpinCtrl(this, ID_SPINCTRL3, _T("1"), wxDefaultPosition, wxDefaultSize, 0, 0, 10, 1, _T("ID_SPINCTRL3"));
+    SpinCtrl_PrefetchSteps->SetValue(_T("1"));
+    SpinCtrl_PrefetchSteps->SetToolTip(_("Number of upcoming playlist steps to open and load in the background so they start without a gap. 0 turns this off."));
+    FlexGridSizer3->Add(SpinCtrl_PrefetchSteps, 1, wxALL|wxEXPAND, 5);
+    StaticText16 = new wxStaticText(this, ID_STATICTEXT16, _("Prefetch Memory Limit (MB):"), wxDefaultPosition, wxDefaultSize, 0, _T("ID_STATICTEXT16"));
+    FlexGridSizer3->Add(StaticText16, 1, wxALL|wxALIGN_LEFT|wxALIGN_CENTER_VERTICAL, 5);
+    SpinCtrl_PrefetchMemory = new wxSpinCtrl(this, ID_SPINCTRL4, _T("512"), wxDefaultPosition, wxDefaultSize, 0, 0, 16384, 512, _T("ID_SPINCTRL4"));
+    SpinCtrl_PrefetchMemory->SetValue(_T("512"));
+    FlexGridSizer3->Add(SpinCtrl_PrefetchMemory, 1, wxALL|wxEXPAND, 5);
     FlexGridSizer3->Add(-1,-1,1, wxALL|wxALIGN_CENTER_HORIZONTAL|wxALIGN_CENTER_VERTICAL, 5);
     Button_DefaultWindowLocation = new wxButton(this, ID_BUTTONDEFAULTWINODOWLOC, _("Set Default Video/Virtual Matrix Location"), wxDefaultPosition, wxDefaultSize, 0, wxDefaultValidator, _T("ID_BUTTONDEFAULTWINODOWLOC"));
     FlexGridSizer3->Add(Button_DefaultWindowLocation, 1, wxALL|wxALIGN_CENTER_HORIZONTAL|wxALIGN_CENTER_VERTICAL, 5);
@@ -332,6 +347,8 @@ OptionsDialog::OptionsDialog(wxWindow* parent, CommandManager* commandManager, S
 
     SpinCtrl_WebServerPort->SetValue(options->GetWebServerPort());
     SpinCtrl_PasswordTimeout->SetValue(options->GetPasswordTimeout());
+    SpinCtrl_PrefetchSteps->SetValue(options->GetPrefetchSteps());
+    SpinCtrl_PrefetchMemory->SetValue(options->GetPrefetchMemoryMB());
 
     TextCtrl_wwwRoot->SetValue(options->GetWWWRoot());
     StaticText4->SetToolTip("Root Directory: " + options->GetDefaultRoot());
@@ -430,6 +447,8 @@ void OptionsDialog::OnButton_OkClick(wxCommandEvent& event)
     _options->SetDefaultPage(TextCtrl_DefaultPage->GetValue().ToStdString());
     _options->SetAllowUnauth(CheckBox_AlllowPageBypass->GetValue());
     _options->SetPasswordTimeout(SpinCtrl_PasswordTimeout->GetValue());
+    _options->SetPrefetchSteps(SpinCtrl_PrefetchSteps->GetValue());
+    _options->SetPrefetchMemoryMB(SpinCtrl_PrefetchMemory->GetValue());
     _options->SetAdvancedMode(CheckBox_SimpleMode->GetValue());
     _options->SetArtNetTimeCodeFormat(static_cast<TIMECODEFORMAT>(Choice_ARTNetTimeCodeFormat->GetSelection()));
     _options->SetCity(Choice_Location->GetStringSelection().ToStdString());
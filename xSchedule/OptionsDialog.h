@@ -79,12 +79,16 @@ class OptionsDialog: public wxDialog
 		wxChoice* Choice_SMPTEFrameRate;
 		wxListView* ListView_Buttons;
 		wxSpinCtrl* SpinCtrl_PasswordTimeout;
+		wxSpinCtrl* SpinCtrl_PrefetchMemory;
+		wxSpinCtrl* SpinCtrl_PrefetchSteps;
 		wxSpinCtrl* SpinCtrl_WebServerPort;
 		wxStaticText* StaticText10;
 		wxStaticText* StaticText11;
 		wxStaticText* StaticText12;
 		wxStaticText* StaticText13;
 		wxStaticText* StaticText14;
+		wxStaticText* StaticText15;
+		wxStaticText* StaticText16;
 		wxStaticText* StaticText1;
 		wxStaticText* StaticText2;
 		wxStaticText* StaticText3;
@@ -152,6 +156,10 @@ class OptionsDialog: public wxDialog
 		static const long ID_CHOICE3;
 		static const long ID_STATICTEXT10;
 		static const long ID_CHOICE5;
+		static const long ID_STATICTEXT15;
+		static const long ID_SPINCTRL3;
+		static const long ID_STATICTEXT16;
+		static const long ID_SPINCTRL4;
 		static const long ID_BUTTONDEFAULTWINODOWLOC;
 		static const long ID_BUTTON1;
 		static const long ID_BUTTON2;
@@ -24,6 +24,8 @@
 
 #include <wx/xml/xml.h>
 
+#include <algorithm>
+
 #include <log4cpp/Category.hh>
 
 int __playlistid = 0;
@@ -619,6 +621,11 @@ bool PlayList::Frame(uint8_t* buffer, size_t size, bool outputframe)
             return false;
         }
 
+        if (_prefetchedAfter != (long)_currentStep->GetId())
+        {
+            PrefetchNextSteps();
+        }
+
         // This returns true if everything is done
         if (_currentStep->Frame(buffer, size, outputframe))
         {
@@ -747,6 +754,141 @@ void PlayList::Stop()
         StopEveryStep();
         _currentStep = nullptr;
     }
+
+    CancelPrefetch();
+}
+
+// A guess at the steps GetNextStep will return without changing any state so they can be prepared
+// before they are needed. Random order cannot be predicted so nothing is returned for it.
+std::list<PlayListStep*> PlayList::PeekNextSteps(size_t count) const
+{
+    std::list<PlayListStep*> res;
+
+    if (_currentStep == nullptr || count == 0) return res;
+    if (_stopAtEndOfCurrentStep || _jumpToEndStepsAtEndOfCurrentStep || _loopStep) return res;
+    if (_currentStep->GetLoopsLeft() > 1) return res;
+    if (_lastOnlyOnce && _steps.back() == _currentStep) return res;
+
+    PlayListStep* step = _currentStep;
+    if (_forceNextStep != "")
+    {
+        step = nullptr;
+        for (const auto& it : _steps)
+        {
+            if (wxString(it->GetNameNoTime()).Lower() == wxString(_forceNextStep).Lower())
+            {
+                step = it;
+                break;
+            }
+        }
+        if (step == nullptr || step == _currentStep) return res;
+        res.push_back(step);
+    }
+    else if (IsRandom() && !_lastLoop)
+    {
+        return res;
+    }
+
+    while (res.size() < count)
+    {
+        auto it = std::find(_steps.begin(), _steps.end(), step);
+        if (it == _steps.end()) break;
+        ++it;
+
+        PlayListStep* next = nullptr;
+        if (IsLooping() && !_lastLoop && (it == _steps.end() || (_lastOnlyOnce && *it == _steps.back())))
+        {
+            auto first = _steps.begin();
+            if (_firstOnlyOnce) ++first;
+            if (first != _steps.end()) next = *first;
+        }
+        else if (it != _steps.end())
+        {
+            next = *it;
+        }
+
+        if (next == nullptr || next == _currentStep || std::find(res.begin(), res.end(), next) != res.end()) break;
+        res.push_back(next);
+        step = next;
+    }
+
+    return res;
+}
+
+void PlayList::PrefetchNextSteps()
+{
+    static log4cpp::Category &logger_base = log4cpp::Category::getInstance(std::string("log_base"));
+
+    if (_currentStep == nullptr) return;
+    _prefetchedAfter = _currentStep->GetId();
+
+    size_t lookahead = 0;
+    size_t maxBytes = 0;
+    ScheduleManager* sm = xScheduleFrame::GetScheduleManager();
+    if (sm != nullptr)
+    {
+        lookahead = sm->GetOptions()->GetPrefetchSteps();
+        maxBytes = (size_t)sm->GetOptions()->GetPrefetchMemoryMB() * 1024 * 1024;
+    }
+
+    std::list<PlayListStep*> upcoming;
+    if (!IsInSlaveMode())
+    {
+        ReentrancyCounter rec(_reentrancyCounter);
+        upcoming = PeekNextSteps(lookahead);
+    }
+
+    // anything prepared that is no longer coming up is thrown away ... the current step has already taken what was prepared for it
+    std::list<wxUint32> keep;
+    for (const auto& it : _prefetched)
+    {
+        if (it == _currentStep->GetId()) continue;
+
+        PlayListStep* step = GetStep(it);
+        if (step == nullptr) continue;
+
+        if (std::find(upcoming.begin(), upcoming.end(), step) == upcoming.end())
+        {
+            step->CancelPrefetch();
+        }
+        else
+        {
+            keep.push_back(it);
+        }
+    }
+    _prefetched = keep;
+
+    size_t bytes = 0;
+    for (const auto& it : upcoming)
+    {
+        size_t stepBytes = it->GetPrefetchBytes();
+        if (bytes + stepBytes > maxBytes)
+        {
+            logger_base.debug("PlayList: Not prefetching step '%s' as it would take prefetched memory to %luMB.", (const char*)it->GetNameNoTime().c_str(), (unsigned long)((bytes + stepBytes) / (1024 * 1024)));
+            break;
+        }
+        bytes += stepBytes;
+
+        if (std::find(_prefetched.begin(), _prefetched.end(), it->GetId()) == _prefetched.end())
+        {
+            it->Prefetch();
+            _prefetched.push_back(it->GetId());
+        }
+    }
+}
+
+void PlayList::CancelPrefetch()
+{
+    for (const auto& it : _prefetched)
+    {
+        PlayListStep* step = GetStep(it);
+        if (step != nullptr)
+        {
+            step->CancelPrefetch();
+        }
+    }
+    _prefetched.clear();
+    _prefetchedAfter = -1;
 }
 
 PlayListStep* PlayList::GetNextStep(bool& didloop)
@@ -55,6 +55,8 @@ protected:
     bool _jumpToEndStepsAtEndOfCurrentStep;
     std::string _forceNextStep;
     std::list<wxUint32> _played;
+    std::list<wxUint32> _prefetched; // ids of steps being prepared to play after the current step
+    long _prefetchedAfter = -1; // id of the step the prefetch was worked out from
     #pragma endregion Member Variables
 
     int GetPos(PlayListStep* step);
@@ -65,6 +67,9 @@ protected:
     static bool IsInTimecodeSlaveMode();
     static bool IsTimecodeNoAdvance();
     bool JumpToStep(PlayListStep* pls);
+    std::list<PlayListStep*> PeekNextSteps(size_t count) const;
+    void PrefetchNextSteps();
+    void CancelPrefetch();
 
 public:
 
@@ -11,6 +11,7 @@
 #include "PlayListItem.h"
 #include <wx/xml/xml.h>
 #include <wx/regex.h>
+#include <wx/filename.h>
 #include "../xScheduleMain.h"
 #include "../ScheduleManager.h"
 #include "../ScheduleOptions.h"
@@ -251,3 +252,29 @@ std::string PlayListItem::GetTagHint()
     return "Available variables:\n    %RUNNING_PLAYLIST% - current playlist\n    %RUNNING_PLAYLISTSTEP% - step name\n    %RUNNING_PLAYLISTSTEPMS% - Position in current step\n    %RUNNING_PLAYLISTSTEPMSLEFT% - Time left in current step\n    %RUNNING_SCHEDULE% - Name of schedule\n    %STEPNAME% - Current step\n    %NEXTSTEPNAME% - Next step\n    %NEXTSTEPNAME% - Next step\n    %ALBUM% - from mp3\n    %TITLE% - from mp3\n    %ARTIST% - from mp3\n    %TIMESTAMP% - timestamp\n    %TIME% - time now\n    %MACHINENAME% - computer name\n    %DATE% - date now";
 }
 
+
+size_t PlayListItem::EstimatePrepareAudioBytes(const std::string& audioFile, size_t durationMS)
+{
+    if (durationMS == 0)
+    {
+        // the length is not known until the file is opened so guess it from the size ... compressed
+        // formats are assumed to be 128kbps, uncompressed 16 bit stereo at 44.1kHz
+        wxFileName fn(audioFile);
+        if (audioFile == "" || !fn.FileExists()) return 0;
+        wxULongLong size = fn.GetSize();
+        if (size == wxInvalidSize) return 0;
+
+        wxString ext = fn.GetExt().Lower();
+        size_t bytesPerMS = 16;
+        if (ext == "wav" || ext == "aif" || ext == "aiff")
+        {
+            bytesPerMS = 176;
+        }
+        else if (ext == "flac")
+        {
+            bytesPerMS = 100;
+        }
+        durationMS = (size_t)(size.GetValue() / bytesPerMS);
+    }
+    return durationMS * PREFETCH_AUDIO_BYTES_PER_MS;
+}
@@ -12,6 +12,8 @@
 
 #include <string>
 #include <list>
+#include <mutex>
+#include <functional>
 #include <wx/wx.h>
 #include <wx/notebook.h>
 
@@ -19,6 +21,10 @@ class wxXmlNode;
 class AudioManager;
 class ScheduleOptions;
 
+// Rough memory held by an audio file decoded ahead of time ... left and right float samples plus the
+// 16 bit pcm data at 48kHz
+#define PREFETCH_AUDIO_BYTES_PER_MS 576
+
 class PlayListItem
 {
 protected:
@@ -37,6 +43,7 @@ protected:
     int _currentFrame;
     long _stepLengthMS;
     bool _restOfStep; // while not used in every item it could be common
+    std::mutex _prepareLock; // guards anything Prepare has opened until Start takes it
     #pragma endregion Member Variables
 
     void Save(wxXmlNode* node);
@@ -108,6 +115,18 @@ protected:
     virtual bool Advance(int seconds) { return false; }
     #pragma endregion Playing
 
+    #pragma region Prefetch
+    // Prepare is called on the schedule thread before the step starts and returns work to run on a background
+    // thread so slow file opening and decoding is done by the time Start needs it. The work must only use copies
+    // of the settings it needs, taken when Prepare is called, and hand what it opens over under _prepareLock.
+    // Unprepare throws it away if the step does not play next after all.
+    virtual std::function<void()> Prepare() { return nullptr; }
+    virtual void Unprepare() {}
+    virtual size_t GetPrepareBytes() const { return 0; }
+    // Rough memory needed to decode an audio file ahead of time, from its length if known or else its size
+    static size_t EstimatePrepareAudioBytes(const std::string& audioFile, size_t durationMS);
+    #pragma endregion Prefetch
+
     #pragma region UI
     // returns nullptr if cancelled
     virtual void Configure(wxNotebook* notebook) = 0;
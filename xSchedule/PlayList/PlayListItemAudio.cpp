@@ -77,11 +77,23 @@ void PlayListItemAudio::LoadFiles()
 {
     static log4cpp::Category &logger_base = log4cpp::Category::getInstance(std::string("log_base"));
 
+    AudioManager* preparedAudio = nullptr;
+    {
+        std::unique_lock<std::mutex> lock(_prepareLock);
+        std::swap(preparedAudio, _preparedAudio);
+    }
+    if (preparedAudio != nullptr && preparedAudio->FileName() != _audioFile)
+    {
+        delete preparedAudio;
+        preparedAudio = nullptr;
+    }
+
     if (_audioManager != nullptr)
     {
         if (_audioManager->FileName() == _audioFile)
         {
             // already open
+            if (preparedAudio != nullptr) delete preparedAudio;
             return;
         }
         else
@@ -95,6 +107,13 @@ void PlayListItemAudio::LoadFiles()
     if (IsInSlaveMode() && IsSuppressAudioOnSlaves())
     {
         
+    }
+    else if (preparedAudio != nullptr)
+    {
+        _audioManager = preparedAudio;
+        preparedAudio = nullptr;
+        _durationMS = _audioManager->LengthMS();
+        _controlsTimingCache = true;
     }
     else if (wxFile::Exists(_audioFile))
     {
@@ -127,6 +146,57 @@ void PlayListItemAudio::LoadFiles()
             logger_base.error("Audio: Audio file '%s' cannot be opened because it does not exist.", (const char *)_audioFile.c_str());
         }
     }
+
+    if (preparedAudio != nullptr) delete preparedAudio;
+}
+
+std::function<void()> PlayListItemAudio::Prepare()
+{
+    // fast start audio is already loaded
+    if (_fastStartAudio || (IsInSlaveMode() && IsSuppressAudioOnSlaves())) return nullptr;
+
+    // the work runs on the prefetch thread so it gets its own copies of the settings
+    std::string audioFile = _audioFile;
+    std::string audioDevice = _audioDevice;
+
+    return [this, audioFile, audioDevice]()
+    {
+        static log4cpp::Category &logger_base = log4cpp::Category::getInstance(std::string("log_base"));
+
+        if (!wxFile::Exists(audioFile)) return;
+
+        AudioManager* audio = new AudioManager(audioFile, -1, audioDevice);
+        if (!audio->IsOk())
+        {
+            delete audio;
+            return;
+        }
+
+        {
+            std::unique_lock<std::mutex> lock(_prepareLock);
+            if (_preparedAudio != nullptr) delete _preparedAudio;
+            _preparedAudio = audio;
+        }
+
+        logger_base.debug("Audio: Prepared '%s'.", (const char *)audioFile.c_str());
+    };
+}
+
+void PlayListItemAudio::Unprepare()
+{
+    std::unique_lock<std::mutex> lock(_prepareLock);
+    if (_preparedAudio != nullptr)
+    {
+        delete _preparedAudio;
+        _preparedAudio = nullptr;
+    }
+}
+
+size_t PlayListItemAudio::GetPrepareBytes() const
+{
+    if (_fastStartAudio) return 0;
+
+    return EstimatePrepareAudioBytes(_audioFile, _durationMS);
 }
 
 PlayListItemAudio::PlayListItemAudio() : PlayListItem()
@@ -142,6 +212,7 @@ PlayListItemAudio::PlayListItemAudio() : PlayListItem()
 
 PlayListItemAudio::~PlayListItemAudio()
 {
+    Unprepare();
     CloseFiles();
 
     if (_audioManager != nullptr)
@@ -33,6 +33,7 @@ protected:
     bool _controlsTimingCache = false;
     bool _fastStartAudio = false;
     std::string _audioDevice = "";
+    AudioManager* _preparedAudio = nullptr;
     #pragma endregion Member Variables
 
     void LoadFiles();
@@ -90,6 +91,12 @@ public:
     virtual bool Advance(int seconds) override;
     #pragma endregion Playing
 
+    #pragma region Prefetch
+    virtual std::function<void()> Prepare() override;
+    virtual void Unprepare() override;
+    virtual size_t GetPrepareBytes() const override;
+    #pragma endregion Prefetch
+
 #pragma region UI
     virtual void Configure(wxNotebook* notebook) override;
 #pragma endregion UI
@@ -164,11 +164,33 @@ void PlayListItemFSEQ::LoadAudio()
     }
 }
 
-void PlayListItemFSEQ::LoadFiles()
+// returns true if the fseq had already been opened by Prepare
+bool PlayListItemFSEQ::LoadFiles()
 {
     CloseFiles();
 
-    if (wxFile::Exists(_fseqFileName))
+    FSEQFile* preparedFSEQ = nullptr;
+    AudioManager* preparedAudio = nullptr;
+    {
+        std::unique_lock<std::mutex> lock(_prepareLock);
+        std::swap(preparedFSEQ, _preparedFSEQ);
+        std::swap(preparedAudio, _preparedAudio);
+    }
+
+    // the step may have been edited since it was prepared
+    if (preparedFSEQ != nullptr && preparedFSEQ->getFilename() != _fseqFileName)
+    {
+        delete preparedFSEQ;
+        preparedFSEQ = nullptr;
+    }
+
+    if (preparedFSEQ != nullptr)
+    {
+        _fseqFile = preparedFSEQ;
+        _msPerFrame = _fseqFile->getStepTime();
+        _durationMS = _fseqFile->getTotalTimeMS();
+    }
+    else if (wxFile::Exists(_fseqFileName))
     {
         _fseqFile = FSEQFile::openFSEQFile(_fseqFileName);
         if (_fseqFile != nullptr)
@@ -183,7 +205,102 @@ void PlayListItemFSEQ::LoadFiles()
         }
     }
 
+    if (preparedAudio != nullptr)
+    {
+        // LoadAudio will treat this as already open
+        if (_audioManager == nullptr && preparedAudio->FileName() == GetAudioFilename())
+        {
+            _audioManager = preparedAudio;
+        }
+        else
+        {
+            delete preparedAudio;
+        }
+    }
+
     LoadAudio();
+
+    return preparedFSEQ != nullptr;
+}
+
+std::function<void()> PlayListItemFSEQ::Prepare()
+{
+    // the work runs on the prefetch thread so it gets its own copies of the settings
+    std::string fseqFileName = _fseqFileName;
+    std::string audioFile = _overrideAudio ? _audioFile : "";
+    std::string audioDevice = _audioDevice;
+    // fast start audio is already loaded
+    bool prepareAudio = !_fastStartAudio && !(IsInSlaveMode() && IsSuppressAudioOnSlaves());
+    bool overrideAudio = _overrideAudio;
+
+    return [this, fseqFileName, audioFile, audioDevice, prepareAudio, overrideAudio]()
+    {
+        static log4cpp::Category &logger_base = log4cpp::Category::getInstance(std::string("log_base"));
+
+        FSEQFile* fseq = nullptr;
+        if (wxFile::Exists(fseqFileName))
+        {
+            fseq = FSEQFile::openFSEQFile(fseqFileName);
+            if (fseq != nullptr)
+            {
+                // this reads and decompresses the first block of frames
+                fseq->prepareRead({ { 0, fseq->getMaxChannel() + 1 } });
+            }
+        }
+
+        AudioManager* audio = nullptr;
+        if (prepareAudio)
+        {
+            std::string af = audioFile;
+            if (!overrideAudio && fseq != nullptr)
+            {
+                af = FixFile("", fseq->getMediaFilename());
+            }
+
+            if (af != "" && wxFile::Exists(af))
+            {
+                audio = new AudioManager(af, -1, audioDevice);
+                if (!audio->IsOk())
+                {
+                    delete audio;
+                    audio = nullptr;
+                }
+            }
+        }
+
+        {
+            std::unique_lock<std::mutex> lock(_prepareLock);
+            if (_preparedFSEQ != nullptr) delete _preparedFSEQ;
+            if (_preparedAudio != nullptr) delete _preparedAudio;
+            _preparedFSEQ = fseq;
+            _preparedAudio = audio;
+        }
+
+        logger_base.debug("FSEQ: Prepared '%s'%s.", (const char*)fseqFileName.c_str(), audio != nullptr ? " and its audio" : "");
+    };
+}
+
+void PlayListItemFSEQ::Unprepare()
+{
+    std::unique_lock<std::mutex> lock(_prepareLock);
+    if (_preparedFSEQ != nullptr)
+    {
+        delete _preparedFSEQ;
+        _preparedFSEQ = nullptr;
+    }
+    if (_preparedAudio != nullptr)
+    {
+        delete _preparedAudio;
+        _preparedAudio = nullptr;
+    }
+}
+
+size_t PlayListItemFSEQ::GetPrepareBytes() const
+{
+    if (_fastStartAudio) return 0;
+
+    // until the step has been timed the duration is not known so the estimate comes from the audio file size
+    return EstimatePrepareAudioBytes(_overrideAudio ? _audioFile : _cachedAudioFilename, _controlsTimingCache ? _durationMS : 0);
 }
 
 long PlayListItemFSEQ::GetFSEQChannels() const
@@ -566,9 +683,9 @@ void PlayListItemFSEQ::Start(long stepLengthMS)
 
     // load the FSEQ
     // load the audio
-    LoadFiles();
+    bool prepared = LoadFiles();
 
-    if (_fseqFile != nullptr) {
+    if (_fseqFile != nullptr && !prepared) {
         _fseqFile->prepareRead({ { 0, _fseqFile->getMaxChannel() + 1 } });
     }
 
@@ -643,6 +760,7 @@ void PlayListItemFSEQ::CloseFiles()
 
 PlayListItemFSEQ::~PlayListItemFSEQ()
 {
+    Unprepare();
     CloseFiles();
 
     if (_audioManager != nullptr)
@@ -42,9 +42,11 @@ protected:
     bool _fastStartAudio;
     std::string _cachedAudioFilename;
     std::string _audioDevice = "";
+    FSEQFile* _preparedFSEQ = nullptr;
+    AudioManager* _preparedAudio = nullptr;
     #pragma endregion Member Variables
 
-    void LoadFiles();
+    bool LoadFiles();
     void CloseFiles();
     void FastSetDuration();
     void LoadAudio();
@@ -114,6 +116,12 @@ public:
     virtual bool Advance(int seconds) override;
     #pragma endregion Playing
 
+    #pragma region Prefetch
+    virtual std::function<void()> Prepare() override;
+    virtual void Unprepare() override;
+    virtual size_t GetPrepareBytes() const override;
+    #pragma endregion Prefetch
+
 #pragma region UI
     virtual void Configure(wxNotebook* notebook) override;
 #pragma endregion UI
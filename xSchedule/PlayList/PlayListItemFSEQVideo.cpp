@@ -187,12 +187,38 @@ void PlayListItemFSEQVideo::LoadAudio()
     }
 }
 
-void PlayListItemFSEQVideo::LoadFiles(bool doCache)
+// returns true if the fseq had already been opened by Prepare
+bool PlayListItemFSEQVideo::LoadFiles(bool doCache)
 {
     static log4cpp::Category& logger_base = log4cpp::Category::getInstance(std::string("log_base"));
     CloseFiles();
 
-    if (wxFile::Exists(_fseqFileName)) {
+    FSEQFile* preparedFSEQ = nullptr;
+    AudioManager* preparedAudio = nullptr;
+    VideoReader* preparedVideo = nullptr;
+    {
+        std::unique_lock<std::mutex> lock(_prepareLock);
+        std::swap(preparedFSEQ, _preparedFSEQ);
+        std::swap(preparedAudio, _preparedAudio);
+        std::swap(preparedVideo, _preparedVideo);
+    }
+
+    // the step may have been edited since it was prepared
+    if (preparedFSEQ != nullptr && preparedFSEQ->getFilename() != _fseqFileName) {
+        delete preparedFSEQ;
+        preparedFSEQ = nullptr;
+    }
+    if (preparedVideo != nullptr && preparedVideo->GetFilename() != _videoFile) {
+        delete preparedVideo;
+        preparedVideo = nullptr;
+    }
+
+    if (preparedFSEQ != nullptr) {
+        _fseqFile = preparedFSEQ;
+        _msPerFrame = _fseqFile->getStepTime();
+        _durationMS = _fseqFile->getTotalTimeMS();
+    }
+    else if (wxFile::Exists(_fseqFileName)) {
         _fseqFile = FSEQFile::openFSEQFile(_fseqFileName);
         if (_fseqFile != nullptr) {
             _msPerFrame = _fseqFile->getStepTime();
@@ -210,6 +236,10 @@ void PlayListItemFSEQVideo::LoadFiles(bool doCache)
     if (!_useMediaPlayer && _cacheVideo && doCache) {
         _cachedVideoReader = new CachedVideoReader(_videoFile, 0, GetFrameMS(), _size, false);
     }
+    else if (preparedVideo != nullptr && !_useMediaPlayer) {
+        _videoReader = preparedVideo;
+        preparedVideo = nullptr;
+    }
     else {
         _videoReader = new VideoReader(_videoFile, _size.GetWidth(), _size.GetHeight(), false);
         if (_useMediaPlayer) {
@@ -218,8 +248,119 @@ void PlayListItemFSEQVideo::LoadFiles(bool doCache)
             _videoReader = nullptr;
         }
     }
+    if (preparedVideo != nullptr) {
+        delete preparedVideo;
+    }
+
+    if (preparedAudio != nullptr) {
+        // LoadAudio will treat this as already open
+        if (_audioManager == nullptr && preparedAudio->FileName() == GetAudioFilename()) {
+            _audioManager = preparedAudio;
+        }
+        else {
+            delete preparedAudio;
+        }
+    }
 
     LoadAudio();
+
+    return preparedFSEQ != nullptr;
+}
+
+std::function<void()> PlayListItemFSEQVideo::Prepare()
+{
+    // the work runs on the prefetch thread so it gets its own copies of the settings
+    std::string fseqFileName = _fseqFileName;
+    std::string audioFile = _overrideAudio ? _audioFile : "";
+    std::string audioDevice = _audioDevice;
+    std::string videoFile = _videoFile;
+    wxSize size = _size;
+    // fast start audio is already loaded
+    bool prepareAudio = !_fastStartAudio && !(IsInSlaveMode() && IsSuppressAudioOnSlaves());
+    bool overrideAudio = _overrideAudio;
+    // cached video starts its own read ahead thread when the step starts and the media player opens the file itself
+    bool prepareVideo = !_useMediaPlayer && !_cacheVideo;
+
+    return [this, fseqFileName, audioFile, audioDevice, videoFile, size, prepareAudio, overrideAudio, prepareVideo]() {
+        static log4cpp::Category& logger_base = log4cpp::Category::getInstance(std::string("log_base"));
+
+        FSEQFile* fseq = nullptr;
+        if (wxFile::Exists(fseqFileName)) {
+            fseq = FSEQFile::openFSEQFile(fseqFileName);
+            if (fseq != nullptr) {
+                // this reads and decompresses the first block of frames
+                fseq->prepareRead({ { 0, fseq->getMaxChannel() + 1 } });
+            }
+        }
+
+        AudioManager* audio = nullptr;
+        if (prepareAudio) {
+            std::string af = audioFile;
+            if (!overrideAudio && fseq != nullptr) {
+                af = FixFile("", fseq->getMediaFilename());
+            }
+
+            if (af != "" && wxFile::Exists(af)) {
+                audio = new AudioManager(af, -1, audioDevice);
+                if (!audio->IsOk()) {
+                    delete audio;
+                    audio = nullptr;
+                }
+            }
+        }
+
+        VideoReader* video = nullptr;
+        if (prepareVideo && wxFile::Exists(videoFile)) {
+            video = new VideoReader(videoFile, size.GetWidth(), size.GetHeight(), false);
+            if (video->IsValid()) {
+                // decode the first frame so there is something to show straight away
+                video->GetNextFrame(0, fseq != nullptr ? fseq->getStepTime() : 50);
+            }
+        }
+
+        {
+            std::unique_lock<std::mutex> lock(_prepareLock);
+            if (_preparedFSEQ != nullptr) delete _preparedFSEQ;
+            if (_preparedAudio != nullptr) delete _preparedAudio;
+            if (_preparedVideo != nullptr) delete _preparedVideo;
+            _preparedFSEQ = fseq;
+            _preparedAudio = audio;
+            _preparedVideo = video;
+        }
+
+        logger_base.debug("FSEQ Video: Prepared '%s'%s%s.", (const char*)fseqFileName.c_str(), audio != nullptr ? " and its audio" : "", video != nullptr ? " and its video" : "");
+    };
+}
+
+void PlayListItemFSEQVideo::Unprepare()
+{
+    std::unique_lock<std::mutex> lock(_prepareLock);
+    if (_preparedFSEQ != nullptr) {
+        delete _preparedFSEQ;
+        _preparedFSEQ = nullptr;
+    }
+    if (_preparedAudio != nullptr) {
+        delete _preparedAudio;
+        _preparedAudio = nullptr;
+    }
+    if (_preparedVideo != nullptr) {
+        delete _preparedVideo;
+        _preparedVideo = nullptr;
+    }
+}
+
+size_t PlayListItemFSEQVideo::GetPrepareBytes() const
+{
+    size_t bytes = 0;
+    if (!_fastStartAudio) {
+        // until the step has been timed the duration is not known so the estimate comes from the audio file size
+        bytes += EstimatePrepareAudioBytes(_overrideAudio ? _audioFile : _cachedAudioFilename, _controlsTimingCache ? _durationMS : 0);
+    }
+    if (!_useMediaPlayer && !_cacheVideo) {
+        // two decoded frames
+        bytes += (size_t)_size.GetWidth() * _size.GetHeight() * 4 * 2;
+    }
+    return bytes;
 }
 
 PlayListItemFSEQVideo::PlayListItemFSEQVideo(OutputManager* outputManager, ScheduleOptions* options) : PlayListItem()
@@ -679,9 +820,9 @@ void PlayListItemFSEQVideo::Start(long stepLengthMS)
 
     // load the FSEQ
     // load the audio
-    LoadFiles(true);
+    bool prepared = LoadFiles(true);
 
-    if (_fseqFile != nullptr) {
+    if (_fseqFile != nullptr && !prepared) {
         _fseqFile->prepareRead({ { 0, _fseqFile->getMaxChannel() + 1} });
     }
 
@@ -823,6 +964,7 @@ void PlayListItemFSEQVideo::CloseFiles()
 
 PlayListItemFSEQVideo::~PlayListItemFSEQVideo()
 {
+    Unprepare();
     CloseFiles();
 	
     if (_audioManager != nullptr) {
@@ -61,9 +61,12 @@ protected:
 	PlayerWindow* _window = nullptr;
     PlayerFrame* _frame = nullptr;
     std::string _audioDevice = "";
+    FSEQFile* _preparedFSEQ = nullptr;
+    AudioManager* _preparedAudio = nullptr;
+    VideoReader* _preparedVideo = nullptr;
     #pragma endregion
 
-    void LoadFiles(bool doCache);
+    bool LoadFiles(bool doCache);
     void CloseFiles();
     void FastSetDuration();
     void LoadAudio();
@@ -149,6 +152,12 @@ public:
     virtual bool Advance(int seconds) override;
     #pragma endregion Playing
 
+    #pragma region Prefetch
+    virtual std::function<void()> Prepare() override;
+    virtual void Unprepare() override;
+    virtual size_t GetPrepareBytes() const override;
+    #pragma endregion Prefetch
+
 #pragma region UI
     virtual void Configure(wxNotebook* notebook) override;
 #pragma endregion UI
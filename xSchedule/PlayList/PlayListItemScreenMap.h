@@ -34,8 +34,6 @@ protected:
     MatrixMapper* _matrixMapper;
     #pragma endregion Member Variables
 
-    void SetPixel(uint8_t* p, uint8_t r, uint8_t g, uint8_t b, APPLYMETHOD blendMode);
-
 public:
 
     #pragma region Constructors and Destructors
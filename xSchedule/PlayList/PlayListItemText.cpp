@@ -582,34 +582,7 @@ void PlayListItemText::Frame(uint8_t* buffer, size_t size, size_t ms, size_t fra
             // write out the bitmap
             dc.SelectObject(wxNullBitmap);
             wxImage image = bitmap.ConvertToImage();
-            for (int x = 0; x < _matrixMapper->GetWidth(); ++x)
-            {
-                for (int y = 0; y < _matrixMapper->GetHeight(); ++y)
-                {
-                    size_t bl = _matrixMapper->Map(x, _matrixMapper->GetHeight() - y - 1) - 1;
-
-                    if (bl < size)
-                    {
-                        uint8_t* p = buffer + bl;
-
-                        SetPixel(p, image.GetRed(x, y), image.GetGreen(x, y), image.GetBlue(x, y), _blendMode);
-                    }
-                    else
-                    {
-                        wxASSERT(false);
-                    }
-                }
-            }
+            _matrixMapper->BlitImage(image, buffer, size, _blendMode);
         }
     }
 }
-
-void PlayListItemText::SetPixel(uint8_t* p, uint8_t r, uint8_t g, uint8_t b, APPLYMETHOD blendMode)
-{
-    uint8_t rgb[3];
-    rgb[0] = r;
-    rgb[1] = g;
-    rgb[2] = b;
-
-    Blend(p, 3, rgb, 3, blendMode);
-}
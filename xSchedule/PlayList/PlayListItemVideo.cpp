@@ -46,6 +46,7 @@ PlayListItemVideo::PlayListItemVideo(wxXmlNode* node) : PlayListItem(node)
 
 PlayListItemVideo::~PlayListItemVideo()
 {
+    Unprepare();
     CloseFiles();
 
     if (_window != nullptr) {
@@ -220,10 +221,27 @@ void PlayListItemVideo::OpenFiles(bool doCache)
 {
     CloseFiles();
 
+    VideoReader* preparedVideo = nullptr;
+    {
+        std::unique_lock<std::mutex> lock(_prepareLock);
+        std::swap(preparedVideo, _preparedVideo);
+    }
+
+    // the step may have been edited since it was prepared
+    if (preparedVideo != nullptr && preparedVideo->GetFilename() != _videoFile) {
+        delete preparedVideo;
+        preparedVideo = nullptr;
+    }
+
     if (_cacheVideo && doCache && !_useMediaPlayer) {
         _cachedVideoReader = new CachedVideoReader(_videoFile, 0, GetFrameMS(), _size, false);
         _durationMS = _cachedVideoReader->GetLengthMS();
     }
+    else if (preparedVideo != nullptr && !_useMediaPlayer) {
+        _videoReader = preparedVideo;
+        preparedVideo = nullptr;
+        _durationMS = _videoReader->GetLengthMS();
+    }
     else {
         _videoReader = new VideoReader(_videoFile, _size.GetWidth(), _size.GetHeight(), false); // , true);
         _durationMS = _videoReader->GetLengthMS();
@@ -232,6 +250,58 @@ void PlayListItemVideo::OpenFiles(bool doCache)
             _videoReader = nullptr;
         }
     }
+
+    if (preparedVideo != nullptr) {
+        delete preparedVideo;
+    }
+}
+
+std::function<void()> PlayListItemVideo::Prepare()
+{
+    // cached video starts its own read ahead thread when the step starts and the media player opens the file itself
+    if (_useMediaPlayer || _cacheVideo) return nullptr;
+
+    // the work runs on the prefetch thread so it gets its own copies of the settings
+    std::string videoFile = _videoFile;
+    wxSize size = _size;
+    size_t frameMS = GetFrameMS();
+
+    return [this, videoFile, size, frameMS]() {
+        static log4cpp::Category& logger_base = log4cpp::Category::getInstance(std::string("log_base"));
+
+        if (!wxFile::Exists(videoFile)) return;
+
+        VideoReader* video = new VideoReader(videoFile, size.GetWidth(), size.GetHeight(), false);
+        if (video->IsValid()) {
+            // decode the first frame so there is something to show straight away
+            video->GetNextFrame(0, frameMS);
+        }
+
+        {
+            std::unique_lock<std::mutex> lock(_prepareLock);
+            if (_preparedVideo != nullptr) delete _preparedVideo;
+            _preparedVideo = video;
+        }
+
+        logger_base.debug("Video: Prepared '%s'.", (const char*)videoFile.c_str());
+    };
+}
+
+void PlayListItemVideo::Unprepare()
+{
+    std::unique_lock<std::mutex> lock(_prepareLock);
+    if (_preparedVideo != nullptr) {
+        delete _preparedVideo;
+        _preparedVideo = nullptr;
+    }
+}
+
+size_t PlayListItemVideo::GetPrepareBytes() const
+{
+    if (_useMediaPlayer || _cacheVideo) return 0;
+
+    // two decoded frames
+    return (size_t)_size.GetWidth() * _size.GetHeight() * 4 * 2;
 }
 
 // Maximum milliseconds a media player file can be out of sync with the sequence
@@ -42,6 +42,7 @@ protected:
     int _fadeInMS = 0;
     int _fadeOutMS = 0;
     bool _useMediaPlayer = false;
+    VideoReader* _preparedVideo = nullptr;
     #pragma endregion Member Variables
 
     void OpenFiles(bool doCache);
@@ -96,6 +97,12 @@ public:
     virtual void Pause(bool pause) override;
     #pragma endregion Playing
 
+    #pragma region Prefetch
+    virtual std::function<void()> Prepare() override;
+    virtual void Unprepare() override;
+    virtual size_t GetPrepareBytes() const override;
+    #pragma endregion Prefetch
+
 #pragma region UI
     virtual void Configure(wxNotebook* notebook) override;
 #pragma endregion UI
@@ -50,6 +50,8 @@
 #include <wx/filename.h>
 #include <wx/xml/xml.h>
 
+#include <thread>
+
 #include <log4cpp/Category.hh>
 
 int __playliststepid = 0;
@@ -162,6 +164,9 @@ PlayListStep::~PlayListStep()
 {
     static log4cpp::Category &logger_base = log4cpp::Category::getInstance(std::string("log_base"));
 
+    // the items are unprepared as they are deleted
+    WaitForPrefetch(true);
+
     {
         ReentrancyCounter rec(_reentrancyCounter);
 
@@ -380,6 +385,9 @@ void PlayListStep::RemoveItem(PlayListItem* item)
 {
     static log4cpp::Category &logger_base = log4cpp::Category::getInstance(std::string("log_base"));
 
+    // the caller may delete the item so it must not still be being prepared
+    WaitForPrefetch(false);
+
     {
         ReentrancyCounter rec(_reentrancyCounter);
 
@@ -586,6 +594,22 @@ void PlayListStep::Start(int loops)
     static log4cpp::Category &logger_base = log4cpp::Category::getInstance(std::string("log_base"));
     logger_base.info("         ######## Playlist step %s starting.", (const char*)GetNameNoTime().c_str());
 
+    if (_prefetch != nullptr)
+    {
+        // normally long finished but if not this is no slower than loading the files here
+        bool finished = false;
+        {
+            std::unique_lock<std::mutex> lock(_prefetch->lock);
+            finished = _prefetch->finished;
+        }
+        if (!finished)
+        {
+            logger_base.debug("         Waiting for prefetch of step %s to finish.", (const char*)GetNameNoTime().c_str());
+        }
+        WaitForPrefetch(false);
+        _prefetch = nullptr;
+    }
+
     _loops = loops;
     _startTime = wxGetUTCTimeMillis().GetLo();
     {
@@ -597,6 +621,115 @@ void PlayListStep::Start(int loops)
     }
 }
 
+// Prepare the items on a background thread so the step can start without waiting for files to open
+void PlayListStep::Prefetch()
+{
+    static log4cpp::Category &logger_base = log4cpp::Category::getInstance(std::string("log_base"));
+
+    // a cancelled prefetch may still be running ... the new one waits for it so its clean up cannot undo our work
+    std::shared_ptr<PrefetchState> previous;
+    if (_prefetch != nullptr)
+    {
+        std::unique_lock<std::mutex> lock(_prefetch->lock);
+        if (!_prefetch->cancelled) return;
+        if (!_prefetch->finished) previous = _prefetch;
+    }
+
+    // the items take copies of their settings here so the background thread never reads them
+    std::list<PlayListItem*> items;
+    std::list<std::function<void()>> work;
+    {
+        ReentrancyCounter rec(_reentrancyCounter);
+        items = _items;
+        for (auto it : _items)
+        {
+            auto w = it->Prepare();
+            if (w != nullptr) work.push_back(w);
+        }
+    }
+
+    logger_base.debug("         Prefetching playlist step %s.", (const char*)GetNameNoTime().c_str());
+    auto state = std::make_shared<PrefetchState>();
+    _prefetch = state;
+    std::thread([state, previous, items, work]() {
+        if (previous != nullptr)
+        {
+            std::unique_lock<std::mutex> lock(previous->lock);
+            previous->finishedCV.wait(lock, [previous]() { return previous->finished; });
+        }
+
+        for (const auto& it : work)
+        {
+            {
+                std::unique_lock<std::mutex> lock(state->lock);
+                if (state->cancelled) break;
+            }
+            it();
+        }
+
+        std::unique_lock<std::mutex> lock(state->lock);
+        if (state->cancelled)
+        {
+            // nobody wants what was prepared any more
+            for (auto it : items)
+            {
+                it->Unprepare();
+            }
+        }
+        state->finished = true;
+        state->finishedCV.notify_all();
+    }).detach();
+}
+
+// This never waits for the prefetch thread ... if it is still running it throws away what it prepared when it finishes
+void PlayListStep::CancelPrefetch()
+{
+    static log4cpp::Category &logger_base = log4cpp::Category::getInstance(std::string("log_base"));
+
+    if (_prefetch == nullptr) return;
+
+    bool finished = false;
+    {
+        std::unique_lock<std::mutex> lock(_prefetch->lock);
+        if (_prefetch->cancelled) return;
+        _prefetch->cancelled = true;
+        finished = _prefetch->finished;
+    }
+
+    logger_base.debug("         Discarding prefetch of playlist step %s.", (const char*)GetNameNoTime().c_str());
+    if (finished)
+    {
+        ReentrancyCounter rec(_reentrancyCounter);
+        for (auto it : _items)
+        {
+            it->Unprepare();
+        }
+    }
+}
+
+void PlayListStep::WaitForPrefetch(bool cancel)
+{
+    if (_prefetch == nullptr) return;
+
+    auto state = _prefetch;
+    std::unique_lock<std::mutex> lock(state->lock);
+    if (cancel) state->cancelled = true;
+    state->finishedCV.wait(lock, [state]() { return state->finished; });
+}
+
+size_t PlayListStep::GetPrefetchBytes()
+{
+    size_t bytes = 0;
+    {
+        ReentrancyCounter rec(_reentrancyCounter);
+        for (auto it : _items)
+        {
+            bytes += it->GetPrepareBytes();
+        }
+    }
+    return bytes;
+}
+
 void PlayListStep::Pause(bool pause)
 {
     static log4cpp::Category &logger_base = log4cpp::Category::getInstance(std::string("log_base"));
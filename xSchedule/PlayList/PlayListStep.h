@@ -14,6 +14,8 @@
 #include <string>
 #include <wx/wx.h>
 #include <mutex>
+#include <memory>
+#include <condition_variable>
 
 class OutputManager;
 class PlayListItemText;
@@ -45,10 +47,20 @@ protected:
     bool _everyStep = false;
     bool _everyStepExcludeFirst = false;
     bool _everyStepExcludeLast = false;
+    // shared with the prefetch thread so a cancelled prefetch can be left to finish and clean up on its own
+    struct PrefetchState
+    {
+        std::mutex lock;
+        std::condition_variable finishedCV;
+        bool finished = false;
+        bool cancelled = false;
+    };
+    std::shared_ptr<PrefetchState> _prefetch;
 #pragma endregion Member Variables
 
     std::string FormatTime(size_t timems, bool ms = false) const;
     AudioManager* GetAudioManager(PlayListItem* pli) const;
+    void WaitForPrefetch(bool cancel);
 
 public:
 
@@ -82,6 +94,9 @@ public:
     std::string GetRawName() const { return _name; }
     void SetName(const std::string& name) { if (_name != name) { _name = name; ++_changeCount; } }
     void Start(int _loops);
+    void Prefetch();
+    void CancelPrefetch();
+    size_t GetPrefetchBytes();
     bool IsSimple();
     int GetLoopsLeft() const { return _loops; }
     void DoLoop() { --_loops; }
@@ -146,28 +146,45 @@ bool PlayerWindow::PrepareImage()
 
 void PlayerWindow::SetImage(const wxImage& image)
 {
-    static log4cpp::Category& logger_frame = log4cpp::Category::getInstance(std::string("log_frame"));
+    if (!image.IsOk()) return;
 
-    if (image.IsOk()) {
-        int srcWidth = image.GetWidth();
-        int srcHeight = image.GetHeight();
+    if (!image.HasAlpha()) {
+        SetImageData(image.GetData(), image.GetWidth(), image.GetHeight());
+        return;
+    }
 
-        std::unique_lock<std::timed_mutex> lock(_mutex);
+    std::unique_lock<std::timed_mutex> lock(_mutex);
+    int width = image.GetWidth();
+    int height = image.GetHeight();
+    if (width == _inputImage.GetWidth() && height == _inputImage.GetHeight() && _inputImage.HasAlpha() &&
+        memcmp(_inputImage.GetData(), image.GetData(), (size_t)width * height * 3) == 0 &&
+        memcmp(_inputImage.GetAlpha(), image.GetAlpha(), (size_t)width * height) == 0) {
+        return;
+    }
+    _inputImage.Destroy();
+    _inputImage = image.Copy();
+    _imageChanged = true;
+    Refresh(false); // force a paint on the main thread
+}
 
-        int tgtWidth = _inputImage.GetWidth();
-        int tgtHeight = _inputImage.GetHeight();
+void PlayerWindow::SetImageData(const uint8_t* data, int width, int height)
+{
+    if (data == nullptr || width <= 0 || height <= 0) return;
 
-        bool changed = srcWidth != tgtWidth ||
-            srcHeight != tgtHeight ||
-            memcmp(_inputImage.GetData(), image.GetData(), srcWidth * srcHeight * 3) != 0;
+    std::unique_lock<std::timed_mutex> lock(_mutex);
 
-        if (changed) {
-            _inputImage.Destroy();
-            _inputImage = image.Copy();
-            _imageChanged = true;
-            Refresh(false); // force a paint on the main thread
-        }
+    size_t bytes = (size_t)width * height * 3;
+    if (width == _inputImage.GetWidth() && height == _inputImage.GetHeight() && !_inputImage.HasAlpha()) {
+        // same size so the data goes straight into the existing buffer
+        if (memcmp(_inputImage.GetData(), data, bytes) == 0) return;
+    }
+    else {
+        _inputImage.Destroy();
+        _inputImage = wxImage(width, height, false);
     }
+    memcpy(_inputImage.GetData(), data, bytes);
+    _imageChanged = true;
+    Refresh(false); // force a paint on the main thread
 }
 
 void PlayerWindow::Paint(wxPaintEvent& event)
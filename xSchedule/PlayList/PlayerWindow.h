@@ -36,6 +36,10 @@ class PlayerWindow: public wxFrame
 		PlayerWindow(wxWindow* parent, bool topMost, wxImageResizeQuality quality = wxIMAGE_QUALITY_HIGH, int swsQuality = -1, wxWindowID id=wxID_ANY,const wxPoint& pos=wxDefaultPosition,const wxSize& size=wxDefaultSize);
 		virtual ~PlayerWindow();
         void SetImage(const wxImage& image);
+        // width x height packed RGB pixels
+        void SetImageData(const uint8_t* data, int width, int height);
+        // true until the last image set has been painted
+        bool IsImagePending() const { return _imageChanged; }
 
 	private:
 
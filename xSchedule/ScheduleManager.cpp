@@ -783,7 +783,7 @@ void ScheduleManager::AllOff()
         it->Frame(_buffer, _outputManager->GetTotalChannels());
     }
 
-    _outputManager->SetManyChannels(0, _buffer, _outputManager->GetTotalChannels());
+    _outputManager->SetFrame(_buffer, _outputManager->GetTotalChannels());
     _outputManager->EndFrame();
 }
 
@@ -880,7 +880,7 @@ int ScheduleManager::Frame(bool outputframe, xScheduleFrame* frame)
 
         if (outputframe)
         {
-            _outputManager->SetManyChannels(0, _buffer, totalChannels);
+            _outputManager->SetFrame(_buffer, totalChannels);
             _outputManager->EndFrame();
         }
     }
@@ -1023,7 +1023,7 @@ int ScheduleManager::Frame(bool outputframe, xScheduleFrame* frame)
 
                 logger_frame.debug("Frame: Listening done %ldms", sw.Time());
 
-                _outputManager->SetManyChannels(0, _buffer, totalChannels);
+                _outputManager->SetFrame(_buffer, totalChannels);
 
                 logger_frame.debug("Frame: Data set %ldms", sw.Time());
 
@@ -1123,7 +1123,7 @@ int ScheduleManager::Frame(bool outputframe, xScheduleFrame* frame)
 
                 if (outputframe)
                 {
-                    _outputManager->SetManyChannels(0, _buffer, totalChannels);
+                    _outputManager->SetFrame(_buffer, totalChannels);
                     _outputManager->EndFrame();
                 }
             }
@@ -1175,7 +1175,7 @@ int ScheduleManager::Frame(bool outputframe, xScheduleFrame* frame)
 
                     if (outputframe)
                     {
-                        _outputManager->SetManyChannels(0, _buffer, totalChannels);
+                        _outputManager->SetFrame(_buffer, totalChannels);
                         _outputManager->EndFrame();
                     }
 
@@ -66,6 +66,8 @@ ScheduleOptions::ScheduleOptions(OutputManager* outputManager, wxXmlNode* node,
     _disableOutputOnPingFailure = node->GetAttribute("DisableOutputOnPingFailure", "FALSE") == "TRUE";
     _useStepMMSSTimecodeFormat = node->GetAttribute("StepMMSSTimecodeFormat", "FALSE") == "TRUE";
     _remoteTimecodeStepAdvance = node->GetAttribute("RemoteTimecodeStepAdvance", "FALSE") == "TRUE";
+    _prefetchSteps = wxAtoi(node->GetAttribute("PrefetchSteps", "1"));
+    _prefetchMemoryMB = wxAtoi(node->GetAttribute("PrefetchMemoryMB", "512"));
 
 #ifdef __WXMSW__
     _port = wxAtoi(node->GetAttribute("WebServerPort", "80"));
@@ -283,6 +285,8 @@ ScheduleOptions::ScheduleOptions()
     _retryOutputOpen = false;
     _useStepMMSSTimecodeFormat = false;
     _remoteTimecodeStepAdvance = false;
+    _prefetchSteps = 1;
+    _prefetchMemoryMB = 512;
     _suppressAudioOnRemotes = true;
     _sendBackgroundWhenNotRunning = false;
     _advancedMode = false;
@@ -409,6 +413,8 @@ wxXmlNode* ScheduleOptions::Save()
 
     res->AddAttribute("WebServerPort", wxString::Format(wxT("%i"), _port));
     res->AddAttribute("PasswordTimeout", wxString::Format(wxT("%i"), _passwordTimeout));
+    res->AddAttribute("PrefetchSteps", wxString::Format(wxT("%i"), _prefetchSteps));
+    res->AddAttribute("PrefetchMemoryMB", wxString::Format(wxT("%i"), _prefetchMemoryMB));
     res->AddAttribute("ARTNetTimeCodeFormat", wxString::Format("%d", _artNetTimeCodeFormat));
 
     for (auto it : _buttons) {
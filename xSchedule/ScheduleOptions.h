@@ -211,6 +211,8 @@ class ScheduleOptions
     bool _minimiseUIUpdates = false;
     bool _useStepMMSSTimecodeFormat = false;
     bool _remoteTimecodeStepAdvance = false;
+    int _prefetchSteps = 1;
+    int _prefetchMemoryMB = 512;
 
     std::pair<int, int> ParsePair(const std::string& value, const std::pair<int, int>& def);
     std::string SerialisePair(int a, int b);
@@ -280,6 +282,10 @@ public:
     bool IsRetryOpen() const { return _retryOutputOpen; }
     bool IsUseStepMMSSTimecodeFormat() const { return _useStepMMSSTimecodeFormat; }
     bool IsRemoteTimecodeStepAdvance() const { return _remoteTimecodeStepAdvance; }
+    int GetPrefetchSteps() const { return _prefetchSteps; }
+    void SetPrefetchSteps(int prefetchSteps) { if (_prefetchSteps != prefetchSteps) { _prefetchSteps = prefetchSteps; _changeCount++; } }
+    int GetPrefetchMemoryMB() const { return _prefetchMemoryMB; }
+    void SetPrefetchMemoryMB(int prefetchMemoryMB) { if (_prefetchMemoryMB != prefetchMemoryMB) { _prefetchMemoryMB = prefetchMemoryMB; _changeCount++; } }
     int GetSMPTEMode() const
     {
         return _SMPTEMode;
@@ -9,6 +9,9 @@
  **************************************************************/
 
 #include "VirtualMatrix.h"
+
+#include <algorithm>
+
 #include <wx/string.h>
 #include <wx/xml/xml.h>
 #include <wx/wx.h>
@@ -311,88 +314,102 @@ std::string VirtualMatrix::DecodeScalingQuality(wxImageResizeQuality quality, in
     return "Normal";
 }
 
+// Works out where each matrix pixel lands in the displayed image so rotation and flipping cost nothing per frame
+void VirtualMatrix::PrepareFrame()
+{
+    if (_frameChangeCount == _changeCount && !_frame.empty()) return;
+
+    _frameChangeCount = _changeCount;
+    _frameStartChannel = _outputManager->DecodeStartChannel(_startChannel);
+
+    bool rotated = _rotation == VMROTATION::VM_90 || _rotation == VMROTATION::VM_270;
+    _frameWidth = rotated ? _height : _width;
+    _frameHeight = rotated ? _width : _height;
+    _frame.assign(_width * _height * 3, 0);
+    _pixelMap.clear();
+
+    if (_rotation == VMROTATION::VM_NORMAL) return;
+
+    _pixelMap.resize(_width * _height);
+    for (size_t y = 0; y < _height; y++) {
+        for (size_t x = 0; x < _width; x++) {
+            size_t tx = x;
+            size_t ty = y;
+            switch (_rotation) {
+            case VMROTATION::VM_FLIP_HORIZONTAL:
+                tx = _width - 1 - x;
+                break;
+            case VMROTATION::VM_FLIP_VERTICAL:
+                ty = _height - 1 - y;
+                break;
+            case VMROTATION::VM_90:
+                tx = _height - 1 - y;
+                ty = x;
+                break;
+            default:
+                tx = y;
+                ty = _width - 1 - x;
+                break;
+            }
+            _pixelMap[y * _width + x] = (ty * _frameWidth + tx) * 3;
+        }
+    }
+}
+
 void VirtualMatrix::AllOff()
 {
-    if (!_image.IsOk()) return;
     if (_window == nullptr) return;
+    if (_width == 0 || _height == 0) return;
 
-    _image.Clear();
-
-    if (_rotation == VMROTATION::VM_NORMAL)
-    {
-        _window->SetImage(_image);
-    }
-    else if (_rotation == VMROTATION::VM_FLIP_HORIZONTAL) {
-        wxImage rot = _image.Mirror(true);
-        _window->SetImage(rot);
-    }
-    else if (_rotation == VMROTATION::VM_FLIP_VERTICAL) {
-        wxImage rot = _image.Mirror(false);
-        _window->SetImage(rot);
-    }
-    else if (_rotation == VMROTATION::VM_90)
-    {
-        wxImage rot = _image.Rotate90();
-        _window->SetImage(rot);
-    }
-    else
-    {
-        wxImage rot = _image.Rotate90(false);
-        _window->SetImage(rot);
-    }
+    PrepareFrame();
+    std::fill(_frame.begin(), _frame.end(), 0);
+    _window->SetImageData(_frame.data(), _frameWidth, _frameHeight);
 }
 
 void VirtualMatrix::Frame(uint8_t*buffer, size_t size)
 {
-    if (!_image.IsOk()) return;
     if (_window == nullptr) return;
 
     // If there is no width or height there is nothing to draw
     if (_width == 0 || _height == 0) return;
 
-    long sc = _outputManager->DecodeStartChannel(_startChannel);
+    // the window has not painted the last frame yet so there is no point giving it another
+    if (_window->IsImagePending()) {
+        _skippedFrames++;
+        return;
+    }
 
-    size_t end = _width * _height * 3 < size - (sc - 1) ? _width * _height * 3 : size - (sc - 1);
+    PrepareFrame();
 
-    for (size_t i = 0; i < end; i += 3)
-    {
-        uint8_t* pb = buffer + (sc - 1) + i;
-        uint8_t r = *pb;
-        uint8_t g = 0;
-        if (i + 1 < end)
-        {
-            g = *(pb + 1);
+    long sc = _frameStartChannel;
+    if (sc < 1 || (size_t)(sc - 1) >= size) return;
+
+    const uint8_t* src = buffer + (sc - 1);
+    size_t end = std::min(_frame.size(), size - (sc - 1));
+
+    if (_pixelMap.empty()) {
+        memcpy(_frame.data(), src, end);
+    }
+    else {
+        size_t pixels = end / 3;
+        uint8_t* dst = _frame.data();
+        for (size_t i = 0; i < pixels; i++) {
+            uint8_t* pd = dst + _pixelMap[i];
+            *pd = *src;
+            *(pd + 1) = *(src + 1);
+            *(pd + 2) = *(src + 2);
+            src += 3;
         }
-        uint8_t b = 0;
-        if (i + 2 < end)
-        {
-            b = *(pb + 2);
+        // a final pixel only partly inside the buffer
+        if (end % 3 != 0) {
+            uint8_t* pd = dst + _pixelMap[pixels];
+            *pd = *src;
+            *(pd + 1) = end % 3 > 1 ? *(src + 1) : 0;
+            *(pd + 2) = 0;
         }
-        _image.SetRGB((i / 3) % _width, i / 3 / _width, r, g, b);
     }
 
-    if (_rotation == VMROTATION::VM_NORMAL)
-    {
-        _window->SetImage(_image);
-    }
-    else if (_rotation == VMROTATION::VM_FLIP_HORIZONTAL) {
-        wxImage rot = _image.Mirror(true);
-        _window->SetImage(rot);
-    }
-    else if (_rotation == VMROTATION::VM_FLIP_VERTICAL) {
-        wxImage rot = _image.Mirror(false);
-        _window->SetImage(rot);
-    }
-    else if (_rotation == VMROTATION::VM_90)
-    {
-        wxImage rot = _image.Rotate90();
-        _window->SetImage(rot);
-    }
-    else
-    {
-        wxImage rot = _image.Rotate90(false);
-        _window->SetImage(rot);
-    }
+    _window->SetImageData(_frame.data(), _frameWidth, _frameHeight);
 }
 
 void VirtualMatrix::Start()
@@ -416,13 +433,14 @@ void VirtualMatrix::Start()
         _window->Hide();
     }
 
-    _image = wxImage(_width, _height);
+    _frameChangeCount = -1;
+    _skippedFrames = 0;
 }
 
 void VirtualMatrix::Stop()
 {
     static log4cpp::Category &logger_base = log4cpp::Category::getInstance(std::string("log_base"));
-    logger_base.debug("Virtual matrix stopped %s.", (const char *)_name.c_str());
+    logger_base.debug("Virtual matrix stopped %s. %ld frames skipped as the window was busy.", (const char *)_name.c_str(), _skippedFrames);
 
     // destroy the window
     if (_window != nullptr)
@@ -11,6 +11,7 @@
  **************************************************************/
 
 #include <string>
+#include <vector>
 #include <wx/wx.h>
 #include "PlayList/PlayerWindow.h"
 
@@ -35,12 +36,20 @@ class VirtualMatrix
     wxPoint _location;
     VMROTATION _rotation;
     std::string _startChannel;
-    wxImage _image;
+    std::vector<uint8_t> _frame;
+    std::vector<size_t> _pixelMap;
+    int _frameWidth = 0;
+    int _frameHeight = 0;
+    int _frameChangeCount = -1;
+    long _frameStartChannel = -1;
+    long _skippedFrames = 0;
     wxImageResizeQuality _quality;
     int _swsQuality;
     PlayerWindow* _window;
     bool _suppress;
 
+    void PrepareFrame();
+
 public:
 
 		static VMROTATION EncodeRotation(const std::string rotation);
@@ -24,17 +24,35 @@
 
 #include <log4cpp/Category.hh>
 
+#include <set>
+
 #undef WXUSINGDLL
 #include "wxJSON/jsonreader.h"
+#include "wxJSON/jsonwriter.h"
 
 //#define DETAILED_LOGGING
 
+// how often subscriptions are checked for anything due to be pushed
+#define SUBSCRIPTION_TICK_MS 100
+#define SUBSCRIPTION_MIN_INTERVAL_MS 100
+#define SUBSCRIPTION_DEFAULT_INTERVAL_MS 1000
+
+struct WebSubscription
+{
+    std::set<std::string> _topics;
+    int _intervalMS = SUBSCRIPTION_DEFAULT_INTERVAL_MS;
+    long long _lastPushMS = 0;
+    // the values each topic key had when last sent to this client
+    std::map<std::string, std::map<std::string, std::string>> _sent;
+};
+
 bool __apiOnly = false;
 std::string __password = "";
 std::list<std::string> __Loggedin;
 int __loginTimeout = 30;
 std::string __validPass = "";
 std::string __defaultPage = "index.html";
+std::map<HttpConnection*, WebSubscription> __subscriptions;
 
 void WebServer::GeneratePass()
 {
@@ -297,6 +315,69 @@ wxString ProcessXyzzy(HttpConnection& connection, const wxString& command, const
     return result;
 }
 
+wxString ProcessSubscribe(HttpConnection& connection, bool subscribe, const wxString& topics, int intervalMS, const wxString& reference, const std::string& pass)
+{
+    static log4cpp::Category& logger_base = log4cpp::Category::getInstance(std::string("log_base"));
+
+    wxString type = subscribe ? "subscribe" : "unsubscribe";
+
+    if (!CheckLoggedIn(connection, pass)) {
+        return "{\"result\":\"not logged in\",\"" + type + "\":\"" +
+            topics + "\",\"reference\":\"" +
+            reference + "\",\"ip\":\"" +
+            connection.Address().IPAddress() + "\"}";
+    }
+
+    static const std::set<std::string> validTopics = { "status", "step", "outputs", "frametiming" };
+
+    wxArrayString tl = wxSplit(topics.Lower(), ',');
+    for (const auto& it : tl) {
+        if (validTopics.find(it.Trim().Trim(false).ToStdString()) == validTopics.end()) {
+            return "{\"result\":\"failed\",\"" + type + "\":\"" +
+                topics + "\",\"reference\":\"" +
+                reference + "\",\"message\":\"Unknown topic " + it + ".\"}";
+        }
+    }
+
+    if (subscribe) {
+        auto& sub = __subscriptions[&connection];
+        for (const auto& it : tl) {
+            std::string topic = wxString(it).Trim().Trim(false).ToStdString();
+            sub._topics.insert(topic);
+            // send everything on the next push
+            sub._sent.erase(topic);
+        }
+        if (intervalMS > 0) {
+            sub._intervalMS = std::max(intervalMS, SUBSCRIPTION_MIN_INTERVAL_MS);
+        }
+        sub._lastPushMS = 0;
+    }
+    else {
+        auto sub = __subscriptions.find(&connection);
+        if (sub != __subscriptions.end()) {
+            if (tl.size() == 0) {
+                __subscriptions.erase(sub);
+            }
+            else {
+                for (const auto& it : tl) {
+                    std::string topic = wxString(it).Trim().Trim(false).ToStdString();
+                    sub->second._topics.erase(topic);
+                    sub->second._sent.erase(topic);
+                }
+                if (sub->second._topics.empty()) {
+                    __subscriptions.erase(sub);
+                }
+            }
+        }
+    }
+
+    logger_base.info("Web socket %s %s topics '%s'.", (const char*)connection.Address().IPAddress().c_str(), (const char*)type.c_str(), (const char*)topics.c_str());
+
+    return "{\"result\":\"ok\",\"" + type + "\":\"" +
+        topics + "\",\"reference\":\"" +
+        reference + "\"}";
+}
+
 wxString ProcessLogin(HttpConnection& connection, const wxString& credential, const wxString& reference)
 {
     wxStopWatch sw;
@@ -716,6 +797,13 @@ void MyMessageHandler(HttpConnection& connection, WebSocketMessage& message)
                 wxString r = root.Get("r", defaultValue).AsString();
                 result = ProcessXyzzy(connection, c, p, r, "");
             }
+            else if (type == "subscribe" || type == "unsubscribe") {
+                wxString t = root.Get("Topics", defaultValue).AsString();
+                int interval = wxAtoi(root.Get("Interval", defaultValue).AsString());
+                wxString r = root.Get("Reference", defaultValue).AsString();
+                wxString pass = root.Get("Pass", defaultValue).AsString();
+                result = ProcessSubscribe(connection, type == "subscribe", t, interval, r, pass);
+            }
             else if (type == "login") {
                 wxString c = root.Get("Credential", defaultValue).AsString();
                 wxString r = root.Get("Reference", defaultValue).AsString();
@@ -764,7 +852,7 @@ void MyMessageHandler(HttpConnection& connection, WebSocketMessage& message)
     }
 }
 
-void WebServer::SendMessageToAllWebSockets(const wxString& message)
+void WebServer::SendMessageToAllWebSockets(const wxString& message, const std::string& exceptTopic)
 {
     static bool reentry = false;
     if (reentry) {
@@ -774,6 +862,12 @@ void WebServer::SendMessageToAllWebSockets(const wxString& message)
 
     for (const auto& it : _connections) {
         if (it.second->IsWebSocket()) {
+            if (exceptTopic != "") {
+                auto sub = __subscriptions.find(it.second);
+                if (sub != __subscriptions.end() && sub->second._topics.find(exceptTopic) != sub->second._topics.end()) {
+                    continue;
+                }
+            }
             WebSocketMessage wsm(message);
             if (it.second->SendMessage(wsm)) {
                 UpdateValid(*it.second);
@@ -797,6 +891,116 @@ bool WebServer::IsSomeoneListening() const
     return false;
 }
 
+void WebServer::SetTopicValue(const std::string& topic, const std::string& key, const std::string& value)
+{
+    std::unique_lock<std::mutex> lock(_snapshotLock);
+    _snapshot[topic][key] = value;
+}
+
+void WebServer::SetTopicValues(const std::string& topic, const wxString& json)
+{
+    wxJSONValue root;
+    wxJSONReader reader;
+    if (reader.Parse(json, &root) > 0 || !root.IsObject()) return;
+
+    // serialise outside the lock, clients are only sent the members which changed
+    std::map<std::string, std::string> values;
+    wxJSONWriter writer(wxJSONWRITER_NONE);
+    wxArrayString members = root.GetMemberNames();
+    for (const auto& it : members) {
+        wxString value;
+        writer.Write(root[it], value);
+        values[it.ToStdString()] = value.ToStdString();
+    }
+
+    std::unique_lock<std::mutex> lock(_snapshotLock);
+    auto& t = _snapshot[topic];
+    for (auto& it : t) {
+        // members that are no longer reported, eg the step once playing stops, are sent as null
+        if (values.find(it.first) == values.end()) {
+            it.second = "null";
+        }
+    }
+    for (auto& it : values) {
+        t[it.first] = std::move(it.second);
+    }
+}
+
+bool WebServer::HasSubscribers(const std::string& topic) const
+{
+    for (const auto& it : __subscriptions) {
+        if (it.second._topics.find(topic) != it.second._topics.end()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void WebServer::OnPushTimer(wxTimerEvent& event)
+{
+    if (__subscriptions.empty()) return;
+
+    // forget clients that have gone away
+    for (auto it = __subscriptions.begin(); it != __subscriptions.end();) {
+        bool found = false;
+        for (const auto& c : _connections) {
+            if (c.second == it->first && c.second->IsWebSocket()) {
+                found = true;
+                break;
+            }
+        }
+        if (found) {
+            ++it;
+        }
+        else {
+            it = __subscriptions.erase(it);
+        }
+    }
+
+    long long now = wxGetUTCTimeMillis().GetValue();
+    std::map<std::string, std::map<std::string, std::string>> snapshot;
+    bool copied = false;
+
+    for (auto& it : __subscriptions) {
+        auto& sub = it.second;
+        if (now - sub._lastPushMS < sub._intervalMS) continue;
+        sub._lastPushMS = now;
+
+        // all clients due on this tick share one copy of the values
+        if (!copied) {
+            std::unique_lock<std::mutex> lock(_snapshotLock);
+            snapshot = _snapshot;
+            copied = true;
+        }
+
+        for (const auto& topic : sub._topics) {
+            auto values = snapshot.find(topic);
+            if (values == snapshot.end()) continue;
+
+            auto& sent = sub._sent[topic];
+            std::string data;
+            for (const auto& kv : values->second) {
+                auto last = sent.find(kv.first);
+                if (last == sent.end() || last->second != kv.second) {
+                    if (data != "") data += ",";
+                    data += "\"" + kv.first + "\":" + kv.second;
+                    sent[kv.first] = kv.second;
+                }
+            }
+
+            if (data != "") {
+                WebSocketMessage wsm("{\"type\":\"update\",\"topic\":\"" + topic + "\",\"data\":{" + data + "}}");
+                if (it.first->SendMessage(wsm)) {
+                    UpdateValid(*it.first);
+                }
+                else {
+                    RemoveFromValid(*it.first);
+                }
+            }
+        }
+    }
+}
+
 void WebServer::SetAllowUnauthenticatedPagesToBypassLogin(bool allowUnauthPages)
 {
     if (!allowUnauthPages) {
@@ -827,11 +1031,18 @@ WebServer::WebServer(int port, bool apionly, const wxString& password, int mins,
         logger_base.error("Error starting web server.");
         wxMessageBox("Error starting web server. You may already have a program listening on port " + wxString::Format(wxT("%i"), port));
     }
+    else {
+        _pushTimer.SetOwner(this);
+        Bind(wxEVT_TIMER, &WebServer::OnPushTimer, this, _pushTimer.GetId());
+        _pushTimer.Start(SUBSCRIPTION_TICK_MS);
+    }
 }
 
 WebServer::~WebServer()
 {
     wxLogNull logNo; //kludge: avoid "error 0" message from wxWidgets after new file is written
+    _pushTimer.Stop();
+    __subscriptions.clear();
     Stop();
 }
 
@@ -12,8 +12,22 @@
 
 #include "wxHTTPServer/wxhttpserver.h"
 
+#include <wx/timer.h>
+
+#include <map>
+#include <mutex>
+#include <string>
+
+// Web socket clients can subscribe to topics (status, step, outputs and frametiming) instead of polling.
+// Publishers set the latest value of each key of a topic and a timer pushes only the keys that have
+// changed since each client was last sent them, at the rate the client asked for.
 class WebServer : HttpServer
 {
+    wxTimer _pushTimer;
+    std::mutex _snapshotLock;
+    std::map<std::string, std::map<std::string, std::string>> _snapshot;
+
+    void OnPushTimer(wxTimerEvent& event);
 
 public:
 
@@ -23,8 +37,15 @@ public:
         void SetPasswordTimeout(int mins);
         void SetPassword(const wxString& password);
         void GeneratePass();
-        void SendMessageToAllWebSockets(const wxString& message);
+        // web sockets subscribed to exceptTopic are skipped as they get the same values through the subscription
+        void SendMessageToAllWebSockets(const wxString& message, const std::string& exceptTopic = "");
         bool IsSomeoneListening() const;
         void SetAllowUnauthenticatedPagesToBypassLogin(bool allowUnauthPages);
         void SetDefaultPage(const std::string& defaultPage);
+
+        // value must already be JSON ... can be called from any thread
+        void SetTopicValue(const std::string& topic, const std::string& key, const std::string& value);
+        // sets a value for each member of a JSON object
+        void SetTopicValues(const std::string& topic, const wxString& json);
+        bool HasSubscribers(const std::string& topic) const;
 };
@@ -1540,6 +1540,16 @@ void xScheduleFrame::On_timerTrigger(wxTimerEvent& event)
 
     int rate = __schedule->Frame(_timerOutputFrame, this);
 
+    if (_webServer != nullptr && _webServer->HasSubscribers("step"))
+    {
+        PlayList* pl = __schedule->GetRunningPlayList();
+        PlayListStep* step = pl == nullptr ? nullptr : pl->GetRunningStep();
+        _webServer->SetTopicValue("step", "playlist", "\"" + JSONSafe(pl == nullptr ? "" : pl->GetNameNoTime()) + "\"");
+        _webServer->SetTopicValue("step", "step", "\"" + JSONSafe(step == nullptr ? "" : step->GetNameNoTime()) + "\"");
+        _webServer->SetTopicValue("step", "position", wxString::Format("%d", step == nullptr ? 0 : (int)step->GetPosition()).ToStdString());
+        _webServer->SetTopicValue("step", "length", wxString::Format("%d", step == nullptr ? 0 : (int)step->GetLengthMS()).ToStdString());
+    }
+
 #ifndef WEBOVERLOAD
     if (last != wxDateTime::Now().GetSecond() && _timerOutputFrame)
 #endif
@@ -1547,6 +1557,15 @@ void xScheduleFrame::On_timerTrigger(wxTimerEvent& event)
         // This log message must be commented out before release!!!
         //logger_frame.debug("    Check schedule");
 
+        if (_webServer != nullptr && _webServer->HasSubscribers("outputs"))
+        {
+            OutputManager* om = __schedule->GetOutputManager();
+            _webServer->SetTopicValue("outputs", "outputting", om->IsOutputting() ? "true" : "false");
+            _webServer->SetTopicValue("outputs", "packetspersecond", wxString::Format("%d", om->GetPacketsPerSecond()).ToStdString());
+            _webServer->SetTopicValue("outputs", "channels", wxString::Format("%d", (int)om->GetTotalChannels()).ToStdString());
+            _webServer->SetTopicValue("outputs", "controllers", wxString::Format("%d", om->GetControllerCount()).ToStdString());
+        }
+
         // update the UI every second
         last = wxDateTime::Now().GetSecond();
         wxCommandEvent event2(EVT_SCHEDULECHANGED);
@@ -1573,6 +1592,15 @@ void xScheduleFrame::On_timerTrigger(wxTimerEvent& event)
         _timerOutputFrame = !_timerOutputFrame;
     }
 
+    if (_webServer != nullptr && _webServer->HasSubscribers("frametiming"))
+    {
+        _webServer->SetTopicValue("frametiming", "interval", wxString::Format("%lld", elapsed).ToStdString());
+        _webServer->SetTopicValue("frametiming", "frametime", wxString::Format("%ld", ms).ToStdString());
+        _webServer->SetTopicValue("frametiming", "rate", wxString::Format("%d", _timer.GetInterval()).ToStdString());
+        _webServer->SetTopicValue("frametiming", "longframes", wxString::Format("%u", longFrames).ToStdString());
+        _webServer->SetTopicValue("frametiming", "skippedevents", wxString::Format("%u", shortFramesSkipped).ToStdString());
+    }
+
     logger_frame.info("Timer: End Frame: Time %ld", ms);
 }
 
@@ -3565,14 +3593,23 @@ void xScheduleFrame::SendStatus()
 
         if (_webServer != nullptr)
         {
+            if (_webServer->HasSubscribers("status"))
+            {
+                _webServer->SetTopicValues("status", result);
+            }
+
             if (_webServer->IsSomeoneListening())
             {
                 if (__schedule->IsXyzzy())
                 {
                     __schedule->DoXyzzy("q", "", result, "");
+                    _webServer->SendMessageToAllWebSockets(result);
+                }
+                else
+                {
+                    // status subscribers already get this through their subscription
+                    _webServer->SendMessageToAllWebSockets(result, "status");
                 }
-
-                _webServer->SendMessageToAllWebSockets(result);
             }
         }
 